@@ -0,0 +1,322 @@
+/*
+ * Host benchmark for the master's CAN transmit path (demomaster/canopennode/CO_driver.c).
+ *
+ * On the master two tasks send: the SDO queue task puts SDO client requests into their TX
+ * buffers with CO_CANsend(), and the CANopen task sends heartbeats and drains the frames the
+ * bulk limiter held back from CO_CANmodule_process(). Both change the buffers' bufferFull,
+ * CANtxCount and the token bucket under CO_LOCK_CAN_SEND(). This runs the two as threads
+ * against a simulated TWAI queue and bus, with the limiter holding most SDO frames, then
+ * checks that every frame went out exactly once and that CANtxCount matches the buffers.
+ * -U turns the lock into a no-op: a client whose segment went out while CO_CANtxPending() was
+ * still inside twai_transmit() has its next segment dropped and stalls, which shows up as lost.
+ *
+ * Build on Linux; host/ stands in for the ESP-IDF headers:
+ *   cc -O2 -pthread -Ihost -I../demomaster/canopennode -o can_tx_bench can_tx_bench.c \
+ *      ../demomaster/canopennode/CO_driver.c
+ *
+ * Examples:
+ *   ./can_tx_bench
+ *   ./can_tx_bench -l 20 -c 4 -t 5
+ *   ./can_tx_bench -U
+ */
+
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "301/CO_driver.h"
+#include "driver/twai.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+
+#define BENCH_BITRATE_KBPS  500U
+#define BENCH_TWAI_QUEUE    5U    /* default tx_queue_len of the TWAI driver */
+#define BENCH_MAX_CLIENTS   8U
+#define BENCH_SDO_CLI_ID    0x600U
+#define BENCH_HB_ID         0x764U
+#define BENCH_HB_PERIOD_US  10000
+#define BENCH_DRAIN_US      2000000
+
+/* ESP-IDF stand-ins ***********************************************************/
+static int64_t s_epochUs;
+static bool s_lockEnabled = true;
+
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 - s_epochUs;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer) {
+    pthread_mutex_init(&buffer->mutex, NULL);
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    (void)ticks;
+    if (s_lockEnabled) {
+        pthread_mutex_lock(&sem->mutex);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (s_lockEnabled) {
+        pthread_mutex_unlock(&sem->mutex);
+    }
+    return pdTRUE;
+}
+
+/* The controller's TX queue, emptied by bench_bus() at the bit rate. */
+static pthread_mutex_t s_twaiLock = PTHREAD_MUTEX_INITIALIZER;
+static twai_message_t s_twaiQueue[BENCH_TWAI_QUEUE];
+static uint32_t s_twaiHead;
+static uint32_t s_twaiCount;
+
+esp_err_t twai_driver_install(const twai_general_config_t* g, const twai_timing_config_t* t,
+                              const twai_filter_config_t* f) {
+    (void)g;
+    (void)t;
+    (void)f;
+    return ESP_OK;
+}
+
+esp_err_t twai_start(void) { return ESP_OK; }
+
+esp_err_t twai_transmit(const twai_message_t* message, TickType_t ticks_to_wait) {
+    (void)ticks_to_wait;
+    esp_err_t ret = ESP_FAIL;
+    pthread_mutex_lock(&s_twaiLock);
+    if (s_twaiCount < BENCH_TWAI_QUEUE) {
+        s_twaiQueue[(s_twaiHead + s_twaiCount) % BENCH_TWAI_QUEUE] = *message;
+        s_twaiCount++;
+        ret = ESP_OK;
+    }
+    pthread_mutex_unlock(&s_twaiLock);
+    /* The driver's xQueueSend() may switch tasks; let the other sender run here as it could. */
+    sched_yield();
+    return ret;
+}
+
+esp_err_t twai_receive(twai_message_t* message, TickType_t ticks_to_wait) {
+    (void)message;
+    (void)ticks_to_wait;
+    return ESP_ERR_TIMEOUT;
+}
+
+/* Bench ************************************************************************/
+typedef struct {
+    CO_CANmodule_t can;
+    CO_CANrx_t rx[1];
+    CO_CANtx_t tx[BENCH_MAX_CLIENTS + 1U];
+    CO_CANtx_t* sdo[BENCH_MAX_CLIENTS];
+    CO_CANtx_t* hb;
+    uint32_t clients;
+    uint32_t periodUs;
+    volatile bool stop;
+    volatile bool busStop;
+    uint32_t submitted; /* SDO frames handed to CO_CANsend(), numbered 0.. */
+    volatile uint8_t* seen; /* how often each of them reached the bus */
+    uint32_t seenSize;
+    uint32_t sdoOnBus;
+    uint32_t hbSent;
+    uint32_t hbOnBus;
+    uint64_t sdoBits;
+} bench_t;
+
+static void bench_usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [-l load percent] [-c SDO clients] [-p tick us] [-t seconds] [-U]\n", argv0);
+}
+
+static void bench_sleep_us(int64_t us) {
+    struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000L};
+    nanosleep(&ts, NULL);
+}
+
+/* Takes one frame off the TWAI queue per frame time, as the controller puts it on the wire. */
+static void* bench_bus(void* arg) {
+    bench_t* b = arg;
+    int64_t next = esp_timer_get_time();
+    while (!b->busStop) {
+        twai_message_t msg;
+        bool have = false;
+        pthread_mutex_lock(&s_twaiLock);
+        if (s_twaiCount > 0U) {
+            msg = s_twaiQueue[s_twaiHead];
+            s_twaiHead = (s_twaiHead + 1U) % BENCH_TWAI_QUEUE;
+            s_twaiCount--;
+            have = true;
+        }
+        pthread_mutex_unlock(&s_twaiLock);
+        if (!have) {
+            bench_sleep_us(50);
+            next = esp_timer_get_time();
+            continue;
+        }
+        uint32_t bits = CO_CAN_FRAME_BITS(msg.data_length_code);
+        if (msg.identifier == BENCH_HB_ID) {
+            b->hbOnBus++;
+        } else {
+            uint32_t seq;
+            memcpy(&seq, msg.data, sizeof(seq));
+            if (seq < b->seenSize && b->seen[seq] < 255U) {
+                b->seen[seq]++;
+            }
+            b->sdoOnBus++;
+            b->sdoBits += bits;
+        }
+        next += (int64_t)bits * 1000 / BENCH_BITRATE_KBPS;
+        int64_t wait = next - esp_timer_get_time();
+        if (wait > 0) {
+            bench_sleep_us(wait);
+        }
+    }
+    return NULL;
+}
+
+/* SDO queue task: like an SDO client, each client sends its next segment as soon as the previous
+ * one was on the bus (the server answered), whether or not CO_CANtxPending() has let go of the buffer. */
+static void* bench_sdo_task(void* arg) {
+    bench_t* b = arg;
+    uint32_t last[BENCH_MAX_CLIENTS];
+    bool started[BENCH_MAX_CLIENTS] = {false};
+    while (!b->stop && b->submitted < b->seenSize) {
+        for (uint32_t i = 0; i < b->clients && b->submitted < b->seenSize; i++) {
+            if (started[i] && b->seen[last[i]] == 0U) {
+                continue;
+            }
+            uint32_t seq = b->submitted++;
+            memcpy(b->sdo[i]->data, &seq, sizeof(seq));
+            (void)CO_CANsend(&b->can, b->sdo[i]);
+            last[i] = seq;
+            started[i] = true;
+        }
+        sched_yield();
+    }
+    return NULL;
+}
+
+/* CANopen task: -p (1 ms) tick with CO_CANmodule_process() and a heartbeat every 10 ms. */
+static void* bench_process_task(void* arg) {
+    bench_t* b = arg;
+    int64_t nextHb = esp_timer_get_time();
+    while (!b->stop) {
+        CO_CANmodule_process(&b->can);
+        if (esp_timer_get_time() >= nextHb) {
+            nextHb += BENCH_HB_PERIOD_US;
+            b->hb->data[0] = 5U;
+            (void)CO_CANsend(&b->can, b->hb);
+            b->hbSent++;
+        }
+        if (b->periodUs != 0U) {
+            bench_sleep_us(b->periodUs);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    uint32_t loadPercent = 30U;
+    uint32_t clients = 2U;
+    uint32_t seconds = 3U;
+    uint32_t periodUs = 1000U;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:c:p:t:Uh")) != -1) {
+        switch (opt) {
+        case 'l':
+            loadPercent = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            clients = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            periodUs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            seconds = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'U':
+            s_lockEnabled = false;
+            break;
+        default:
+            bench_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (loadPercent == 0U || loadPercent > 100U || clients == 0U || clients > BENCH_MAX_CLIENTS || seconds == 0U) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+    s_epochUs = esp_timer_get_time();
+
+    static bench_t b;
+    b.clients = clients;
+    b.periodUs = periodUs;
+    b.seenSize = seconds * BENCH_BITRATE_KBPS * 1000U / CO_CAN_FRAME_BITS(8U) + 1U;
+    b.seen = calloc(b.seenSize, 1);
+    if (b.seen == NULL) {
+        return 1;
+    }
+    if (CO_CANmodule_init(&b.can, NULL, b.rx, 1U, b.tx, (uint16_t)(clients + 1U), (uint16_t)BENCH_BITRATE_KBPS)
+        != CO_ERROR_NO) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < clients; i++) {
+        b.sdo[i] = CO_CANtxBufferInit(&b.can, (uint16_t)i, (uint16_t)(BENCH_SDO_CLI_ID + 1U + i), false, 8U, false);
+    }
+    b.hb = CO_CANtxBufferInit(&b.can, (uint16_t)clients, (uint16_t)BENCH_HB_ID, false, 1U, false);
+    CO_CANsetBulkLimit(&b.can, BENCH_SDO_CLI_ID + 1U, BENCH_SDO_CLI_ID + 0x7FU, (uint8_t)loadPercent);
+    b.can.firstCANtxMessage = false;
+
+    pthread_t bus, sdo, process;
+    pthread_create(&bus, NULL, bench_bus, &b);
+    pthread_create(&process, NULL, bench_process_task, &b);
+    pthread_create(&sdo, NULL, bench_sdo_task, &b);
+    bench_sleep_us((int64_t)seconds * 1000000);
+    b.stop = true;
+    pthread_join(sdo, NULL);
+    pthread_join(process, NULL);
+
+    /* Whatever is still held must drain from CO_CANmodule_process() alone. */
+    int64_t drainEnd = esp_timer_get_time() + BENCH_DRAIN_US;
+    while (esp_timer_get_time() < drainEnd && b.sdoOnBus < b.submitted) {
+        CO_CANmodule_process(&b.can);
+        bench_sleep_us(1000);
+    }
+    bench_sleep_us(20000);
+    b.busStop = true;
+    pthread_join(bus, NULL);
+
+    uint32_t lost = 0U;
+    uint32_t duplicated = 0U;
+    for (uint32_t i = 0; i < b.submitted; i++) {
+        lost += b.seen[i] == 0U ? 1U : 0U;
+        duplicated += b.seen[i] > 1U ? 1U : 0U;
+    }
+    uint32_t full = 0U;
+    for (uint32_t i = 0; i <= clients; i++) {
+        full += b.tx[i].bufferFull ? 1U : 0U;
+    }
+    double sdoKbps = (double)b.sdoBits / seconds / 1000.0;
+
+    printf("lock=%s load=%u%% clients=%u tick=%uus time=%us\n", s_lockEnabled ? "on" : "off",
+           (unsigned)loadPercent, (unsigned)clients, (unsigned)periodUs, (unsigned)seconds);
+    printf("sdo frames   : %u submitted, %u on bus, %u held by the limiter\n", (unsigned)b.submitted,
+           (unsigned)b.sdoOnBus, (unsigned)b.can.bulk.framesHeld);
+    printf("sdo bit rate : %.1f kbit/s of %u kbit/s allowed\n", sdoKbps,
+           (unsigned)(BENCH_BITRATE_KBPS * loadPercent / 100U));
+    printf("heartbeats   : %u sent, %u on bus\n", (unsigned)b.hbSent, (unsigned)b.hbOnBus);
+    printf("consistency  : %u lost, %u duplicated, CANtxCount %u with %u full buffers\n", (unsigned)lost,
+           (unsigned)duplicated, (unsigned)b.can.CANtxCount, (unsigned)full);
+
+    free((void*)b.seen);
+    return (lost != 0U || duplicated != 0U || b.can.CANtxCount != full) ? 1 : 0;
+}
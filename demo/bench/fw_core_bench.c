@@ -0,0 +1,180 @@
+/*
+ * Host benchmark for the firmware update core (demo/fw_common/fw_update_core.c).
+ *
+ * Runs complete sessions - metadata, erase, chunked receive, finalize, readback, activate -
+ * against the RAM backend or the file-backed flash emulator, so the core's own cost can be
+ * profiled (perf, valgrind) at production image sizes without a board or a CAN bus.
+ *
+ * Build on Linux (needs libmbedtls for SHA-256; drop the define and -lmbedcrypto for CRC only):
+ *   cc -O2 -DCONFIG_FW_DIGEST_SHA256=1 -I../fw_common -o fw_core_bench fw_core_bench.c ../fw_common/fw_update_core.c \
+ *      ../fw_common/fw_storage_file.c ../fw_common/fw_storage_ram.c ../fw_common/fw_digest.c \
+ *      ../fw_common/fw_trace.c -lmbedcrypto
+ *
+ * Examples:
+ *   ./fw_core_bench -b ram -s 1572864 -c 889
+ *   ./fw_core_bench -b file -f /tmp/flash.bin -e 45000 -w 700 -d sha256
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fw_storage.h"
+#include "fw_update_core.h"
+
+#define BENCH_DEFAULT_SIZE  (1536U * 1024U)
+#define BENCH_DEFAULT_CHUNK 889U
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static void bench_usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [-b ram|file] [-f path] [-s bytes] [-c chunk] [-e erase_us] [-w write_us] [-d none|crc32|sha256] "
+            "[-n runs]\n",
+            argv0);
+}
+
+static bool bench_digest(fw_digest_type_t type, const uint8_t *image, uint32_t size, uint8_t out[FW_DIGEST_MAX_LEN]) {
+    fw_digest_t digest;
+    memset(out, 0, FW_DIGEST_MAX_LEN);
+    if (type == FW_DIGEST_NONE) {
+        return true;
+    }
+    if (!fw_digest_begin(&digest, type)) {
+        return false;
+    }
+    fw_digest_update(&digest, image, size);
+    return fw_digest_finish(&digest, out) > 0U;
+}
+
+int main(int argc, char **argv) {
+    const char *backend = "ram";
+    const char *path = "fw_flash.bin";
+    uint32_t size = BENCH_DEFAULT_SIZE;
+    uint32_t chunk = BENCH_DEFAULT_CHUNK;
+    long eraseUs = -1;
+    long writeUs = -1;
+    uint32_t runs = 1U;
+    fw_digest_type_t digestType = FW_DIGEST_NONE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:f:s:c:e:w:d:n:h")) != -1) {
+        switch (opt) {
+        case 'b':
+            backend = optarg;
+            break;
+        case 'f':
+            path = optarg;
+            break;
+        case 's':
+            size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            chunk = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'e':
+            eraseUs = strtol(optarg, NULL, 0);
+            break;
+        case 'w':
+            writeUs = strtol(optarg, NULL, 0);
+            break;
+        case 'd':
+            digestType = strcmp(optarg, "sha256") == 0  ? FW_DIGEST_SHA256
+                         : strcmp(optarg, "crc32") == 0 ? FW_DIGEST_CRC32
+                                                        : FW_DIGEST_NONE;
+            break;
+        case 'n':
+            runs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            bench_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (size == 0U || chunk == 0U || runs == 0U) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+
+    uint8_t *image = malloc(size);
+    uint8_t *ramBank = malloc(size);
+    if (image == NULL || ramBank == NULL) {
+        fprintf(stderr, "out of memory for %u byte image\n", (unsigned)size);
+        return 1;
+    }
+    uint32_t seed = 0x12345678U;
+    for (uint32_t i = 0; i < size; i++) {
+        seed = seed * 1103515245U + 12345U;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+    uint8_t expected[FW_DIGEST_MAX_LEN];
+    if (!bench_digest(digestType, image, size, expected)) {
+        fprintf(stderr, "digest type %d not available\n", (int)digestType);
+        return 1;
+    }
+    fw_metadata_record_t meta = {.imageBytes = size, .crc = fw_crc16_update(0xFFFFU, image, size), .bank = 1U};
+
+    fw_storage_t storage;
+    fw_storage_ram_t ram;
+    fw_storage_file_t file = FW_STORAGE_FILE_DEFAULTS(path, size);
+    if (strcmp(backend, "file") == 0) {
+        /* Unset latencies keep the SPI NOR defaults from FW_STORAGE_FILE_DEFAULTS. */
+        if (eraseUs >= 0) {
+            file.eraseUsPerSector = (uint32_t)eraseUs;
+        }
+        if (writeUs >= 0) {
+            file.writeUsPerPage = (uint32_t)writeUs;
+        }
+        if (!fw_storage_file_init(&storage, &file)) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+    } else {
+        fw_storage_ram_init(&storage, &ram, ramBank, size);
+    }
+
+    printf("backend=%s size=%u chunk=%u digest=%d runs=%u\n", storage.ops->name, (unsigned)size, (unsigned)chunk,
+           (int)digestType, (unsigned)runs);
+    int status = 0;
+    for (uint32_t run = 0; run < runs && status == 0; run++) {
+        fw_core_t core;
+        fw_core_init(&core, &storage, size);
+
+        double t0 = bench_now_ms();
+        bool ok = fw_core_store_metadata(&core, &meta) &&
+                  fw_core_store_digest(&core, digestType, expected) && fw_core_prepare(&core);
+        double t1 = bench_now_ms();
+        for (uint32_t offset = 0; ok && offset < size; offset += chunk) {
+            uint32_t len = size - offset < chunk ? size - offset : chunk;
+            ok = fw_core_receive_chunk(&core, image + offset, len, offset);
+        }
+        double t2 = bench_now_ms();
+        ok = ok && fw_core_finalize(&core, meta.crc);
+        double t3 = bench_now_ms();
+        ok = ok && fw_core_verify_readback(&core, size, digestType, expected) && fw_core_activate(&core);
+        double t4 = bench_now_ms();
+
+        if (!ok) {
+            fprintf(stderr, "run %u failed in stage %d\n", (unsigned)run, (int)core.stage);
+            status = 1;
+            break;
+        }
+        double receiveMs = t2 - t1;
+        printf("run %u: erase %.2f ms, receive %.2f ms (%.1f KiB/s), finalize %.2f ms, readback %.2f ms\n",
+               (unsigned)run, t1 - t0, receiveMs, receiveMs > 0.0 ? (size / 1024.0) / (receiveMs / 1000.0) : 0.0,
+               t3 - t2, t4 - t3);
+    }
+    if (strcmp(backend, "file") == 0) {
+        printf("emulated flash time: erase %.1f ms, program %.1f ms\n", file.eraseUs / 1000.0, file.writeUs / 1000.0);
+        fw_storage_file_close(&file);
+    }
+    free(image);
+    free(ramBank);
+    return status;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef enum { TWAI_MODE_NORMAL } twai_mode_t;
+typedef struct {
+    uint32_t identifier;
+    uint8_t data_length_code;
+    uint8_t data[8];
+    uint32_t extd : 1;
+    uint32_t rtr : 1;
+    uint32_t ss : 1;
+    uint32_t self : 1;
+    uint32_t dlc_non_comp : 1;
+} twai_message_t;
+typedef struct { int tx_io; int rx_io; twai_mode_t mode; } twai_general_config_t;
+typedef struct { uint32_t bitrate; } twai_timing_config_t;
+typedef struct { uint32_t acceptance_code; } twai_filter_config_t;
+
+#define TWAI_GENERAL_CONFIG_DEFAULT(tx, rx, op_mode) {(tx), (rx), (op_mode)}
+#define TWAI_TIMING_CONFIG_125KBITS() {125000U}
+#define TWAI_TIMING_CONFIG_250KBITS() {250000U}
+#define TWAI_TIMING_CONFIG_500KBITS() {500000U}
+#define TWAI_TIMING_CONFIG_1MBITS()   {1000000U}
+#define TWAI_FILTER_CONFIG_ACCEPT_ALL() {0U}
+
+esp_err_t twai_driver_install(const twai_general_config_t* g, const twai_timing_config_t* t,
+                              const twai_filter_config_t* f);
+esp_err_t twai_start(void);
+esp_err_t twai_transmit(const twai_message_t* message, TickType_t ticks_to_wait);
+esp_err_t twai_receive(twai_message_t* message, TickType_t ticks_to_wait);
@@ -0,0 +1,8 @@
+#pragma once
+#include <stdint.h>
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+#define pdTRUE           1
+#define pdFALSE          0
+#define portMAX_DELAY    0xFFFFFFFFU
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
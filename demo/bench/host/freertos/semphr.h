@@ -0,0 +1,8 @@
+#pragma once
+#include <pthread.h>
+#include "FreeRTOS.h"
+typedef struct { pthread_mutex_t mutex; } StaticSemaphore_t;
+typedef StaticSemaphore_t* SemaphoreHandle_t;
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
@@ -0,0 +1,2 @@
+/* Host stand-in for the ESP-IDF headers used by canopennode/CO_driver.c, see can_tx_bench.c. */
+#pragma once
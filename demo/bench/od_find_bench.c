@@ -0,0 +1,241 @@
+/*
+ * Host benchmark for the Object Dictionary lookup done on every SDO initiate
+ * (canopennode/301/CO_ODinterface.c).
+ *
+ * A firmware download writes 0x1F50:01 once per chunk, and the SDO server resolves the object
+ * again for each of those writes. This times that per-request cost three ways over the slave's
+ * Object Dictionary: OD_find() as a binary search followed by OD_getSub(), the same with the
+ * perfect hash generated into OD.c, and OD_getSubCached() as the SDO server uses it with
+ * CO_CONFIG_SDO_SRV_OD_CACHE. -e adds manufacturer entries to see how the search scales with
+ * a larger OD; the hash for those is built here the way it is generated for OD.c.
+ *
+ * Build on Linux; the example target header stands in for the ESP-IDF one:
+ *   cc -O2 -I../demoslave/canopennode -include ../demoslave/canopennode/example/CO_driver_target.h \
+ *      -o od_find_bench od_find_bench.c ../demoslave/canopennode/301/CO_ODinterface.c \
+ *      ../demoslave/canopennode/OD.c
+ *
+ * Examples:
+ *   ./od_find_bench
+ *   ./od_find_bench -e 400 -d 50 -r 2000000
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The bench builds OD entries of its own, which needs the object types OD.c sees. */
+#define OD_DEFINITION
+#include "301/CO_ODinterface.h"
+#include "OD.h"
+
+#define BENCH_DEFAULT_REQUESTS 1000000U
+#define BENCH_DEFAULT_DOWNLOAD 90U /* percent of requests that are 0x1F50:01 writes */
+#define BENCH_EXTRA_FIRST      0x2200U
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static void bench_usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [-e extra entries] [-d download percent] [-r requests] [-n runs]\n", argv0);
+}
+
+/* Smallest table, then the first odd multiplier without collisions, as for OD.c. */
+static bool bench_hash_build(const OD_t* od, OD_hash_t* hash, uint16_t** slotsOut) {
+    uint8_t bits = 1U;
+    while ((1UL << bits) < od->size) {
+        bits++;
+    }
+    for (bits++; bits <= 16U; bits++) {
+        uint32_t count = 1UL << bits;
+        uint16_t* slots = calloc(count, sizeof(slots[0]));
+        if (slots == NULL) {
+            return false;
+        }
+        for (uint32_t mult = 1U; mult < 0x10000U; mult += 2U) {
+            bool ok = true;
+            memset(slots, 0, count * sizeof(slots[0]));
+            for (uint16_t i = 0; i < od->size && ok; i++) {
+                uint16_t slot = (uint16_t)((uint32_t)od->list[i].index * mult) >> (16U - bits);
+                ok = slots[slot] == 0U;
+                slots[slot] = (uint16_t)(i + 1U);
+            }
+            if (ok) {
+                hash->multiplier = (uint16_t)mult;
+                hash->shift = (uint8_t)(16U - bits);
+                hash->slots = slots;
+                *slotsOut = slots;
+                return true;
+            }
+        }
+        free(slots);
+    }
+    return false;
+}
+
+static int bench_entry_cmp(const void* a, const void* b) {
+    return (int)((const OD_entry_t*)a)->index - (int)((const OD_entry_t*)b)->index;
+}
+
+typedef enum { BENCH_BINARY, BENCH_HASH, BENCH_CACHED } bench_mode_t;
+
+static const char* const s_modeNames[] = {"binary search", "hash", "hash + cache"};
+
+/* One SDO initiate: resolve the object and look at its attribute, as the server does. */
+static uint32_t bench_pass(bench_mode_t mode, OD_t* od, const uint16_t* indexes, const uint8_t* subs, uint32_t count) {
+    OD_IOcache_t cache;
+    OD_IO_t io;
+    uint32_t found = 0U;
+    memset(&cache, 0, sizeof(cache));
+    for (uint32_t i = 0; i < count; i++) {
+        ODR_t ret = mode == BENCH_CACHED ? OD_getSubCached(od, indexes[i], subs[i], &io, &cache)
+                                         : OD_getSub(OD_find(od, indexes[i]), subs[i], &io, false);
+        if (ret == ODR_OK && (io.stream.attribute & ODA_SDO_RW) != 0U) {
+            found++;
+        }
+    }
+    return found;
+}
+
+/* Every index, present or not, must resolve the same with and without the hash and the cache. */
+static bool bench_verify(OD_t* plain, OD_t* hashed) {
+    OD_IOcache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    for (uint32_t index = 0; index <= 0xFFFFU; index++) {
+        if (OD_find(plain, (uint16_t)index) != OD_find(hashed, (uint16_t)index)) {
+            fprintf(stderr, "hash lookup of 0x%04X differs from the binary search\n", (unsigned)index);
+            return false;
+        }
+    }
+    for (uint16_t i = 0; i < plain->size; i++) {
+        for (uint8_t pass = 0; pass < 2U; pass++) {
+            OD_IO_t fresh;
+            OD_IO_t cached;
+            ODR_t r1 = OD_getSub(OD_find(plain, plain->list[i].index), 0, &fresh, false);
+            ODR_t r2 = OD_getSubCached(hashed, plain->list[i].index, 0, &cached, &cache);
+            if (r1 != r2 || (r1 == ODR_OK && memcmp(&fresh, &cached, sizeof(fresh)) != 0)) {
+                fprintf(stderr, "cached io of 0x%04X differs\n", (unsigned)plain->list[i].index);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint32_t extra = 0U;
+    uint32_t downloadPct = BENCH_DEFAULT_DOWNLOAD;
+    uint32_t requests = BENCH_DEFAULT_REQUESTS;
+    uint32_t runs = 3U;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "e:d:r:n:h")) != -1) {
+        switch (opt) {
+        case 'e':
+            extra = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'd':
+            downloadPct = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            requests = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            runs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            bench_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (downloadPct > 100U || requests == 0U || runs == 0U || extra > 0xFFFFU - BENCH_EXTRA_FIRST - OD->size) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+
+    /* The slave's entries plus the extra ones, sorted, with the blank entry at the end. */
+    uint32_t size = OD->size + extra;
+    OD_entry_t* list = calloc(size + 1U, sizeof(list[0]));
+    uint8_t varData[4] = {0};
+    OD_obj_var_t var = {varData, ODA_SDO_RW, sizeof(varData)};
+    uint16_t* indexes = malloc(requests * sizeof(indexes[0]));
+    uint8_t* subs = malloc(requests);
+    if (list == NULL || indexes == NULL || subs == NULL) {
+        fprintf(stderr, "out of memory for %u requests\n", (unsigned)requests);
+        return 1;
+    }
+    memcpy(list, OD->list, OD->size * sizeof(list[0]));
+    for (uint32_t i = 0; i < extra; i++) {
+        list[OD->size + i] = (OD_entry_t){(uint16_t)(BENCH_EXTRA_FIRST + i), 1, ODT_VAR, &var, NULL};
+    }
+    qsort(list, size, sizeof(list[0]), bench_entry_cmp);
+
+    OD_t plain = {(uint16_t)size, list, NULL};
+    OD_t hashed = plain;
+    OD_hash_t hash;
+    uint16_t* slots = NULL;
+    if (extra == 0U) {
+        hashed.hash = OD->hash; /* the table generated into OD.c */
+    } else if (bench_hash_build(&plain, &hash, &slots)) {
+        hashed.hash = &hash;
+    } else {
+        fprintf(stderr, "no perfect hash for %u entries\n", (unsigned)size);
+        return 1;
+    }
+    if (hashed.hash == NULL || !bench_verify(&plain, &hashed)) {
+        return 1;
+    }
+
+    /* Chunk writes to 0x1F50:01 with reads of random other objects in between. */
+    uint32_t seed = 0x12345678U;
+    for (uint32_t i = 0; i < requests; i++) {
+        seed = seed * 1103515245U + 12345U;
+        if ((seed >> 16) % 100U < downloadPct) {
+            indexes[i] = 0x1F50U;
+            subs[i] = 1U;
+        } else {
+            indexes[i] = list[(seed >> 8) % size].index;
+            subs[i] = 0U;
+        }
+    }
+
+    printf("entries=%u slots=%u requests=%u download=%u%% runs=%u\n", (unsigned)size,
+           (unsigned)(0x10000UL >> hashed.hash->shift), (unsigned)requests, (unsigned)downloadPct, (unsigned)runs);
+    double bestMs[3] = {0.0, 0.0, 0.0};
+    uint32_t found[3] = {0U, 0U, 0U};
+    for (int mode = BENCH_BINARY; mode <= BENCH_CACHED; mode++) {
+        OD_t* od = mode == BENCH_BINARY ? &plain : &hashed;
+        for (uint32_t run = 0; run < runs; run++) {
+            double t0 = bench_now_ms();
+            found[mode] = bench_pass((bench_mode_t)mode, od, indexes, subs, requests);
+            double ms = bench_now_ms() - t0;
+            if (run == 0U || ms < bestMs[mode]) {
+                bestMs[mode] = ms;
+            }
+        }
+        printf("%-13s: %8.2f ms, %6.1f ns/request\n", s_modeNames[mode], bestMs[mode],
+               bestMs[mode] * 1e6 / requests);
+    }
+    int status = 0;
+    if (found[0] != found[1] || found[0] != found[2]) {
+        fprintf(stderr, "lookups disagree: %u %u %u objects found\n", (unsigned)found[0], (unsigned)found[1],
+                (unsigned)found[2]);
+        status = 1;
+    } else {
+        for (int mode = BENCH_HASH; mode <= BENCH_CACHED; mode++) {
+            if (bestMs[mode] > 0.0) {
+                printf("%-13s speedup: %.2fx\n", s_modeNames[mode], bestMs[BENCH_BINARY] / bestMs[mode]);
+            }
+        }
+    }
+
+    free(slots);
+    free(list);
+    free(indexes);
+    free(subs);
+    return status;
+}
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Pack an application image and/or a config blob into one firmware bundle (.fwb).
+
+The layout matches fw_common/fw_bundle.h: an 8-byte header, one 40-byte table entry
+per section (type, bank, digest type, size, digest) and the section payloads back to back.
+"""
+
+from __future__ import annotations
+
+import argparse
+import hashlib
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parent
+
+BUNDLE_MAGIC = b"FWBN"
+BUNDLE_VERSION = 1
+MAX_SECTIONS = 4
+
+SECTION_TYPES = {"main": 0, "bootloader": 1, "config": 2}
+DIGEST_TYPES = {"crc32": 1, "sha256": 2}
+
+
+def parse_section(value: str) -> tuple[str, Path, int]:
+    """TYPE:PATH[:BANK]"""
+
+    parts = value.split(":")
+    if len(parts) not in (2, 3):
+        raise argparse.ArgumentTypeError("Section must be TYPE:PATH or TYPE:PATH:BANK")
+    kind = parts[0].strip().lower()
+    if kind not in SECTION_TYPES:
+        raise argparse.ArgumentTypeError(f"Unknown section type '{kind}' (use {', '.join(SECTION_TYPES)})")
+    path = Path(parts[1])
+    if not path.is_file():
+        raise argparse.ArgumentTypeError(f"{path} is not a file")
+    bank = int(parts[2], 0) if len(parts) == 3 else 0
+    if not 0 <= bank <= 0xFF:
+        raise argparse.ArgumentTypeError("Bank must fit in one byte")
+    return kind, path, bank
+
+
+def section_digest(data: bytes, digest: str) -> bytes:
+    if digest == "crc32":
+        # Same value as esp_rom_crc32_le(0, ...), stored little endian and zero padded.
+        return struct.pack("<I", zlib.crc32(data) & 0xFFFFFFFF).ljust(32, b"\0")
+    return hashlib.sha256(data).digest()
+
+
+def build_bundle(sections: list[tuple[str, Path, int]], digest: str) -> bytes:
+    header = struct.pack("<4sBBH", BUNDLE_MAGIC, BUNDLE_VERSION, len(sections), 0)
+    table = b""
+    payload = b""
+    for kind, path, bank in sections:
+        data = path.read_bytes()
+        if not data:
+            sys.exit(f"{path} is empty")
+        table += struct.pack("<BBBBI", SECTION_TYPES[kind], bank, DIGEST_TYPES[digest], 0, len(data))
+        table += section_digest(data, digest)
+        payload += data
+        print(f"[BUNDLE] {kind:<10} {len(data):>8} bytes  bank {bank}  {path}")
+    return header + table + payload
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        "--section",
+        action="append",
+        type=parse_section,
+        required=True,
+        help="Section spec TYPE:PATH[:BANK], TYPE one of main/config (can be repeated, sent in order)",
+    )
+    parser.add_argument(
+        "--digest",
+        choices=sorted(DIGEST_TYPES),
+        default="sha256",
+        help="Per-section digest checked by the slave (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--output",
+        type=Path,
+        default=REPO_ROOT / "artifacts" / "bundle.fwb",
+        help="Bundle file to write (default: %(default)s)",
+    )
+
+    args = parser.parse_args()
+    if len(args.section) > MAX_SECTIONS:
+        sys.exit(f"At most {MAX_SECTIONS} sections fit in a bundle")
+
+    bundle = build_bundle(args.section, args.digest)
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_bytes(bundle)
+    print(f"[BUNDLE] Wrote {len(bundle)} bytes -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -278,12 +278,25 @@ typedef struct {
     OD_extension_t* extension; /**< Extension to OD, specified by application */
 } OD_entry_t;
 
+/**
+ * Perfect hash of the indexes in an Object Dictionary, optional part of @ref OD_t
+ *
+ * Generated together with the Object Dictionary: the multiplier is chosen so that no two indexes of the OD land in
+ * the same slot, which turns @ref OD_find() into one multiplication and one compare instead of a binary search.
+ */
+typedef struct {
+    uint16_t multiplier;   /**< Slot of index is (uint16_t)(index * multiplier) >> shift */
+    uint8_t shift;         /**< 16 - log2 of the number of slots */
+    const uint16_t* slots; /**< Position of the entry in @ref OD_t list plus one, 0 for an empty slot */
+} OD_hash_t;
+
 /**
  * Object Dictionary
  */
 typedef struct {
-    uint16_t size;    /**< Number of elements in the list, without last element, which is blank */
-    OD_entry_t* list; /**< List OD entries (table of contents), ordered by index */
+    uint16_t size;         /**< Number of elements in the list, without last element, which is blank */
+    OD_entry_t* list;      /**< List OD entries (table of contents), ordered by index */
+    const OD_hash_t* hash; /**< Optional hash of the list, if NULL, @ref OD_find() uses binary search */
 } OD_t;
 
 /**
@@ -332,6 +345,35 @@ OD_entry_t* OD_find(OD_t* od, uint16_t index);
  */
 ODR_t OD_getSub(const OD_entry_t* entry, uint8_t subIndex, OD_IO_t* io, bool_t odOrig);
 
+/**
+ * Last object resolved by @ref OD_getSubCached()
+ *
+ * Must be zero initialized. Each user, for example each SDO server, keeps its own for one Object Dictionary.
+ */
+typedef struct {
+    OD_IO_t io;                /**< io as returned by @ref OD_getSub(), before any read or write */
+    OD_entry_t* entry;         /**< Entry of io, NULL if nothing is cached */
+    OD_extension_t* extension; /**< Extension of entry at the time io was resolved */
+    uint8_t subIndex;          /**< Sub-index of io */
+} OD_IOcache_t;
+
+/**
+ * Find OD entry and get its sub-object, reusing the previous result if index and subIndex did not change
+ *
+ * Equivalent to OD_getSub(OD_find(od, index), subIndex, io, false). Objects accessed repeatedly, like a program
+ * download written chunk by chunk, skip the search on every access. The cached result is not reused, if the extension
+ * of the entry was changed since then, see @ref OD_extension_init().
+ *
+ * @param od Object Dictionary
+ * @param index CANopen Object Dictionary index of object in Object Dictionary
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param [out] io Structure will be populated on success.
+ * @param cache Cache of the caller.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+ODR_t OD_getSubCached(OD_t* od, uint16_t index, uint8_t subIndex, OD_IO_t* io, OD_IOcache_t* cache);
+
 /**
  * Return index from OD entry
  *
@@ -269,6 +269,9 @@ CO_SDOserver_init(CO_SDOserver_t* SDO, OD_t* OD, OD_entry_t* OD_1200_SDOsrvPar,
     SDO->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
 #endif
     SDO->state = CO_SDO_ST_IDLE;
+#if ((CO_CONFIG_SDO_SRV)&CO_CONFIG_SDO_SRV_OD_CACHE) != 0
+    SDO->OD_IOcache.entry = NULL;
+#endif
 
 #if ((CO_CONFIG_SDO_SRV)&CO_CONFIG_FLAG_CALLBACK_PRE) != 0
     SDO->pFunctSignalPre = NULL;
@@ -641,7 +644,11 @@ CO_SDOserver_process(CO_SDOserver_t* SDO, bool_t NMTisPreOrOperational, uint32_t
                 ODR_t odRet;
                 SDO->index = (uint16_t)((((uint16_t)SDO->CANrxData[2]) << 8) | SDO->CANrxData[1]);
                 SDO->subIndex = SDO->CANrxData[3];
+#if ((CO_CONFIG_SDO_SRV)&CO_CONFIG_SDO_SRV_OD_CACHE) != 0
+                odRet = OD_getSubCached(SDO->OD, SDO->index, SDO->subIndex, &SDO->OD_IO, &SDO->OD_IOcache);
+#else
                 odRet = OD_getSub(OD_find(SDO->OD, SDO->index), SDO->subIndex, &SDO->OD_IO, false);
+#endif
                 if (odRet != ODR_OK) {
                     abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
                     SDO->state = CO_SDO_ST_ABORT;
@@ -364,6 +364,9 @@ typedef struct {
     bool_t valid;                  /**< If true, SDO channel is valid */
     volatile CO_SDO_state_t state; /**< Internal state of the SDO server */
     OD_IO_t OD_IO;                 /**< Object dictionary interface for current object. */
+#if (((CO_CONFIG_SDO_SRV)&CO_CONFIG_SDO_SRV_OD_CACHE) != 0) || defined CO_DOXYGEN
+    OD_IOcache_t OD_IOcache; /**< Object dictionary interface for the previous object, see OD_getSubCached() */
+#endif
     uint16_t index;                /**< Index of the current object in Object Dictionary */
     uint8_t subIndex;              /**< Subindex of the current object in Object Dictionary */
     volatile void* CANrxNew;       /**< Indicates, if new SDO message received from CAN bus. It is not cleared,
@@ -344,6 +344,9 @@ extern "C" {
  * - CO_CONFIG_SDO_SRV_SEGMENTED - Enable SDO server segmented transfer.
  * - CO_CONFIG_SDO_SRV_BLOCK - Enable SDO server block transfer. If set, then
  *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_OD_CACHE - Keep the last object found in the Object
+ *   Dictionary and reuse it, if the next transfer is for the same index and
+ *   sub-index. See OD_getSubCached().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOserver_initCallbackPre().
@@ -359,6 +362,7 @@ extern "C" {
 #endif
 #define CO_CONFIG_SDO_SRV_SEGMENTED 0x02
 #define CO_CONFIG_SDO_SRV_BLOCK     0x04
+#define CO_CONFIG_SDO_SRV_OD_CACHE  0x08
 
 /**
  * Size of the internal data buffer for the SDO server.
@@ -759,6 +763,44 @@ extern "C" {
 #define CO_CONFIG_TRACE_OWN_INTTYPES 0x02
 /** @} */ /* CO_STACK_CONFIG_TRACE */
 
+/**
+ * @defgroup CO_STACK_CONFIG_PROCESS Processing of CANopen objects
+ * Non standard, how CO_process() runs the mainline objects
+ * @{
+ */
+/**
+ * Configuration of @ref CO_process().
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_PROCESS_SCHEDULE - Process an object only when it has something
+ *   to do: a message received, a timer expired or a change of the NMT state or
+ *   the CAN error status. Otherwise it is skipped and the elapsed time is handed
+ *   to it on the next run. Only objects configured with both
+ *   #CO_CONFIG_FLAG_CALLBACK_PRE and #CO_CONFIG_FLAG_TIMERNEXT are scheduled
+ *   (LEDs with #CO_CONFIG_FLAG_TIMERNEXT), the others are processed on every
+ *   call. Their CO_***_initCallbackPre() functions are used internally, the
+ *   application registers its callback with CO_process_initCallbackPre().
+ * - CO_CONFIG_PROCESS_STATS - Count calls, skips and the time spent in each
+ *   object, see @ref CO_processStat_t. Target must define
+ *   CO_PROCESS_TIME_US(), a free running microsecond counter.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_PROCESS (0)
+#endif
+#define CO_CONFIG_PROCESS_SCHEDULE 0x01
+#define CO_CONFIG_PROCESS_STATS    0x02
+
+/**
+ * Longest time in microseconds a scheduled object is left without processing.
+ *
+ * Bounds the delay of changes, which are not signalled by the objects, for
+ * example error register or OD parameters written by the application.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_PROCESS_IDLE_US 100000
+#endif
+/** @} */ /* CO_STACK_CONFIG_PROCESS */
+
 /**
  * @defgroup CO_STACK_CONFIG_DEBUG Debug messages
  * Messages from different parts of the stack.
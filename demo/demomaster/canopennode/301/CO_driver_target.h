@@ -14,6 +14,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,26 @@ typedef struct {
     volatile bool_t syncFlag;
 } CO_CANtx_t;
 
+/*
+ * Bus-load budget for bulk frames, normally the SDO client requests of a firmware transfer.
+ * Frames with an identifier in [identMin, identMax] are sent from a token bucket refilled at
+ * loadPercent of the bit rate minus what the other nodes currently use; frames over budget
+ * wait in their buffer (bufferFull) and go out from CO_CANmodule_process(). Every other
+ * frame is sent at once. See CO_CANsetBulkLimit().
+ */
+typedef struct {
+    uint16_t identMin;
+    uint16_t identMax;
+    uint8_t loadPercent;            /* ceiling for the whole bus, 0 = no limit */
+    volatile uint8_t othersPercent; /* load from other nodes, measured by CO_CANinterrupt() */
+    uint32_t bitRate;               /* bits per second */
+    int64_t tokens;                 /* bits bulk frames may send right now */
+    int64_t refillUs;
+    int64_t windowUs;               /* start of the current load sample */
+    uint32_t windowBits;            /* bits received in it */
+    uint32_t framesHeld;            /* bulk frames that had to wait for tokens */
+} CO_CANbulk_t;
+
 typedef struct {
     void* CANptr;
     CO_CANrx_t* rxArray;
@@ -68,8 +89,23 @@ typedef struct {
     volatile bool_t firstCANtxMessage;
     volatile uint16_t CANtxCount;
     uint32_t errOld;
+    CO_CANbulk_t bulk;
+    SemaphoreHandle_t txLock; /* CO_LOCK_CAN_SEND(), created once in CO_CANmodule_init() */
+    StaticSemaphore_t txLockBuffer;
 } CO_CANmodule_t;
 
+/* Bus bits of a standard data frame, with worst-case bit stuffing and the interframe space. */
+#define CO_CAN_FRAME_BITS(dlc) (47U + 8U * (uint32_t)(dlc) + (34U + 8U * (uint32_t)(dlc) - 1U) / 4U)
+
+/**
+ * Rate-limit frames with identifiers identMin..identMax so the bus stays below loadPercent.
+ * Call after CO_CANinit(); 0 removes the limit.
+ */
+void CO_CANsetBulkLimit(CO_CANmodule_t* CANmodule, uint16_t identMin, uint16_t identMax, uint8_t loadPercent);
+
+/** Bits per second bulk frames may use at the current load of the other nodes; 0 when unlimited. */
+uint32_t CO_CANbulkBitsPerSecond(const CO_CANmodule_t* CANmodule);
+
 typedef struct {
     void* addr;
     size_t len;
@@ -78,8 +114,13 @@ typedef struct {
     void* addrNV;
 } CO_storage_entry_t;
 
-#define CO_LOCK_CAN_SEND(CAN_MODULE)
-#define CO_UNLOCK_CAN_SEND(CAN_MODULE)
+/*
+ * The CANopen task drains held frames in CO_CANmodule_process() while the SDO queue task sends
+ * through CO_CANsend(); both change the TX buffers, CANtxCount and the bulk bucket. A mutex
+ * rather than a critical section, because twai_transmit() uses a FreeRTOS queue.
+ */
+#define CO_LOCK_CAN_SEND(CAN_MODULE)   ((void)xSemaphoreTake((CAN_MODULE)->txLock, portMAX_DELAY))
+#define CO_UNLOCK_CAN_SEND(CAN_MODULE) ((void)xSemaphoreGive((CAN_MODULE)->txLock))
 #define CO_LOCK_EMCY(CAN_MODULE)
 #define CO_UNLOCK_EMCY(CAN_MODULE)
 #define CO_LOCK_OD(CAN_MODULE)
@@ -90,6 +131,12 @@ typedef struct {
 #define CO_FLAG_SET(rxNew)  do { CO_MemoryBarrier(); rxNew = (void*)1L; } while (0)
 #define CO_FLAG_CLEAR(rxNew) do { CO_MemoryBarrier(); rxNew = NULL; } while (0)
 
+/* Free-running microsecond clock for the CO_process() statistics (CO_CONFIG_PROCESS_STATS). */
+#define CO_PROCESS_TIME_US() ((uint32_t)esp_timer_get_time())
+
+/* CO_USE_GLOBALS: start the CANopen objects on a cache line, 32 bytes on the ESP32 family. */
+#define CO_GLOBALS_ATTRIBUTE __attribute__((aligned(32)))
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -425,6 +425,9 @@ CO_new(CO_config_t* config, uint32_t* heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_SRV = 0);
         if (CO_GET_CNT(SDO_SRV) > 0U) {
             CO_alloc_break_on_fail(co->SDOserver, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserver));
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+            CO_alloc_break_on_fail(co->SDOserverSlot, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserverSlot));
+#endif
             ON_MULTI_OD(RX_CNT_SDO_SRV = config->CNT_SDO_SRV);
             ON_MULTI_OD(TX_CNT_SDO_SRV = config->CNT_SDO_SRV);
         }
@@ -732,6 +735,9 @@ CO_delete(CO_t* co) {
 #endif
 
     /* SDOserver */
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    CO_free(co->SDOserverSlot);
+#endif
     CO_free(co->SDOserver);
 
     /* Emergency */
@@ -765,137 +771,170 @@ CO_delete(CO_t* co) {
 #ifdef CO_MULTIPLE_OD
 #error CO_MULTIPLE_OD can not be used with CO_USE_GLOBALS
 #endif
-static CO_t COO;
-static CO_CANmodule_t COO_CANmodule;
-static CO_CANrx_t COO_CANmodule_rxArray[CO_CNT_ALL_RX_MSGS];
-static CO_CANtx_t COO_CANmodule_txArray[CO_CNT_ALL_TX_MSGS];
-static CO_NMT_t COO_NMT;
+#include <string.h>
+
+#if ((CO_CONFIG_TRACE)&CO_CONFIG_TRACE_ENABLE) != 0
+#ifndef CO_TRACE_BUFFER_SIZE_FIXED
+#define CO_TRACE_BUFFER_SIZE_FIXED 100
+#endif
+#endif
+
+/* Objects used on every received frame and by SDO transfers */
+#if ((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_ENABLE) != 0
+#define CO_GLOBALS_SDO_CLI CO_SDOclient_t SDOclient[OD_CNT_SDO_CLI];
+#else
+#define CO_GLOBALS_SDO_CLI
+#endif
+#define CO_GLOBALS_HOT                                                                                                 \
+    CO_CANmodule_t CANmodule;                                                                                          \
+    CO_CANrx_t CANrx[CO_CNT_ALL_RX_MSGS];                                                                              \
+    CO_SDOserver_t SDOserver[OD_CNT_SDO_SRV];                                                                          \
+    CO_GLOBALS_SDO_CLI
+
+/* All objects in one block, so the footprint is known at compile time */
+typedef struct {
+#ifdef CO_GLOBALS_HOT_FIRST
+    CO_GLOBALS_HOT
+#endif
+    CO_t co;
+#ifndef CO_GLOBALS_HOT_FIRST
+    CO_GLOBALS_HOT
+#endif
+    CO_CANtx_t CANtx[CO_CNT_ALL_TX_MSGS];
+    CO_NMT_t NMT;
 #if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
-static CO_HBconsumer_t COO_HBcons;
-static CO_HBconsNode_t COO_HBconsMonitoredNodes[OD_CNT_ARR_1016];
+    CO_HBconsumer_t HBcons;
+    CO_HBconsNode_t HBconsMonitoredNodes[OD_CNT_ARR_1016];
 #endif
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE) != 0
-static CO_nodeGuardingSlave_t COO_NGslave;
+    CO_nodeGuardingSlave_t NGslave;
 #endif
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_MASTER_ENABLE) != 0
-static CO_nodeGuardingMaster_t COO_NGmaster;
+    CO_nodeGuardingMaster_t NGmaster;
 #endif
-static CO_EM_t COO_EM;
+    CO_EM_t em;
 #if ((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)) != 0
-static CO_EM_fifo_t COO_EM_FIFO[CO_GET_CNT(ARR_1003) + 1U];
+    CO_EM_fifo_t em_fifo[CO_GET_CNT(ARR_1003) + 1U];
 #endif
-static CO_SDOserver_t COO_SDOserver[OD_CNT_SDO_SRV];
-#if ((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_ENABLE) != 0
-static CO_SDOclient_t COO_SDOclient[OD_CNT_SDO_CLI];
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    CO_processSlot_t SDOserverSlot[OD_CNT_SDO_SRV];
 #endif
 #if ((CO_CONFIG_TIME)&CO_CONFIG_TIME_ENABLE) != 0
-static CO_TIME_t COO_TIME;
+    CO_TIME_t TIME;
 #endif
 #if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0
-static CO_SYNC_t COO_SYNC;
+    CO_SYNC_t SYNC;
 #endif
 #if ((CO_CONFIG_PDO)&CO_CONFIG_RPDO_ENABLE) != 0
-static CO_RPDO_t COO_RPDO[OD_CNT_RPDO];
+    CO_RPDO_t RPDO[OD_CNT_RPDO];
 #endif
 #if ((CO_CONFIG_PDO)&CO_CONFIG_TPDO_ENABLE) != 0
-static CO_TPDO_t COO_TPDO[OD_CNT_TPDO];
+    CO_TPDO_t TPDO[OD_CNT_TPDO];
 #endif
 #if ((CO_CONFIG_LEDS)&CO_CONFIG_LEDS_ENABLE) != 0
-static CO_LEDs_t COO_LEDs;
+    CO_LEDs_t LEDs;
 #endif
 #if ((CO_CONFIG_GFC)&CO_CONFIG_GFC_ENABLE) != 0
-static CO_GFC_t COO_GFC;
+    CO_GFC_t GFC;
 #endif
 #if ((CO_CONFIG_SRDO)&CO_CONFIG_SRDO_ENABLE) != 0
-static CO_SRDOGuard_t COO_SRDOGuard;
-static CO_SRDO_t COO_SRDO[OD_CNT_SRDO];
+    CO_SRDOGuard_t SRDOGuard;
+    CO_SRDO_t SRDO[OD_CNT_SRDO];
 #endif
 #if ((CO_CONFIG_LSS)&CO_CONFIG_LSS_SLAVE) != 0
-static CO_LSSslave_t COO_LSSslave;
+    CO_LSSslave_t LSSslave;
 #endif
 #if ((CO_CONFIG_LSS)&CO_CONFIG_LSS_MASTER) != 0
-static CO_LSSmaster_t COO_LSSmaster;
+    CO_LSSmaster_t LSSmaster;
 #endif
 #if ((CO_CONFIG_GTW)&CO_CONFIG_GTW_ASCII) != 0
-static CO_GTWA_t COO_gtwa;
+    CO_GTWA_t gtwa;
 #endif
 #if ((CO_CONFIG_TRACE)&CO_CONFIG_TRACE_ENABLE) != 0
-#ifndef CO_TRACE_BUFFER_SIZE_FIXED
-#define CO_TRACE_BUFFER_SIZE_FIXED 100
-#endif
-static CO_trace_t COO_trace[OD_CNT_TRACE];
-static uint32_t COO_traceTimeBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
-static int32_t COO_traceValueBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
+    CO_trace_t trace[OD_CNT_TRACE];
+    uint32_t traceTimeBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
+    int32_t traceValueBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
 #endif
+} CO_globals_t;
+
+static CO_globals_t COO CO_GLOBALS_ATTRIBUTE;
 
 CO_t*
 CO_new(CO_config_t* config, uint32_t* heapMemoryUsed) {
     (void)config;
-    (void)heapMemoryUsed;
 
-    CO_t* co = &COO;
+    /* same starting state as objects from heap, also if CO_new() is called again after CO_delete() */
+    (void)memset(&COO, 0, sizeof(COO));
+    CO_t* co = &COO.co;
 
-    co->CANmodule = &COO_CANmodule;
-    co->CANrx = &COO_CANmodule_rxArray[0];
-    co->CANtx = &COO_CANmodule_txArray[0];
+    co->CANmodule = &COO.CANmodule;
+    co->CANrx = &COO.CANrx[0];
+    co->CANtx = &COO.CANtx[0];
 
-    co->NMT = &COO_NMT;
+    co->NMT = &COO.NMT;
 #if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
-    co->HBcons = &COO_HBcons;
-    co->HBconsMonitoredNodes = &COO_HBconsMonitoredNodes[0];
+    co->HBcons = &COO.HBcons;
+    co->HBconsMonitoredNodes = &COO.HBconsMonitoredNodes[0];
 #endif
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE) != 0
-    co->NGslave = &COO_NGslave;
+    co->NGslave = &COO.NGslave;
 #endif
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_MASTER_ENABLE) != 0
-    co->NGmaster = &COO_NGmaster;
+    co->NGmaster = &COO.NGmaster;
 #endif
-    co->em = &COO_EM;
+    co->em = &COO.em;
 #if ((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)) != 0
-    co->em_fifo = &COO_EM_FIFO[0];
+    co->em_fifo = &COO.em_fifo[0];
+#endif
+    co->SDOserver = &COO.SDOserver[0];
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    co->SDOserverSlot = &COO.SDOserverSlot[0];
 #endif
-    co->SDOserver = &COO_SDOserver[0];
 #if ((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_ENABLE) != 0
-    co->SDOclient = &COO_SDOclient[0];
+    co->SDOclient = &COO.SDOclient[0];
 #endif
 #if ((CO_CONFIG_TIME)&CO_CONFIG_TIME_ENABLE) != 0
-    co->TIME = &COO_TIME;
+    co->TIME = &COO.TIME;
 #endif
 #if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0
-    co->SYNC = &COO_SYNC;
+    co->SYNC = &COO.SYNC;
 #endif
 #if ((CO_CONFIG_PDO)&CO_CONFIG_RPDO_ENABLE) != 0
-    co->RPDO = &COO_RPDO[0];
+    co->RPDO = &COO.RPDO[0];
 #endif
 #if ((CO_CONFIG_PDO)&CO_CONFIG_TPDO_ENABLE) != 0
-    co->TPDO = &COO_TPDO[0];
+    co->TPDO = &COO.TPDO[0];
 #endif
 #if ((CO_CONFIG_LEDS)&CO_CONFIG_LEDS_ENABLE) != 0
-    co->LEDs = &COO_LEDs;
+    co->LEDs = &COO.LEDs;
 #endif
 #if ((CO_CONFIG_GFC)&CO_CONFIG_GFC_ENABLE) != 0
-    co->GFC = &COO_GFC;
+    co->GFC = &COO.GFC;
 #endif
 #if ((CO_CONFIG_SRDO)&CO_CONFIG_SRDO_ENABLE) != 0
-    co->SRDOGuard = &COO_SRDOGuard;
-    co->SRDO = &COO_SRDO[0];
+    co->SRDOGuard = &COO.SRDOGuard;
+    co->SRDO = &COO.SRDO[0];
 #endif
 #if ((CO_CONFIG_LSS)&CO_CONFIG_LSS_SLAVE) != 0
-    co->LSSslave = &COO_LSSslave;
+    co->LSSslave = &COO.LSSslave;
 #endif
 #if ((CO_CONFIG_LSS)&CO_CONFIG_LSS_MASTER) != 0
-    co->LSSmaster = &COO_LSSmaster;
+    co->LSSmaster = &COO.LSSmaster;
 #endif
 #if ((CO_CONFIG_GTW)&CO_CONFIG_GTW_ASCII) != 0
-    co->gtwa = &COO_gtwa;
+    co->gtwa = &COO.gtwa;
 #endif
 #if ((CO_CONFIG_TRACE)&CO_CONFIG_TRACE_ENABLE) != 0
-    co->trace = &COO_trace[0];
-    co->traceTimeBuffers = &COO_traceTimeBuffers[0][0];
-    co->traceValueBuffers = &COO_traceValueBuffers[0][0];
+    co->trace = &COO.trace[0];
+    co->traceTimeBuffers = &COO.traceTimeBuffers[0][0];
+    co->traceValueBuffers = &COO.traceValueBuffers[0][0];
     co->traceBufferSize = CO_TRACE_BUFFER_SIZE_FIXED;
 #endif
 
+    co->nodeIdUnconfigured = true;
+    if (heapMemoryUsed != NULL) {
+        *heapMemoryUsed = (uint32_t)sizeof(COO);
+    }
     return co;
 }
 
@@ -922,6 +961,165 @@ CO_isLSSslaveEnabled(CO_t* co) {
     return en;
 }
 
+/* Scheduling of CO_process() ************************************************/
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0
+#ifndef CO_PROCESS_TIME_US
+#error CO_CONFIG_PROCESS_STATS requires CO_PROCESS_TIME_US() from CO_driver_target.h
+#endif
+#endif
+
+/* Object is scheduled, if it signals received messages and reports its timers */
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+#define CO_PROCESS_SCHEDULED(config)                                                                                   \
+    (((config) & (CO_CONFIG_FLAG_CALLBACK_PRE | CO_CONFIG_FLAG_TIMERNEXT))                                             \
+     == (CO_CONFIG_FLAG_CALLBACK_PRE | CO_CONFIG_FLAG_TIMERNEXT))
+#define CO_PROCESS_SCHEDULED_TIMER(config) (((config)&CO_CONFIG_FLAG_TIMERNEXT) != 0)
+#else
+#define CO_PROCESS_SCHEDULED(config)       0
+#define CO_PROCESS_SCHEDULED_TIMER(config) 0
+#endif
+
+/* Slots of the scheduled objects, NULL for objects processed on every call */
+#if CO_PROCESS_SCHEDULED_TIMER(CO_CONFIG_LEDS)
+#define CO_PROCESS_SLOT_LEDS (&co->processSlot[CO_PROCESS_LEDS])
+#else
+#define CO_PROCESS_SLOT_LEDS NULL
+#endif
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_EM)
+#define CO_PROCESS_SLOT_EM (&co->processSlot[CO_PROCESS_EM])
+#else
+#define CO_PROCESS_SLOT_EM NULL
+#endif
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_NMT)
+#define CO_PROCESS_SLOT_NMT (&co->processSlot[CO_PROCESS_NMT])
+#else
+#define CO_PROCESS_SLOT_NMT NULL
+#endif
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_SDO_SRV)
+#define CO_PROCESS_SLOT_SDO_SRV(i) (&co->SDOserverSlot[(i)])
+#else
+#define CO_PROCESS_SLOT_SDO_SRV(i) NULL
+#endif
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_HB_CONS)
+#define CO_PROCESS_SLOT_HB_CONS (&co->processSlot[CO_PROCESS_HB_CONS])
+#else
+#define CO_PROCESS_SLOT_HB_CONS NULL
+#endif
+
+/* One object's turn inside CO_process() */
+typedef struct {
+    uint32_t timeDifference_us; /* passed to the object */
+    uint32_t* timerNext_us;     /* passed to the object */
+    uint32_t timerNext;         /* own timerNext_us of a scheduled object */
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0
+    uint32_t start_us;
+#endif
+} CO_processRun_t;
+
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+/* Callback from the object: mark it ready and wake the task, which runs CO_process() */
+static void
+CO_process_signal(void* object) {
+    CO_processSlot_t* slot = (CO_processSlot_t*)object;
+    CO_t* co = (CO_t*)slot->co;
+
+    CO_MemoryBarrier();
+    slot->ready = 1U;
+    if (co->pFunctSignalProcess != NULL) {
+        co->pFunctSignalProcess(co->functSignalObjectProcess);
+    }
+}
+
+/* Object is processed on the next CO_process() call */
+static void
+CO_process_initSlot(CO_t* co, CO_processSlot_t* slot) {
+    slot->co = co;
+    slot->elapsed_us = 0;
+    slot->due_us = 0;
+    slot->ready = 1U;
+}
+
+void
+CO_process_initCallbackPre(CO_t* co, void* object, void (*pFunctSignal)(void* object)) {
+    if (co != NULL) {
+        co->functSignalObjectProcess = object;
+        co->pFunctSignalProcess = pFunctSignal;
+    }
+}
+#endif
+
+/*
+ * Decide, if the object in the slot is processed now and prepare run for it. Object without a slot is always
+ * processed with the caller's arguments. Scheduled object is processed, when it is ready, forced or its timer has
+ * expired. Otherwise time is accumulated and its remaining time is reported to the caller's timerNext_us.
+ */
+static inline bool_t
+CO_process_enter(CO_t* co, CO_processModule_t module, CO_processSlot_t* slot, bool_t force,
+                 uint32_t timeDifference_us, uint32_t* timerNext_us, CO_processRun_t* run) {
+    (void)co;     /* may be unused */
+    (void)module; /* may be unused */
+    (void)force;  /* may be unused */
+    run->timeDifference_us = timeDifference_us;
+    run->timerNext_us = timerNext_us;
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    if (slot != NULL) {
+        slot->elapsed_us = (slot->elapsed_us < (UINT32_MAX - timeDifference_us)) ? (slot->elapsed_us + timeDifference_us)
+                                                                               : UINT32_MAX;
+        if ((slot->ready == 0U) && !force && (slot->elapsed_us < slot->due_us)) {
+            if ((timerNext_us != NULL) && (*timerNext_us > (slot->due_us - slot->elapsed_us))) {
+                *timerNext_us = slot->due_us - slot->elapsed_us;
+            }
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0
+            co->processStats[module].skips++;
+#endif
+            return false;
+        }
+        /* clear before processing, so signal received meanwhile is not lost */
+        slot->ready = 0U;
+        CO_MemoryBarrier();
+        run->timeDifference_us = slot->elapsed_us;
+        run->timerNext = CO_CONFIG_PROCESS_IDLE_US;
+        run->timerNext_us = &run->timerNext;
+    }
+#else
+    (void)slot; /* may be unused */
+#endif
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0
+    run->start_us = (uint32_t)CO_PROCESS_TIME_US();
+#endif
+    return true;
+}
+
+/* Object was processed: count the time and set its next deadline from its timerNext_us */
+static inline void
+CO_process_leave(CO_t* co, CO_processModule_t module, CO_processSlot_t* slot, uint32_t* timerNext_us,
+                 CO_processRun_t* run) {
+    (void)co;           /* may be unused */
+    (void)module;       /* may be unused */
+    (void)timerNext_us; /* may be unused */
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0
+    CO_processStat_t* stat = &co->processStats[module];
+    uint32_t time_us = (uint32_t)CO_PROCESS_TIME_US() - run->start_us;
+    stat->calls++;
+    stat->time_us += time_us;
+    if (stat->timeMax_us < time_us) {
+        stat->timeMax_us = time_us;
+    }
+#endif
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    if (slot != NULL) {
+        slot->elapsed_us = 0;
+        slot->due_us = run->timerNext;
+        if ((timerNext_us != NULL) && (*timerNext_us > run->timerNext)) {
+            *timerNext_us = run->timerNext;
+        }
+    }
+#else
+    (void)slot; /* may be unused */
+    (void)run;  /* may be unused */
+#endif
+}
+
 CO_ReturnError_t
 CO_CANinit(CO_t* co, void* CANptr, uint16_t bitRate) {
     CO_ReturnError_t err;
@@ -981,6 +1179,10 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
     if (em == NULL) {
         em = co->em;
     }
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    co->processNMTstate = CO_NMT_INITIALIZING;
+    co->processCANerrorStatus = co->CANmodule->CANerrorStatus;
+#endif
 
     /* Verify CANopen Node-ID */
     co->nodeIdUnconfigured = false;
@@ -1000,6 +1202,9 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
         if (err != CO_ERROR_NO) {
             return err;
         }
+#if CO_PROCESS_SCHEDULED_TIMER(CO_CONFIG_LEDS)
+        CO_process_initSlot(co, &co->processSlot[CO_PROCESS_LEDS]);
+#endif
     }
 #endif
 
@@ -1033,6 +1238,10 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
         if (err != CO_ERROR_NO) {
             return err;
         }
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_EM)
+        CO_process_initSlot(co, &co->processSlot[CO_PROCESS_EM]);
+        CO_EM_initCallbackPre(co->em, &co->processSlot[CO_PROCESS_EM], CO_process_signal);
+#endif
     }
 
     /* NMT_Heartbeat */
@@ -1046,6 +1255,10 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
         if (err != CO_ERROR_NO) {
             return err;
         }
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_NMT)
+        CO_process_initSlot(co, &co->processSlot[CO_PROCESS_NMT]);
+        CO_NMT_initCallbackPre(co->NMT, &co->processSlot[CO_PROCESS_NMT], CO_process_signal);
+#endif
     }
 
 #if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
@@ -1056,6 +1269,10 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
         if (err != CO_ERROR_NO) {
             return err;
         }
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_HB_CONS)
+        CO_process_initSlot(co, &co->processSlot[CO_PROCESS_HB_CONS]);
+        CO_HBconsumer_initCallbackPre(co->HBcons, &co->processSlot[CO_PROCESS_HB_CONS], CO_process_signal);
+#endif
     }
 #endif
 
@@ -1086,6 +1303,10 @@ CO_CANopenInit(CO_t* co, CO_NMT_t* NMT, CO_EM_t* em, OD_t* od, OD_entry_t* OD_st
             if (err != CO_ERROR_NO) {
                 return err;
             }
+#if CO_PROCESS_SCHEDULED(CO_CONFIG_SDO_SRV)
+            CO_process_initSlot(co, &co->SDOserverSlot[i]);
+            CO_SDOserver_initCallbackPre(&co->SDOserver[i], &co->SDOserverSlot[i], CO_process_signal);
+#endif
             SDOsrvPar++;
         }
     }
@@ -1313,15 +1534,30 @@ CO_process(CO_t* co, bool_t enableGateway, uint32_t timeDifference_us, uint32_t*
     CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
     CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(co->NMT);
     bool_t NMTisPreOrOperational = ((NMTstate == CO_NMT_PRE_OPERATIONAL) || (NMTstate == CO_NMT_OPERATIONAL));
+    CO_processRun_t run;
+    bool_t CANerrorChanged = false;
+    bool_t NMTchanged = false;
+    bool_t EMprocessed = false;
 
     /* CAN module */
-    CO_CANmodule_process(co->CANmodule);
+    if (CO_process_enter(co, CO_PROCESS_CAN, NULL, true, timeDifference_us, timerNext_us, &run)) {
+        CO_CANmodule_process(co->CANmodule);
+        CO_process_leave(co, CO_PROCESS_CAN, NULL, timerNext_us, &run);
+    }
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    if (co->processCANerrorStatus != co->CANmodule->CANerrorStatus) {
+        co->processCANerrorStatus = co->CANmodule->CANerrorStatus;
+        CANerrorChanged = true;
+    }
+#endif
 
 #if ((CO_CONFIG_LSS)&CO_CONFIG_LSS_SLAVE)
-    if (CO_GET_CNT(LSS_SLV) == 1U) {
+    if ((CO_GET_CNT(LSS_SLV) == 1U)
+        && CO_process_enter(co, CO_PROCESS_LSS_SLV, NULL, true, timeDifference_us, timerNext_us, &run)) {
         if (CO_LSSslave_process(co->LSSslave)) {
             reset = CO_RESET_COMM;
         }
+        CO_process_leave(co, CO_PROCESS_LSS_SLV, NULL, timerNext_us, &run);
     }
 #endif
 
@@ -1341,15 +1577,19 @@ CO_process(CO_t* co, bool_t enableGateway, uint32_t timeDifference_us, uint32_t*
 #define CO_STATUS_FIRMWARE_DOWNLOAD_IN_PROGRESS false
 #endif
 
-    if (CO_GET_CNT(LEDS) == 1U) {
+    /* LEDs blink on their own timer, which also picks up changed inputs */
+    if ((CO_GET_CNT(LEDS) == 1U)
+        && CO_process_enter(co, CO_PROCESS_LEDS, CO_PROCESS_SLOT_LEDS,
+                            CANerrorChanged, timeDifference_us, timerNext_us, &run)) {
         bool_t ErrSync = CO_isError(co->em, CO_EM_SYNC_TIME_OUT);
         bool_t ErrHbCons = CO_isError(co->em, CO_EM_HEARTBEAT_CONSUMER);
         bool_t ErrHbConsRemote = CO_isError(co->em, CO_EM_HB_CONSUMER_REMOTE_RESET);
-        CO_LEDs_process(co->LEDs, timeDifference_us, unc ? CO_NMT_INITIALIZING : NMTstate, LSSslave_configuration,
+        CO_LEDs_process(co->LEDs, run.timeDifference_us, unc ? CO_NMT_INITIALIZING : NMTstate, LSSslave_configuration,
                         (CANerrorStatus & CO_CAN_ERRTX_BUS_OFF) != 0U, (CANerrorStatus & CO_CAN_ERR_WARN_PASSIVE) != 0U,
                         false, /* RPDO event timer timeout */
                         unc ? false : ErrSync, unc ? false : (ErrHbCons || ErrHbConsRemote),
-                        CO_getErrorRegister(co->em) != 0U, CO_STATUS_FIRMWARE_DOWNLOAD_IN_PROGRESS, timerNext_us);
+                        CO_getErrorRegister(co->em) != 0U, CO_STATUS_FIRMWARE_DOWNLOAD_IN_PROGRESS, run.timerNext_us);
+        CO_process_leave(co, CO_PROCESS_LEDS, CO_PROCESS_SLOT_LEDS, timerNext_us, &run);
     }
 #endif
 
@@ -1358,48 +1598,87 @@ CO_process(CO_t* co, bool_t enableGateway, uint32_t timeDifference_us, uint32_t*
         return reset;
     }
 
-    /* Emergency */
-    if (CO_GET_CNT(EM) == 1U) {
-        CO_EM_process(co->em, NMTisPreOrOperational, timeDifference_us, timerNext_us);
+    /* Emergency, also when CAN error status changed */
+    if ((CO_GET_CNT(EM) == 1U)
+        && CO_process_enter(co, CO_PROCESS_EM, CO_PROCESS_SLOT_EM,
+                            CANerrorChanged, timeDifference_us, timerNext_us, &run)) {
+        CO_EM_process(co->em, NMTisPreOrOperational, run.timeDifference_us, run.timerNext_us);
+        CO_process_leave(co, CO_PROCESS_EM, CO_PROCESS_SLOT_EM, timerNext_us, &run);
+        EMprocessed = true;
     }
 
-    /* NMT_Heartbeat */
-    if (CO_GET_CNT(NMT) == 1U) {
-        reset = CO_NMT_process(co->NMT, &NMTstate, timeDifference_us, timerNext_us);
+    /* NMT_Heartbeat, also after error register may have changed or with internal command pending */
+    bool_t NMTforce = EMprocessed || (co->NMT->internalCommand != CO_NMT_NO_COMMAND);
+    if ((CO_GET_CNT(NMT) == 1U)
+        && CO_process_enter(co, CO_PROCESS_NMT, CO_PROCESS_SLOT_NMT, NMTforce, timeDifference_us, timerNext_us, &run)) {
+        reset = CO_NMT_process(co->NMT, &NMTstate, run.timeDifference_us, run.timerNext_us);
+        CO_process_leave(co, CO_PROCESS_NMT, CO_PROCESS_SLOT_NMT, timerNext_us, &run);
     }
     NMTisPreOrOperational = ((NMTstate == CO_NMT_PRE_OPERATIONAL) || (NMTstate == CO_NMT_OPERATIONAL));
+#if ((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0
+    if (co->processNMTstate != NMTstate) {
+        co->processNMTstate = NMTstate;
+        NMTchanged = true;
+        /* objects before NMT see the new state on the next call */
+        co->processSlot[CO_PROCESS_LEDS].ready = 1U;
+        co->processSlot[CO_PROCESS_EM].ready = 1U;
+    }
+#endif
 
     /* SDOserver */
     for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
-        (void)CO_SDOserver_process(&co->SDOserver[i], NMTisPreOrOperational, timeDifference_us, timerNext_us);
+        if (CO_process_enter(co, CO_PROCESS_SDO_SRV, CO_PROCESS_SLOT_SDO_SRV(i),
+                             NMTchanged, timeDifference_us, timerNext_us, &run)) {
+            CO_SDO_return_t SDOret = CO_SDOserver_process(&co->SDOserver[i], NMTisPreOrOperational,
+                                                          run.timeDifference_us, run.timerNext_us);
+            if (SDOret == CO_SDO_RT_transmittBufferFull) {
+                run.timerNext = 0; /* retry on the next call */
+            }
+            CO_process_leave(co, CO_PROCESS_SDO_SRV, CO_PROCESS_SLOT_SDO_SRV(i), timerNext_us, &run);
+        }
     }
 
 #if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
-    if (CO_GET_CNT(HB_CONS) == 1U) {
-        CO_HBconsumer_process(co->HBcons, NMTisPreOrOperational, timeDifference_us, timerNext_us);
+    if ((CO_GET_CNT(HB_CONS) == 1U)
+        && CO_process_enter(co, CO_PROCESS_HB_CONS, CO_PROCESS_SLOT_HB_CONS,
+                            NMTchanged, timeDifference_us, timerNext_us, &run)) {
+        CO_HBconsumer_process(co->HBcons, NMTisPreOrOperational, run.timeDifference_us, run.timerNext_us);
+        CO_process_leave(co, CO_PROCESS_HB_CONS, CO_PROCESS_SLOT_HB_CONS, timerNext_us, &run);
     }
 #endif
 
+#if ((CO_CONFIG_NODE_GUARDING) & (CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE | CO_CONFIG_NODE_GUARDING_MASTER_ENABLE)) != 0
+    if (CO_process_enter(co, CO_PROCESS_NG, NULL, true, timeDifference_us, timerNext_us, &run)) {
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE) != 0
-    CO_nodeGuardingSlave_process(co->NGslave, NMTstate, (co->NMT->HBproducerTime_us > 0U), timeDifference_us,
-                                 timerNext_us);
+        CO_nodeGuardingSlave_process(co->NGslave, NMTstate, (co->NMT->HBproducerTime_us > 0U), timeDifference_us,
+                                     timerNext_us);
 #endif
 #if ((CO_CONFIG_NODE_GUARDING)&CO_CONFIG_NODE_GUARDING_MASTER_ENABLE) != 0
-    CO_nodeGuardingMaster_process(co->NGmaster, timeDifference_us, timerNext_us);
+        CO_nodeGuardingMaster_process(co->NGmaster, timeDifference_us, timerNext_us);
+#endif
+        CO_process_leave(co, CO_PROCESS_NG, NULL, timerNext_us, &run);
+    }
 #endif
 
 #if ((CO_CONFIG_TIME)&CO_CONFIG_TIME_ENABLE) != 0
-    if (CO_GET_CNT(TIME) == 1U) {
+    if ((CO_GET_CNT(TIME) == 1U)
+        && CO_process_enter(co, CO_PROCESS_TIME, NULL, true, timeDifference_us, timerNext_us, &run)) {
         (void)CO_TIME_process(co->TIME, NMTisPreOrOperational, timeDifference_us);
+        CO_process_leave(co, CO_PROCESS_TIME, NULL, timerNext_us, &run);
     }
 #endif
 
 #if ((CO_CONFIG_GTW)&CO_CONFIG_GTW_ASCII) != 0
-    if (CO_GET_CNT(GTWA) == 1U) {
+    if ((CO_GET_CNT(GTWA) == 1U)
+        && CO_process_enter(co, CO_PROCESS_GTWA, NULL, true, timeDifference_us, timerNext_us, &run)) {
         CO_GTWA_process(co->gtwa, enableGateway, timeDifference_us, timerNext_us);
+        CO_process_leave(co, CO_PROCESS_GTWA, NULL, timerNext_us, &run);
     }
 #endif
 
+    (void)CANerrorChanged; /* may be unused */
+    (void)NMTchanged;      /* may be unused */
+    (void)EMprocessed;     /* may be unused */
     return reset;
 }
 
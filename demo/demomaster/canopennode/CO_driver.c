@@ -24,6 +24,7 @@
 
 #include "301/CO_driver.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "driver/twai.h"
 #include "driver/gpio.h"
 
@@ -38,6 +39,11 @@
 #define CAN_TX_GPIO     ((gpio_num_t)CONFIG_DEMO_MASTER_TWAI_TX_GPIO)
 #define CAN_RX_GPIO     ((gpio_num_t)CONFIG_DEMO_MASTER_TWAI_RX_GPIO)
 
+// Bulk frame limiter, see CO_CANbulk_t.
+#define CO_CAN_LOAD_WINDOW_US   100000  // bus-load sample period
+#define CO_CAN_BULK_BURST       4U      // frames the bucket can save up
+#define CO_CAN_BULK_FLOOR_DIV   10U     // bulk keeps a tenth of the ceiling however busy the bus is
+
 static const char* TAG = "CO_DRIVER";
 static bool driver_is_installed = false;
 
@@ -90,6 +96,13 @@ CO_CANmodule_init(CO_CANmodule_t* CANmodule, void* CANptr, CO_CANrx_t rxArray[],
     CANmodule->firstCANtxMessage = true;
     CANmodule->CANtxCount = 0U;
     CANmodule->errOld = 0U;
+    if (CANmodule->txLock == NULL) {
+        /* Kept across communication resets; CO_CANsend() may be called from another task. */
+        CANmodule->txLock = xSemaphoreCreateMutexStatic(&CANmodule->txLockBuffer);
+    }
+    memset(&CANmodule->bulk, 0, sizeof(CANmodule->bulk));
+    CANmodule->bulk.bitRate =
+        (CANbitRate == 125U || CANbitRate == 250U || CANbitRate == 1000U) ? CANbitRate * 1000U : 500000U;
 
     for (i = 0U; i < rxSize; i++) {
         rxArray[i].ident = 0U;
@@ -204,9 +217,9 @@ CO_CANtxBufferInit(CO_CANmodule_t* CANmodule, uint16_t index, uint16_t ident, bo
         /* get specific buffer */
         buffer = &CANmodule->txArray[index];
 
-        /* CAN identifier, DLC and rtr, bit aligned with CAN module transmit buffer, microcontroller specific. */
-        buffer->ident = ((uint32_t)ident & 0x07FFU) | ((uint32_t)(((uint32_t)noOfBytes & 0xFU) << 11U))
-                        | ((uint32_t)(rtr ? 0x8000U : 0U));
+        /* CAN identifier with the rtr flag as CO_CANtransmit() reads it, DLC separate. */
+        buffer->ident = ((uint32_t)ident & 0x07FFU) | ((uint32_t)(rtr ? 0x0800U : 0U));
+        buffer->DLC = (uint8_t)(noOfBytes & 0xFU);
 
         buffer->bufferFull = false;
         buffer->syncFlag = syncFlag;
@@ -215,10 +228,110 @@ CO_CANtxBufferInit(CO_CANmodule_t* CANmodule, uint16_t index, uint16_t ident, bo
     return buffer;
 }
 
+void
+CO_CANsetBulkLimit(CO_CANmodule_t* CANmodule, uint16_t identMin, uint16_t identMax, uint8_t loadPercent) {
+    CO_CANbulk_t* bulk = &CANmodule->bulk;
+    CO_LOCK_CAN_SEND(CANmodule);
+    bulk->identMin = identMin;
+    bulk->identMax = identMax;
+    bulk->loadPercent = loadPercent > 100U ? 100U : loadPercent;
+    bulk->tokens = (int64_t)CO_CAN_BULK_BURST * CO_CAN_FRAME_BITS(8U);
+    bulk->refillUs = esp_timer_get_time();
+    CO_UNLOCK_CAN_SEND(CANmodule);
+}
+
+uint32_t
+CO_CANbulkBitsPerSecond(const CO_CANmodule_t* CANmodule) {
+    const CO_CANbulk_t* bulk = &CANmodule->bulk;
+    if (bulk->loadPercent == 0U) {
+        return 0U;
+    }
+    uint32_t floor = bulk->loadPercent / CO_CAN_BULK_FLOOR_DIV;
+    if (floor == 0U) {
+        floor = 1U;
+    }
+    uint32_t others = bulk->othersPercent;
+    uint32_t percent = others + floor < bulk->loadPercent ? bulk->loadPercent - others : floor;
+    return bulk->bitRate / 100U * percent;
+}
+
+static bool_t
+CO_CANbulkFrame(const CO_CANmodule_t* CANmodule, const CO_CANtx_t* buffer) {
+    uint16_t ident = (uint16_t)(buffer->ident & 0x07FFU);
+    return CANmodule->bulk.loadPercent != 0U && ident >= CANmodule->bulk.identMin
+           && ident <= CANmodule->bulk.identMax;
+}
+
+/* Refill the bucket for the time since the last call and take frameBits from it if they are there. */
+static bool_t
+CO_CANbulkTake(CO_CANmodule_t* CANmodule, uint32_t frameBits) {
+    CO_CANbulk_t* bulk = &CANmodule->bulk;
+    int64_t now = esp_timer_get_time();
+    int64_t burst = (int64_t)CO_CAN_BULK_BURST * CO_CAN_FRAME_BITS(8U);
+
+    bulk->tokens += (now - bulk->refillUs) * (int64_t)CO_CANbulkBitsPerSecond(CANmodule) / 1000000;
+    bulk->refillUs = now;
+    if (bulk->tokens > burst) {
+        bulk->tokens = burst;
+    }
+    if (bulk->tokens < (int64_t)frameBits) {
+        return false;
+    }
+    bulk->tokens -= frameBits;
+    return true;
+}
+
+/* Add received bits to the load sample and close it once the window is over. */
+static void
+CO_CANloadSample(CO_CANmodule_t* CANmodule, uint32_t bits) {
+    CO_CANbulk_t* bulk = &CANmodule->bulk;
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed = now - bulk->windowUs;
+
+    bulk->windowBits += bits;
+    if (elapsed < CO_CAN_LOAD_WINDOW_US) {
+        return;
+    }
+    uint64_t percent = (uint64_t)bulk->windowBits * 100U * 1000000U / ((uint64_t)bulk->bitRate * (uint64_t)elapsed);
+    if (percent > 100U) {
+        percent = 100U;
+    }
+    /* Back off at once when the others get busier, give bandwidth back over a few windows. */
+    bulk->othersPercent = percent >= bulk->othersPercent ? (uint8_t)percent
+                                                         : (uint8_t)((bulk->othersPercent * 3U + percent) / 4U);
+    bulk->windowBits = 0U;
+    bulk->windowUs = now;
+}
+
+/* Hand one buffer to the TWAI driver without waiting; false when its TX queue is full. */
+static bool_t
+CO_CANtransmit(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer) {
+    twai_message_t msg;
+    msg.identifier = buffer->ident & 0x07FFU;
+    msg.data_length_code = buffer->DLC;
+    msg.extd = 0;
+    msg.rtr = (buffer->ident & 0x0800U) ? 1 : 0;
+    msg.ss = 0;
+    msg.self = 0;
+    msg.dlc_non_comp = 0;
+
+    for (int i = 0; i < 8; i++) {
+        msg.data[i] = buffer->data[i];
+    }
+
+    if (twai_transmit(&msg, 0) != ESP_OK) {
+        return false;
+    }
+    CANmodule->bufferInhibitFlag = buffer->syncFlag;
+    CANmodule->firstCANtxMessage = false;
+    return true;
+}
+
 CO_ReturnError_t
 CO_CANsend(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer) {
     CO_ReturnError_t err = CO_ERROR_NO;
 
+    CO_LOCK_CAN_SEND(CANmodule);
     /* Verify overflow */
     if (buffer->bufferFull) {
         if (!CANmodule->firstCANtxMessage) {
@@ -228,44 +341,56 @@ CO_CANsend(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer) {
         err = CO_ERROR_TX_OVERFLOW;
     }
 
-    CO_LOCK_CAN_SEND(CANmodule);
-    /* if CAN TX buffer is free, copy message to it */
-    if (1 && CANmodule->CANtxCount == 0) {
-        CANmodule->bufferInhibitFlag = buffer->syncFlag;
-        /* copy message and txRequest */
-        // Construir mensaje TWAI
-        twai_message_t msg;
-        msg.identifier = buffer->ident & 0x07FFU;
-        msg.data_length_code = buffer->DLC;
-        msg.extd = 0; 
-        msg.rtr = (buffer->ident & 0x0800U) ? 1 : 0;
-        msg.ss = 0; 
-        msg.self = 0; 
-        msg.dlc_non_comp = 0;
-
-        for(int i=0; i<8; i++) msg.data[i] = buffer->data[i];
-
-        // Enviar sin bloqueo (0 ticks de espera)
-        if (twai_transmit(&msg, 0) == ESP_OK) {
-            CANmodule->bufferInhibitFlag = buffer->syncFlag;
-            CANmodule->firstCANtxMessage = false;
-        } else {
-            // Si falla, marcar error
+    /* Bulk frames keep their order behind anything already waiting and need tokens; other frames
+     * never wait behind held-back bulk frames. */
+    bool_t sendNow = true;
+    if (CO_CANbulkFrame(CANmodule, buffer)) {
+        sendNow = CANmodule->CANtxCount == 0U && CO_CANbulkTake(CANmodule, CO_CAN_FRAME_BITS(buffer->DLC));
+        if (!sendNow) {
+            CANmodule->bulk.framesHeld++;
+        }
+    }
+    if (sendNow && CO_CANtransmit(CANmodule, buffer)) {
+        if (buffer->bufferFull) {
+            buffer->bufferFull = false;
+            CANmodule->CANtxCount--;
+        }
+    } else {
+        if (sendNow) {
+            err = CO_ERROR_TX_OVERFLOW;
+        }
+        /* message will be sent from CO_CANmodule_process() */
+        if (!buffer->bufferFull) {
             buffer->bufferFull = true;
             CANmodule->CANtxCount++;
-            err = CO_ERROR_TX_OVERFLOW; 
-    }
-    }
-    /* if no buffer is free, message will be sent by interrupt */
-    else {
-        buffer->bufferFull = true;
-        CANmodule->CANtxCount++;
+        }
     }
     CO_UNLOCK_CAN_SEND(CANmodule);
 
     return err;
 }
 
+/* Send what CO_CANsend() had to leave in the buffers, in buffer order. */
+static void
+CO_CANtxPending(CO_CANmodule_t* CANmodule) {
+    CO_LOCK_CAN_SEND(CANmodule);
+    CO_CANtx_t* buffer = &CANmodule->txArray[0];
+    for (uint16_t i = CANmodule->txSize; i > 0U && CANmodule->CANtxCount != 0U; i--, buffer++) {
+        if (!buffer->bufferFull) {
+            continue;
+        }
+        if (CO_CANbulkFrame(CANmodule, buffer) && !CO_CANbulkTake(CANmodule, CO_CAN_FRAME_BITS(buffer->DLC))) {
+            continue;
+        }
+        if (!CO_CANtransmit(CANmodule, buffer)) {
+            break;
+        }
+        buffer->bufferFull = false;
+        CANmodule->CANtxCount--;
+    }
+    CO_UNLOCK_CAN_SEND(CANmodule);
+}
+
 void
 CO_CANclearPendingSyncPDOs(CO_CANmodule_t* CANmodule) {
     uint32_t tpdoDeleted = 0U;
@@ -307,6 +432,10 @@ void
 CO_CANmodule_process(CO_CANmodule_t* CANmodule) {
     uint32_t err;
 
+    if (CANmodule->CANtxCount != 0U) {
+        CO_CANtxPending(CANmodule);
+    }
+
     err = ((uint32_t)txErrors << 16) | ((uint32_t)rxErrors << 8) | overflow;
 
     if (CANmodule->errOld != err) {
@@ -371,10 +500,13 @@ void CO_CANinterrupt(CO_CANmodule_t* CANmodule) {
     }
     // Block briefly waiting for at least one frame, then drain the rest without waiting.
     if (twai_receive(&msg, waitTicks) != ESP_OK) {
+        CO_CANloadSample(CANmodule, 0U);
         return;
     }
 
     do {
+        CO_CANloadSample(CANmodule, CO_CAN_FRAME_BITS(msg.data_length_code));
+
         CO_CANrxMsg_t rcvMsg;
         rcvMsg.ident = msg.identifier;
         rcvMsg.DLC = msg.data_length_code;
@@ -1,10 +1,9 @@
 /*******************************************************************************
     CANopen Object Dictionary definition for CANopenNode V4
 
-    This file was automatically generated by CANopenEditor v4.1-1-ga49a51a
+    This file was automatically generated by eds2od.py from demo_master.eds
 
     https://github.com/CANopenNode/CANopenNode
-    https://github.com/CANopenNode/CANopenEditor
 
     DON'T EDIT THIS FILE MANUALLY, UNLESS YOU KNOW WHAT YOU ARE DOING !!!!
 *******************************************************************************/
@@ -27,50 +26,45 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
     .x1007_synchronousWindowLength = 0x00000000,
     .x1012_COB_IDTimeStampObject = 0x00000100,
     .x1014_COB_ID_EMCY = 0x00000080,
-    .x1015_inhibitTimeEMCY = 0x0000,
-    .x1016_consumerHeartbeatTime_sub0 = 0x08,
     .x1016_consumerHeartbeatTime = {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
-    .x1017_producerHeartbeatTime = 0x0000,
     .x1018_identity = {
-        .highestSub_indexSupported = 0x04,
         .vendor_ID = 0x00000000,
         .productCode = 0x00000000,
         .revisionNumber = 0x00000000,
-        .serialNumber = 0x00000000
+        .serialNumber = 0x00000000,
+        .highestSub_indexSupported = 0x04
     },
-    .x1019_synchronousCounterOverflowValue = 0x00,
     .x1280_SDOClientParameter = {
-        .highestSub_indexSupported = 0x03,
         .COB_IDClientToServerTx = 0x80000000,
         .COB_IDServerToClientRx = 0x80000000,
+        .highestSub_indexSupported = 0x03,
         .node_IDOfTheSDOServer = 0x01
     },
     .x1400_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000200,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1401_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000300,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1402_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000400,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1403_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000500,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1600_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -78,10 +72,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1601_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -89,10 +83,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1602_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -100,10 +94,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1603_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -111,42 +105,42 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1800_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000180,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1801_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000280,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1802_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000380,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1803_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000480,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1A00_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -154,10 +148,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A01_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -165,10 +159,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A02_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -176,10 +170,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A03_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -187,20 +181,45 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
-    }
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
+    },
+    .x1015_inhibitTimeEMCY = 0x0000,
+    .x1017_producerHeartbeatTime = 0x0000,
+    .x1016_consumerHeartbeatTime_sub0 = 0x08,
+    .x1019_synchronousCounterOverflowValue = 0x00
 };
 
 OD_ATTR_RAM OD_RAM_t OD_RAM = {
-    .x1001_errorRegister = 0x00,
-    .x1010_storeParameters_sub0 = 0x04,
     .x1010_storeParameters = {0x00000001, 0x00000001, 0x00000001, 0x00000001},
-    .x1011_restoreDefaultParameters_sub0 = 0x04,
     .x1011_restoreDefaultParameters = {0x00000001, 0x00000001, 0x00000001, 0x00000001},
     .x1200_SDOServerParameter = {
-        .highestSub_indexSupported = 0x02,
         .COB_IDClientToServerRx = 0x00000600,
-        .COB_IDServerToClientTx = 0x00000580
+        .COB_IDServerToClientTx = 0x00000580,
+        .highestSub_indexSupported = 0x02
+    },
+    .x2110_fwTransferStats = {
+        .imageBytes = 0x00000000,
+        .bytesSent = 0x00000000,
+        .bytesPerSecond = 0x00000000,
+        .etaMs = 0x00000000,
+        .sdoAborts = 0x00000000,
+        .retries = 0x00000000,
+        .preflightMs = 0x00000000,
+        .metadataMs = 0x00000000,
+        .startMs = 0x00000000,
+        .dataMs = 0x00000000,
+        .finalizeMs = 0x00000000,
+        .phase = 0x00
+    },
+    .x1001_errorRegister = 0x00,
+    .x1010_storeParameters_sub0 = 0x04,
+    .x1011_restoreDefaultParameters_sub0 = 0x04
+};
+
+OD_ATTR_ROM CO_PROGMEM OD_ROM_t OD_ROM = {
+    .x2110_fwTransferStats = {
+        .highestSub_indexSupported = 0x0C
     }
 };
 
@@ -243,6 +262,7 @@ typedef struct {
     OD_obj_record_t o_1A01_TPDOMappingParameter[9];
     OD_obj_record_t o_1A02_TPDOMappingParameter[9];
     OD_obj_record_t o_1A03_TPDOMappingParameter[9];
+    OD_obj_record_t o_2110_fwTransferStats[13];
 } ODObjs_t;
 
 static CO_PROGMEM ODObjs_t ODObjs = {
@@ -1109,6 +1129,86 @@ static CO_PROGMEM ODObjs_t ODObjs = {
             .attribute = ODA_SDO_RW | ODA_MB,
             .dataLength = 4
         }
+    },
+    .o_2110_fwTransferStats = {
+        {
+            .dataOrig = (void *)&OD_ROM.x2110_fwTransferStats.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.phase,
+            .subIndex = 1,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.imageBytes,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.bytesSent,
+            .subIndex = 3,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.bytesPerSecond,
+            .subIndex = 4,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.etaMs,
+            .subIndex = 5,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.sdoAborts,
+            .subIndex = 6,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.retries,
+            .subIndex = 7,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.preflightMs,
+            .subIndex = 8,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.metadataMs,
+            .subIndex = 9,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.startMs,
+            .subIndex = 10,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.dataMs,
+            .subIndex = 11,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2110_fwTransferStats.finalizeMs,
+            .subIndex = 12,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        }
     }
 };
 
@@ -1150,12 +1250,28 @@ static OD_ATTR_OD OD_entry_t ODList[] = {
     {0x1A01, 0x09, ODT_REC, &ODObjs.o_1A01_TPDOMappingParameter, NULL},
     {0x1A02, 0x09, ODT_REC, &ODObjs.o_1A02_TPDOMappingParameter, NULL},
     {0x1A03, 0x09, ODT_REC, &ODObjs.o_1A03_TPDOMappingParameter, NULL},
+    {0x2110, 0x0D, ODT_REC, &ODObjs.o_2110_fwTransferStats, NULL},
     {0x0000, 0x00, 0, NULL, NULL}
 };
 
+/* Perfect hash of the indexes in ODList, see OD_hash_t. */
+static const uint16_t ODHashSlots[128] = {
+    25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 34, 0, 0, 0,
+    0, 0, 0, 0, 26, 27, 28, 29, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 30, 31, 32, 33, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 0, 4, 5, 6,
+    0, 0, 0, 0, 0, 0, 0, 0, 7, 8, 9, 0, 10, 11, 12, 16,
+    13, 14, 15, 0, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 18, 19, 20, 21, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22, 23, 24
+};
+
+static const OD_hash_t ODHash = {0x0217, 9, &ODHashSlots[0]};
+
 static OD_t _OD = {
     (sizeof(ODList) / sizeof(ODList[0])) - 1,
-    &ODList[0]
+    &ODList[0],
+    &ODHash
 };
 
 OD_t *OD = &_OD;
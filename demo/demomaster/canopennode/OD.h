@@ -1,28 +1,27 @@
 /*******************************************************************************
     CANopen Object Dictionary definition for CANopenNode V4
 
-    This file was automatically generated by CANopenEditor v4.1-1-ga49a51a
+    This file was automatically generated by eds2od.py from demo_master.eds
 
     https://github.com/CANopenNode/CANopenNode
-    https://github.com/CANopenNode/CANopenEditor
 
     DON'T EDIT THIS FILE MANUALLY !!!!
 ********************************************************************************
 
     File info:
         File Names:   OD.h; OD.c
-        Project File: DS301_profile.xpd
+        Project File: demo_master.eds
         File Version: 1
 
-        Created:      23. 11. 2020 12:00:00
+        Created:      11-23-2020 12:00PM
         Created By:   
-        Modified:     17. 03. 2023 02:07:28
+        Modified:     10-18-2026 9:00AM
         Modified By:  
 
     Device Info:
         Vendor Name:  
         Vendor ID:    
-        Product Name: New Product
+        Product Name: OTA demo master
         Product ID:   
 
         Description:  
@@ -67,50 +66,45 @@ typedef struct {
     uint32_t x1007_synchronousWindowLength;
     uint32_t x1012_COB_IDTimeStampObject;
     uint32_t x1014_COB_ID_EMCY;
-    uint16_t x1015_inhibitTimeEMCY;
-    uint8_t x1016_consumerHeartbeatTime_sub0;
     uint32_t x1016_consumerHeartbeatTime[OD_CNT_ARR_1016];
-    uint16_t x1017_producerHeartbeatTime;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t vendor_ID;
         uint32_t productCode;
         uint32_t revisionNumber;
         uint32_t serialNumber;
+        uint8_t highestSub_indexSupported;
     } x1018_identity;
-    uint8_t x1019_synchronousCounterOverflowValue;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDClientToServerTx;
         uint32_t COB_IDServerToClientRx;
+        uint8_t highestSub_indexSupported;
         uint8_t node_IDOfTheSDOServer;
     } x1280_SDOClientParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1400_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1401_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1402_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1403_RPDOCommunicationParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -119,9 +113,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1600_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -130,9 +124,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1601_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -141,9 +135,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1602_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -152,41 +146,41 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1603_RPDOMappingParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1800_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1801_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1802_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1803_TPDOCommunicationParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -195,9 +189,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A00_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -206,9 +200,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A01_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -217,9 +211,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A02_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -228,22 +222,47 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A03_TPDOMappingParameter;
+    uint16_t x1015_inhibitTimeEMCY;
+    uint16_t x1017_producerHeartbeatTime;
+    uint8_t x1016_consumerHeartbeatTime_sub0;
+    uint8_t x1019_synchronousCounterOverflowValue;
 } OD_PERSIST_COMM_t;
 
 typedef struct {
-    uint8_t x1001_errorRegister;
-    uint8_t x1010_storeParameters_sub0;
     uint32_t x1010_storeParameters[OD_CNT_ARR_1010];
-    uint8_t x1011_restoreDefaultParameters_sub0;
     uint32_t x1011_restoreDefaultParameters[OD_CNT_ARR_1011];
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDClientToServerRx;
         uint32_t COB_IDServerToClientTx;
+        uint8_t highestSub_indexSupported;
     } x1200_SDOServerParameter;
+    struct {
+        uint32_t imageBytes;
+        uint32_t bytesSent;
+        uint32_t bytesPerSecond;
+        uint32_t etaMs;
+        uint32_t sdoAborts;
+        uint32_t retries;
+        uint32_t preflightMs;
+        uint32_t metadataMs;
+        uint32_t startMs;
+        uint32_t dataMs;
+        uint32_t finalizeMs;
+        uint8_t phase;
+    } x2110_fwTransferStats;
+    uint8_t x1001_errorRegister;
+    uint8_t x1010_storeParameters_sub0;
+    uint8_t x1011_restoreDefaultParameters_sub0;
 } OD_RAM_t;
 
+typedef struct {
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x2110_fwTransferStats;
+} OD_ROM_t;
+
 #ifndef OD_ATTR_PERSIST_COMM
 #define OD_ATTR_PERSIST_COMM
 #endif
@@ -254,6 +273,11 @@ extern OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM;
 #endif
 extern OD_ATTR_RAM OD_RAM_t OD_RAM;
 
+#ifndef OD_ATTR_ROM
+#define OD_ATTR_ROM
+#endif
+extern OD_ATTR_ROM CO_PROGMEM OD_ROM_t OD_ROM;
+
 #ifndef OD_ATTR_OD
 #define OD_ATTR_OD
 #endif
@@ -296,6 +320,7 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1A01 &OD->list[30]
 #define OD_ENTRY_H1A02 &OD->list[31]
 #define OD_ENTRY_H1A03 &OD->list[32]
+#define OD_ENTRY_H2110 &OD->list[33]
 
 
 /*******************************************************************************
@@ -334,6 +359,7 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1A01_TPDOMappingParameter &OD->list[30]
 #define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[31]
 #define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[32]
+#define OD_ENTRY_H2110_fwTransferStats &OD->list[33]
 
 
 /*******************************************************************************
@@ -1,5 +1,6 @@
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -17,6 +18,9 @@
 #include "esp_spiffs.h"
 #endif
 
+#include "fw_image_catalog.h"
+#include "fw_readback.h"
+#include "fw_sdo_queue.h"
 #include "master_uploader_demo.h"
 
 static const char* LOG_TAG = "demo_master";
@@ -30,6 +34,10 @@ extern void CO_CANinterrupt(CO_CANmodule_t* CANmodule);
 #define SDO_SRV_TIMEOUT_TIME 1000U
 #define SDO_CLI_TIMEOUT_TIME 1000U
 
+#ifndef CONFIG_DEMO_MASTER_BUS_LOAD_PERCENT
+#define CONFIG_DEMO_MASTER_BUS_LOAD_PERCENT 60
+#endif
+
 typedef struct {
     CO_t* co;
     CO_SDOclient_t* sdoClient;
@@ -44,6 +52,7 @@ static bool canopen_master_init(void);
 static void canopen_process_task(void* arg);
 static void canopen_rx_task(void* arg);
 static void log_twai_status(const char* tag);
+static void log_upload_progress(const fw_transfer_stats_t* stats, void* ctx);
 
 static void log_twai_status(const char* tag) {
     twai_status_info_t info = {0};
@@ -65,6 +74,61 @@ static TickType_t wait_ticks(uint32_t ms) {
     return (ticks > 0) ? ticks : 1;
 }
 
+/* Prints one line per 10 % of progress plus every phase change. */
+static void log_upload_progress(const fw_transfer_stats_t* stats, void* ctx) {
+    static fw_phase_t lastPhase = FW_PHASE_IDLE;
+    static uint32_t lastDecile = 0U;
+    (void)ctx;
+
+    uint32_t decile = stats->imageBytes > 0U ? (uint32_t)(((uint64_t)stats->bytesSent * 10U) / stats->imageBytes) : 0U;
+    if (stats->phase == lastPhase && decile == lastDecile) {
+        return;
+    }
+    lastPhase = stats->phase;
+    lastDecile = decile;
+    ESP_LOGI(LOG_TAG, "Upload phase %d: %" PRIu32 "/%" PRIu32 " bytes, %" PRIu32 " B/s, ETA %" PRIu32 " ms",
+             (int)stats->phase, stats->bytesSent, stats->imageBytes, stats->bytesPerSecond, stats->etaMs);
+}
+
+/* Bundles built by build_fw_bundle.py use the .fwb extension. */
+static fw_image_type_t image_type_for_path(const char* path) {
+    size_t len = strlen(path);
+    return (len > 4U && strcmp(path + len - 4U, ".fwb") == 0) ? FW_IMAGE_BUNDLE : FW_IMAGE_MAIN;
+}
+
+#if CONFIG_DEMO_MASTER_READBACK_RUNNING_IMAGE
+/* Pull the slave's running image over a block upload and check it against 0x2100. */
+static void readback_running_image(uint8_t nodeId) {
+    uint32_t imageBytes = 0U;
+    uint16_t crc = 0U;
+    fw_sdo_req_t identity[] = {
+        {.nodeId = nodeId, .index = 0x2100, .subIndex = 1, .upload = true, .buf = (uint8_t*)&imageBytes,
+         .bufLen = sizeof(imageBytes), .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE},
+        {.nodeId = nodeId, .index = 0x2100, .subIndex = 2, .upload = true, .buf = (uint8_t*)&crc,
+         .bufLen = sizeof(crc), .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE}};
+    if (!fw_sdo_queue_run(identity, 2U) || imageBytes == 0U) {
+        ESP_LOGW(LOG_TAG, "Slave %u does not publish its running image; no readback", (unsigned)nodeId);
+        return;
+    }
+
+    fw_readback_result_t result;
+    const char* path = CONFIG_DEMO_MASTER_READBACK_PATH;
+    bool ok = path[0] != '\0'
+                  ? fw_readback_partition_to_file(nodeId, FW_READBACK_RUNNING, 0U, imageBytes, path, &result)
+                  : fw_readback_partition(nodeId, FW_READBACK_RUNNING, 0U, imageBytes, NULL, NULL, &result);
+    if (!ok) {
+        ESP_LOGE(LOG_TAG, "Readback of the running image failed");
+    } else if (result.bytes != imageBytes || result.crc != crc) {
+        ESP_LOGE(LOG_TAG,
+                 "Readback does not match 0x2100: %u bytes crc 0x%04X, expected %" PRIu32 " bytes crc 0x%04X",
+                 (unsigned)result.bytes, result.crc, imageBytes, crc);
+    } else {
+        ESP_LOGI(LOG_TAG, "Running image read back intact (%" PRIu32 " bytes in %" PRIu32 " ms)%s%s", imageBytes,
+                 result.elapsedMs, path[0] != '\0' ? " into " : "", path);
+    }
+}
+#endif
+
 static void init_nvs(void) {
     esp_err_t err = nvs_flash_init();
     if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -93,13 +157,40 @@ static void init_spiffs(void) {
         size_t used = 0;
         ESP_ERROR_CHECK(esp_spiffs_info(conf.partition_label, &total, &used));
         ESP_LOGI(LOG_TAG, "SPIFFS: total=%u bytes used=%u bytes", (unsigned)total, (unsigned)used);
+        if (fw_catalog_init(conf.base_path)) {
+            ESP_LOGI(LOG_TAG, "Firmware catalog holds %u images", (unsigned)fw_catalog_count());
+        } else {
+            ESP_LOGW(LOG_TAG, "Firmware catalog unavailable; images will be scanned per session");
+        }
     }
 }
 #endif
 
+#if (((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_STATS) != 0) && (CONFIG_DEMO_MASTER_PROCESS_STATS_S > 0)
+static const char* const s_processNames[CO_PROCESS_COUNT] = {"CAN", "LSS", "LEDs", "EM",   "NMT",
+                                                             "SDO", "HB",  "NG",   "TIME", "GTWA"};
+
+/* Log and clear the per-module CO_process() counters; called from the process task only. */
+static void log_process_stats(CO_t* co) {
+    for (int i = 0; i < CO_PROCESS_COUNT; i++) {
+        const CO_processStat_t* st = &co->processStats[i];
+        if (st->calls == 0U && st->skips == 0U) {
+            continue;
+        }
+        ESP_LOGI(CANOPEN_TAG, "%-4s run %" PRIu32 " skip %" PRIu32 " total %" PRIu32 " us max %" PRIu32 " us",
+                 s_processNames[i], st->calls, st->skips, st->time_us, st->timeMax_us);
+    }
+    memset(co->processStats, 0, sizeof(co->processStats));
+}
+#define PROCESS_STATS_US ((int64_t)CONFIG_DEMO_MASTER_PROCESS_STATS_S * 1000000)
+#endif
+
 static void canopen_process_task(void* arg) {
     canopen_master_t* ctx = (canopen_master_t*)arg;
     int64_t last = esp_timer_get_time();
+#ifdef PROCESS_STATS_US
+    int64_t lastStats = last;
+#endif
 
     while (true) {
         if (ctx->co != NULL) {
@@ -111,6 +202,12 @@ static void canopen_process_task(void* arg) {
             if (reset != CO_RESET_NOT) {
                 ESP_LOGW(CANOPEN_TAG, "Requested CANopen reset (%d)", reset);
             }
+#ifdef PROCESS_STATS_US
+            if (now - lastStats >= PROCESS_STATS_US) {
+                lastStats = now;
+                log_process_stats(ctx->co);
+            }
+#endif
 
 #if (((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE) != 0) || (((CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE)) != 0)
             CO_LOCK_OD(ctx->co->CANmodule);
@@ -165,6 +262,12 @@ static bool canopen_master_init(void) {
         ESP_LOGE(CANOPEN_TAG, "CO_CANinit failed (%d)", err);
         goto fail;
     }
+    /* Firmware transfers are the SDO client requests; PDO, SYNC, NMT and heartbeats are never held back. */
+    CO_CANsetBulkLimit(g_canopen.co->CANmodule, CO_CAN_ID_SDO_CLI + 1U, CO_CAN_ID_SDO_CLI + 0x7FU,
+                       CONFIG_DEMO_MASTER_BUS_LOAD_PERCENT);
+    if (CONFIG_DEMO_MASTER_BUS_LOAD_PERCENT > 0) {
+        ESP_LOGI(CANOPEN_TAG, "SDO transfers keep the bus below %d%% load", CONFIG_DEMO_MASTER_BUS_LOAD_PERCENT);
+    }
 
     uint32_t errInfo = 0U;
     err = CO_CANopenInit(g_canopen.co, NULL, NULL, OD, NULL, NMT_CONTROL, FIRST_HB_TIME, SDO_SRV_TIMEOUT_TIME,
@@ -190,6 +293,10 @@ static bool canopen_master_init(void) {
         ESP_LOGE(CANOPEN_TAG, "SDO client unavailable");
         goto fail;
     }
+    if (!fw_sdo_queue_start(g_canopen.co->SDOclient, OD_CNT_SDO_CLI)) {
+        ESP_LOGE(CANOPEN_TAG, "Failed to start the SDO request queue");
+        goto fail;
+    }
     if (!fw_master_bind_sdo_client(g_canopen.sdoClient)) {
         ESP_LOGE(CANOPEN_TAG, "Failed to bind SDO client to uploader");
         goto fail;
@@ -243,11 +350,43 @@ void app_main(void) {
 
     fw_upload_plan_t plan = {
         .firmwarePath = CONFIG_DEMO_MASTER_FW_PATH,
-        .type = FW_IMAGE_MAIN,
+        .firmwareVersion = CONFIG_DEMO_MASTER_FW_VERSION,
+        .type = image_type_for_path(CONFIG_DEMO_MASTER_FW_PATH),
         .targetBank = CONFIG_DEMO_MASTER_TARGET_BANK,
         .targetNodeId = CONFIG_DEMO_MASTER_NODE_ID,
         .maxChunkBytes = CONFIG_DEMO_MASTER_CHUNK_BYTES,
-        .expectedCrc = 0U};
+        .expectedCrc = 0U,
+#if CONFIG_DEMO_MASTER_DIGEST_SHA256
+        .digestType = FW_DIGEST_SHA256,
+#elif CONFIG_DEMO_MASTER_DIGEST_CRC32
+        .digestType = FW_DIGEST_CRC32,
+#else
+        .digestType = FW_DIGEST_NONE,
+#endif
+        .readAheadDepth = CONFIG_DEMO_MASTER_READAHEAD_DEPTH,
+#if CONFIG_DEMO_MASTER_SKIP_IF_IDENTICAL
+        .skipIfIdentical = true,
+#else
+        .skipIfIdentical = false,
+#endif
+#if CONFIG_DEMO_MASTER_PULL_SLAVE_COUNTERS
+        .pullSlaveCounters = true,
+#else
+        .pullSlaveCounters = false,
+#endif
+#if CONFIG_DEMO_MASTER_FRAMED_CHUNKS
+        .framedChunks = true,
+#else
+        .framedChunks = false,
+#endif
+        .sdoRetries = CONFIG_DEMO_MASTER_SDO_RETRIES,
+        .onProgress = log_upload_progress,
+        .progressCtx = NULL
+    };
+
+#if CONFIG_DEMO_MASTER_READBACK_RUNNING_IMAGE
+    readback_running_image(plan.targetNodeId);
+#endif
 
     ESP_LOGI(LOG_TAG, "Starting master firmware upload demo using %s", plan.firmwarePath);
 
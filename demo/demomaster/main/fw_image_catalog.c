@@ -0,0 +1,368 @@
+#include "fw_image_catalog.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "esp_app_format.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "fw_digest.h"
+
+#ifndef CONFIG_DEMO_MASTER_CATALOG_MAX_ENTRIES
+#define CONFIG_DEMO_MASTER_CATALOG_MAX_ENTRIES 32
+#endif
+
+#define FW_CATALOG_MAX_ENTRIES CONFIG_DEMO_MASTER_CATALOG_MAX_ENTRIES
+#define FW_CATALOG_INDEX_NAME  "fw_catalog.idx"
+#define FW_CATALOG_MAGIC       0x49435746U /* "FWCI" */
+#define FW_CATALOG_FORMAT      2U /* 2: entries carry crc32 */
+#define FW_CATALOG_SCRATCH     1024U
+#define FW_CATALOG_SLOT_EMPTY  0xFFU
+
+/* Open-addressing table at least twice the entry count keeps version lookups O(1). */
+#define FW_CATALOG_HASH_SLOTS  128U
+#define FW_CATALOG_HASH_MASK   (FW_CATALOG_HASH_SLOTS - 1U)
+
+#if FW_CATALOG_MAX_ENTRIES > (FW_CATALOG_HASH_SLOTS / 2)
+#error "Catalog hash table must stay at most half full"
+#endif
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t count;
+    uint16_t crc;
+    uint16_t entryBytes;
+} fw_catalog_header_t;
+
+typedef struct {
+    char basePath[FW_CATALOG_PATH_MAX];
+    fw_catalog_entry_t entries[FW_CATALOG_MAX_ENTRIES];
+    uint8_t versionSlots[FW_CATALOG_HASH_SLOTS];
+    size_t count;
+    bool ready;
+} fw_catalog_t;
+
+static const char *TAG = "fw_catalog";
+static fw_catalog_t s_catalog;
+
+static uint32_t fw_catalog_hash(const char *text) {
+    uint32_t hash = 2166136261U;
+    while (*text != '\0') {
+        hash ^= (uint8_t)*text++;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static void fw_catalog_rebuild_index(void) {
+    memset(s_catalog.versionSlots, FW_CATALOG_SLOT_EMPTY, sizeof(s_catalog.versionSlots));
+    for (size_t i = 0; i < s_catalog.count; i++) {
+        const fw_catalog_entry_t *entry = &s_catalog.entries[i];
+        if (entry->version[0] == '\0') {
+            continue;
+        }
+        uint32_t slot = fw_catalog_hash(entry->version) & FW_CATALOG_HASH_MASK;
+        while (s_catalog.versionSlots[slot] != FW_CATALOG_SLOT_EMPTY) {
+            const fw_catalog_entry_t *other = &s_catalog.entries[s_catalog.versionSlots[slot]];
+            if (strcmp(other->version, entry->version) == 0) {
+                ESP_LOGW(TAG, "Version %s provided by both %s and %s; keeping %s", entry->version, other->fileName,
+                         entry->fileName, other->fileName);
+                break;
+            }
+            slot = (slot + 1U) & FW_CATALOG_HASH_MASK;
+        }
+        if (s_catalog.versionSlots[slot] == FW_CATALOG_SLOT_EMPTY) {
+            s_catalog.versionSlots[slot] = (uint8_t)i;
+        }
+    }
+}
+
+static bool fw_catalog_build_path(const char *fileName, char *buf, size_t len) {
+    int written = snprintf(buf, len, "%s/%s", s_catalog.basePath, fileName);
+    return written > 0 && (size_t)written < len;
+}
+
+static void fw_catalog_load_index(void) {
+    char path[FW_CATALOG_PATH_MAX];
+    s_catalog.count = 0U;
+    if (!fw_catalog_build_path(FW_CATALOG_INDEX_NAME, path, sizeof(path))) {
+        return;
+    }
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        ESP_LOGI(TAG, "No index at %s; building a new one", path);
+        return;
+    }
+
+    fw_catalog_header_t header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == FW_CATALOG_MAGIC &&
+              header.format == FW_CATALOG_FORMAT && header.entryBytes == sizeof(fw_catalog_entry_t) &&
+              header.count <= FW_CATALOG_MAX_ENTRIES;
+    if (ok && header.count > 0U) {
+        ok = fread(s_catalog.entries, sizeof(fw_catalog_entry_t), header.count, file) == header.count &&
+             fw_crc16_update(0xFFFFU, (const uint8_t *)s_catalog.entries,
+                             sizeof(fw_catalog_entry_t) * header.count) == header.crc;
+    }
+    fclose(file);
+
+    if (!ok) {
+        ESP_LOGW(TAG, "Discarding stale or corrupt index %s", path);
+        return;
+    }
+    s_catalog.count = header.count;
+    ESP_LOGI(TAG, "Loaded %u catalog entries from %s", (unsigned)s_catalog.count, path);
+}
+
+static bool fw_catalog_store_index(void) {
+    char path[FW_CATALOG_PATH_MAX];
+    char tmpPath[FW_CATALOG_PATH_MAX];
+    if (!fw_catalog_build_path(FW_CATALOG_INDEX_NAME, path, sizeof(path)) ||
+        !fw_catalog_build_path(FW_CATALOG_INDEX_NAME ".tmp", tmpPath, sizeof(tmpPath))) {
+        return false;
+    }
+
+    const fw_catalog_header_t header = {
+        .magic = FW_CATALOG_MAGIC,
+        .format = FW_CATALOG_FORMAT,
+        .count = (uint16_t)s_catalog.count,
+        .crc = fw_crc16_update(0xFFFFU, (const uint8_t *)s_catalog.entries,
+                               sizeof(fw_catalog_entry_t) * s_catalog.count),
+        .entryBytes = sizeof(fw_catalog_entry_t)};
+
+    FILE *file = fopen(tmpPath, "wb");
+    if (file == NULL) {
+        ESP_LOGW(TAG, "Cannot write index %s", tmpPath);
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(s_catalog.entries, sizeof(fw_catalog_entry_t), s_catalog.count, file) == s_catalog.count;
+    ok = (fclose(file) == 0) && ok;
+    if (ok) {
+        (void)remove(path);
+        ok = rename(tmpPath, path) == 0;
+    }
+    if (!ok) {
+        (void)remove(tmpPath);
+        ESP_LOGW(TAG, "Failed to update index %s", path);
+    }
+    return ok;
+}
+
+static bool fw_catalog_has_suffix(const char *name, const char *suffix) {
+    size_t nameLen = strlen(name);
+    size_t suffixLen = strlen(suffix);
+    return nameLen > suffixLen && strcmp(name + nameLen - suffixLen, suffix) == 0;
+}
+
+static void fw_catalog_parse_app_desc(fw_catalog_entry_t *entry, const uint8_t *head, size_t headLen) {
+    const size_t descOffset = sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t);
+    entry->flags &= (uint8_t)~FW_CATALOG_FLAG_APP_DESC;
+    entry->version[0] = '\0';
+    entry->projectName[0] = '\0';
+    if (headLen < descOffset + sizeof(esp_app_desc_t) || head[0] != ESP_IMAGE_HEADER_MAGIC) {
+        return;
+    }
+
+    esp_app_desc_t desc;
+    memcpy(&desc, head + descOffset, sizeof(desc));
+    if (desc.magic_word != ESP_APP_DESC_MAGIC_WORD) {
+        return;
+    }
+    strncpy(entry->version, desc.version, sizeof(entry->version) - 1U);
+    entry->version[sizeof(entry->version) - 1U] = '\0';
+    strncpy(entry->projectName, desc.project_name, sizeof(entry->projectName) - 1U);
+    entry->projectName[sizeof(entry->projectName) - 1U] = '\0';
+    entry->flags |= FW_CATALOG_FLAG_APP_DESC;
+}
+
+/* Single pass over the file: size, CRC16, CRC32, SHA-256 and the embedded app description. */
+static bool fw_catalog_scan_image(const char *path, fw_catalog_entry_t *entry) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        ESP_LOGW(TAG, "Cannot open %s", path);
+        return false;
+    }
+    uint8_t *scratch = (uint8_t *)malloc(FW_CATALOG_SCRATCH);
+    if (scratch == NULL) {
+        fclose(file);
+        return false;
+    }
+
+    fw_digest_t sha;
+    fw_digest_t crc32;
+    /* Without CONFIG_FW_DIGEST_SHA256 sha stays inert and the entry keeps an all-zero hash. */
+    (void)fw_digest_begin(&sha, FW_DIGEST_SHA256);
+    if (!fw_digest_begin(&crc32, FW_DIGEST_CRC32)) {
+        fclose(file);
+        free(scratch);
+        return false;
+    }
+
+    uint16_t crc = 0xFFFFU;
+    uint32_t total = 0U;
+    bool first = true;
+    size_t read;
+    while ((read = fread(scratch, 1, FW_CATALOG_SCRATCH, file)) > 0U) {
+        if (first) {
+            fw_catalog_parse_app_desc(entry, scratch, read);
+            first = false;
+        }
+        crc = fw_crc16_update(crc, scratch, read);
+        fw_digest_update(&sha, scratch, read);
+        fw_digest_update(&crc32, scratch, read);
+        total += (uint32_t)read;
+    }
+    bool ok = ferror(file) == 0 && total > 0U;
+    fclose(file);
+    free(scratch);
+
+    uint8_t crc32Bytes[FW_DIGEST_MAX_LEN];
+    (void)fw_digest_finish(&sha, entry->sha256);
+    (void)fw_digest_finish(&crc32, crc32Bytes);
+    entry->crc32 = (uint32_t)crc32Bytes[0] | ((uint32_t)crc32Bytes[1] << 8) | ((uint32_t)crc32Bytes[2] << 16) |
+                   ((uint32_t)crc32Bytes[3] << 24);
+    entry->imageBytes = total;
+    entry->crc16 = crc;
+    return ok;
+}
+
+bool fw_catalog_refresh(void) {
+    if (!s_catalog.ready) {
+        return false;
+    }
+    DIR *dir = opendir(s_catalog.basePath);
+    if (dir == NULL) {
+        ESP_LOGE(TAG, "Cannot list %s", s_catalog.basePath);
+        return false;
+    }
+
+    bool seen[FW_CATALOG_MAX_ENTRIES] = {false};
+    bool changed = false;
+    struct dirent *item;
+    while ((item = readdir(dir)) != NULL) {
+        if (!fw_catalog_has_suffix(item->d_name, ".bin") || strlen(item->d_name) >= FW_CATALOG_NAME_MAX) {
+            continue;
+        }
+        char path[FW_CATALOG_PATH_MAX];
+        struct stat st;
+        if (!fw_catalog_build_path(item->d_name, path, sizeof(path)) || stat(path, &st) != 0) {
+            continue;
+        }
+
+        size_t index = 0U;
+        while (index < s_catalog.count && strcmp(s_catalog.entries[index].fileName, item->d_name) != 0) {
+            index++;
+        }
+        if (index < s_catalog.count) {
+            fw_catalog_entry_t *known = &s_catalog.entries[index];
+            seen[index] = true;
+            if (known->imageBytes == (uint32_t)st.st_size && known->mtime == (uint32_t)st.st_mtime) {
+                continue;
+            }
+        } else if (s_catalog.count >= FW_CATALOG_MAX_ENTRIES) {
+            ESP_LOGW(TAG, "Catalog full; ignoring %s", item->d_name);
+            continue;
+        }
+
+        fw_catalog_entry_t fresh = {0};
+        strncpy(fresh.fileName, item->d_name, sizeof(fresh.fileName) - 1U);
+        fresh.mtime = (uint32_t)st.st_mtime;
+        if (!fw_catalog_scan_image(path, &fresh)) {
+            if (index < s_catalog.count) {
+                seen[index] = false;
+            }
+            continue;
+        }
+        s_catalog.entries[index] = fresh;
+        seen[index] = true;
+        if (index == s_catalog.count) {
+            s_catalog.count++;
+        }
+        changed = true;
+        ESP_LOGI(TAG, "Indexed %s: %u bytes crc=0x%04X version=%s", fresh.fileName, (unsigned)fresh.imageBytes,
+                 fresh.crc16, fresh.version[0] != '\0' ? fresh.version : "-");
+    }
+    closedir(dir);
+
+    /* Drop entries whose file disappeared, compacting the table in place. */
+    size_t kept = 0U;
+    for (size_t i = 0; i < s_catalog.count; i++) {
+        if (!seen[i]) {
+            ESP_LOGI(TAG, "Removed %s from catalog", s_catalog.entries[i].fileName);
+            changed = true;
+            continue;
+        }
+        if (kept != i) {
+            s_catalog.entries[kept] = s_catalog.entries[i];
+        }
+        kept++;
+    }
+    s_catalog.count = kept;
+
+    if (changed) {
+        fw_catalog_rebuild_index();
+        (void)fw_catalog_store_index();
+    }
+    return true;
+}
+
+bool fw_catalog_init(const char *basePath) {
+    if (basePath == NULL || strlen(basePath) >= sizeof(s_catalog.basePath)) {
+        return false;
+    }
+    memset(&s_catalog, 0, sizeof(s_catalog));
+    strncpy(s_catalog.basePath, basePath, sizeof(s_catalog.basePath) - 1U);
+    fw_catalog_load_index();
+    fw_catalog_rebuild_index();
+    s_catalog.ready = true;
+    return fw_catalog_refresh();
+}
+
+const fw_catalog_entry_t *fw_catalog_find_by_version(const char *version) {
+    if (!s_catalog.ready || version == NULL || version[0] == '\0') {
+        return NULL;
+    }
+    uint32_t slot = fw_catalog_hash(version) & FW_CATALOG_HASH_MASK;
+    while (s_catalog.versionSlots[slot] != FW_CATALOG_SLOT_EMPTY) {
+        const fw_catalog_entry_t *entry = &s_catalog.entries[s_catalog.versionSlots[slot]];
+        if (strcmp(entry->version, version) == 0) {
+            return entry;
+        }
+        slot = (slot + 1U) & FW_CATALOG_HASH_MASK;
+    }
+    return NULL;
+}
+
+const fw_catalog_entry_t *fw_catalog_find_by_path(const char *path) {
+    if (!s_catalog.ready || path == NULL) {
+        return NULL;
+    }
+    size_t baseLen = strlen(s_catalog.basePath);
+    if (strncmp(path, s_catalog.basePath, baseLen) != 0 || path[baseLen] != '/') {
+        return NULL;
+    }
+    const char *name = path + baseLen + 1U;
+    for (size_t i = 0; i < s_catalog.count; i++) {
+        if (strcmp(s_catalog.entries[i].fileName, name) == 0) {
+            return &s_catalog.entries[i];
+        }
+    }
+    return NULL;
+}
+
+size_t fw_catalog_count(void) {
+    return s_catalog.ready ? s_catalog.count : 0U;
+}
+
+const fw_catalog_entry_t *fw_catalog_get(size_t index) {
+    return (s_catalog.ready && index < s_catalog.count) ? &s_catalog.entries[index] : NULL;
+}
+
+bool fw_catalog_entry_path(const fw_catalog_entry_t *entry, char *buf, size_t len) {
+    return entry != NULL && buf != NULL && fw_catalog_build_path(entry->fileName, buf, len);
+}
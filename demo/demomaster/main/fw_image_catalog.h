@@ -0,0 +1,51 @@
+#ifndef FW_IMAGE_CATALOG_H
+#define FW_IMAGE_CATALOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FW_CATALOG_NAME_MAX    32U
+#define FW_CATALOG_VERSION_MAX 32U
+#define FW_CATALOG_PATH_MAX    64U
+#define FW_CATALOG_SHA256_LEN  32U
+
+enum {
+    FW_CATALOG_FLAG_APP_DESC = 0x01 /* version/projectName were parsed from esp_app_desc_t */
+};
+
+/* One record of the on-flash index; field order keeps the struct free of padding. */
+typedef struct {
+    char fileName[FW_CATALOG_NAME_MAX];
+    char version[FW_CATALOG_VERSION_MAX];
+    char projectName[FW_CATALOG_VERSION_MAX];
+    uint8_t sha256[FW_CATALOG_SHA256_LEN];
+    uint32_t imageBytes;
+    uint32_t mtime;
+    uint32_t crc32;
+    uint16_t crc16;
+    uint8_t flags;
+    uint8_t reserved;
+} fw_catalog_entry_t;
+
+/** Load the index stored under basePath and bring it up to date with the *.bin files there. */
+bool fw_catalog_init(const char *basePath);
+
+/** Re-stat every image and rehash only the files whose size or mtime changed. */
+bool fw_catalog_refresh(void);
+
+const fw_catalog_entry_t *fw_catalog_find_by_version(const char *version);
+const fw_catalog_entry_t *fw_catalog_find_by_path(const char *path);
+size_t fw_catalog_count(void);
+const fw_catalog_entry_t *fw_catalog_get(size_t index);
+bool fw_catalog_entry_path(const fw_catalog_entry_t *entry, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_IMAGE_CATALOG_H */
@@ -0,0 +1,148 @@
+#include "fw_readback.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "fw_digest.h"
+
+#define FW_READBACK_INDEX 0x2103U
+
+enum {
+    FW_READBACK_SUB_REGION = 1,
+    FW_READBACK_SUB_OFFSET = 2,
+    FW_READBACK_SUB_LENGTH = 3,
+    FW_READBACK_SUB_DATA = 4
+};
+
+static const char *TAG = "fw_readback";
+
+/* Sits between the engine and the caller's sink and keeps the running CRC. */
+typedef struct {
+    fw_sdo_sink_t sink;
+    void *object;
+    uint16_t crc;
+} fw_readback_tap_t;
+
+static bool fw_readback_tap(void *object, const uint8_t *data, size_t len) {
+    fw_readback_tap_t *tap = (fw_readback_tap_t *)object;
+    tap->crc = fw_crc16_update(tap->crc, data, len);
+    return tap->sink == NULL || tap->sink(tap->object, data, len);
+}
+
+bool fw_readback_sink_buffer(void *object, const uint8_t *data, size_t len) {
+    fw_readback_buffer_t *dst = (fw_readback_buffer_t *)object;
+    if (len > dst->capacity - dst->used) {
+        return false;
+    }
+    memcpy(dst->buf + dst->used, data, len);
+    dst->used += len;
+    return true;
+}
+
+bool fw_readback_sink_file(void *object, const uint8_t *data, size_t len) {
+    return fwrite(data, 1, len, (FILE *)object) == len;
+}
+
+static bool fw_readback_run(fw_sdo_req_t *req, fw_readback_tap_t *tap, bool block) {
+    tap->crc = 0xFFFFU;
+    req->block = block;
+    return fw_sdo_queue_run(req, 1U);
+}
+
+bool fw_readback_object(uint8_t nodeId, uint16_t index, uint8_t subIndex, fw_sdo_sink_t sink, void *sinkObject,
+                        fw_readback_result_t *out) {
+    fw_readback_tap_t tap = {.sink = sink, .object = sinkObject};
+    fw_sdo_req_t req = {.nodeId = nodeId,
+                        .index = index,
+                        .subIndex = subIndex,
+                        .upload = true,
+                        .sink = fw_readback_tap,
+                        .sinkObject = &tap,
+                        .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE};
+
+    int64_t start = esp_timer_get_time();
+    bool block = true;
+    bool ok = fw_readback_run(&req, &tap, block);
+    /* Servers without block support refuse the initiate before any data moved. */
+    if (!ok && req.transferred == 0U && req.abortCode == CO_SDO_AB_CMD) {
+        ESP_LOGW(TAG, "Node %u refused a block upload of 0x%04X:%02X; reading segmented", (unsigned)nodeId,
+                 (unsigned)index, (unsigned)subIndex);
+        block = false;
+        ok = fw_readback_run(&req, &tap, block);
+    }
+    uint32_t elapsedMs = (uint32_t)((esp_timer_get_time() - start) / 1000);
+
+    if (out != NULL) {
+        *out = (fw_readback_result_t){.bytes = req.transferred,
+                                      .crc = tap.crc,
+                                      .elapsedMs = elapsedMs,
+                                      .block = block,
+                                      .abortCode = req.abortCode};
+    }
+    if (!ok) {
+        ESP_LOGE(TAG, "Upload of 0x%04X:%02X from node %u aborted after %u bytes (0x%08X)", (unsigned)index,
+                 (unsigned)subIndex, (unsigned)nodeId, (unsigned)req.transferred, (unsigned)req.abortCode);
+        return false;
+    }
+    ESP_LOGI(TAG, "Read %u bytes of 0x%04X:%02X from node %u in %u ms (%u B/s, %s), crc 0x%04X",
+             (unsigned)req.transferred, (unsigned)index, (unsigned)subIndex, (unsigned)nodeId, (unsigned)elapsedMs,
+             elapsedMs > 0U ? (unsigned)((uint64_t)req.transferred * 1000U / elapsedMs) : 0U,
+             block ? "block" : "segmented", tap.crc);
+    return true;
+}
+
+static void fw_readback_put_u32(uint8_t *dst, uint32_t value) {
+    for (size_t i = 0; i < 4U; i++) {
+        dst[i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+bool fw_readback_partition(uint8_t nodeId, fw_readback_region_t region, uint32_t offset, uint32_t length,
+                           fw_sdo_sink_t sink, void *sinkObject, fw_readback_result_t *out) {
+    uint8_t regionByte = (uint8_t)region;
+    uint8_t offsetBytes[4];
+    uint8_t lengthBytes[4];
+    fw_readback_put_u32(offsetBytes, offset);
+    fw_readback_put_u32(lengthBytes, length);
+
+    /* Requests to one node run in order, so the range is complete before the upload starts. */
+    fw_sdo_req_t select[] = {
+        {.nodeId = nodeId, .index = FW_READBACK_INDEX, .subIndex = FW_READBACK_SUB_REGION, .data = &regionByte,
+         .len = sizeof(regionByte), .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE},
+        {.nodeId = nodeId, .index = FW_READBACK_INDEX, .subIndex = FW_READBACK_SUB_OFFSET, .data = offsetBytes,
+         .len = sizeof(offsetBytes), .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE},
+        {.nodeId = nodeId, .index = FW_READBACK_INDEX, .subIndex = FW_READBACK_SUB_LENGTH, .data = lengthBytes,
+         .len = sizeof(lengthBytes), .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE}};
+    if (!fw_sdo_queue_run(select, sizeof(select) / sizeof(select[0]))) {
+        for (size_t i = 0; i < sizeof(select) / sizeof(select[0]); i++) {
+            if (!select[i].ok) {
+                ESP_LOGE(TAG, "Node %u refused readback setting 0x2103:%02X (0x%08X)", (unsigned)nodeId,
+                         (unsigned)select[i].subIndex, (unsigned)select[i].abortCode);
+                if (out != NULL) {
+                    *out = (fw_readback_result_t){.abortCode = select[i].abortCode};
+                }
+                break;
+            }
+        }
+        return false;
+    }
+    return fw_readback_object(nodeId, FW_READBACK_INDEX, FW_READBACK_SUB_DATA, sink, sinkObject, out);
+}
+
+bool fw_readback_partition_to_file(uint8_t nodeId, fw_readback_region_t region, uint32_t offset, uint32_t length,
+                                   const char *path, fw_readback_result_t *out) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        ESP_LOGE(TAG, "Cannot create %s", path);
+        return false;
+    }
+    bool ok = fw_readback_partition(nodeId, region, offset, length, fw_readback_sink_file, file, out);
+    if (fclose(file) != 0) {
+        ESP_LOGE(TAG, "Writing %s failed", path);
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,71 @@
+#ifndef FW_READBACK_H
+#define FW_READBACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fw_sdo_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bulk reads from a slave over SDO block upload, for pulling partition contents, logs or
+ * counter dumps off a node. Data goes from the SDO client's buffer straight into a sink while
+ * the transfer runs, and a CRC16 over everything received is kept on the way (fw_crc16_update
+ * seeded with 0xFFFF, as in the catalog and the slave's 0x2100:02). The block protocol checks
+ * each transfer on the bus already; this CRC is for comparing against a known image.
+ */
+
+/* Partitions the slave serves through 0x2103:04. */
+typedef enum {
+    FW_READBACK_RUNNING = 0,
+    /* The OTA slot the next update goes to, which holds the previous image after an update. */
+    FW_READBACK_INACTIVE = 1
+} fw_readback_region_t;
+
+typedef struct {
+    size_t bytes;
+    uint16_t crc;
+    uint32_t elapsedMs;
+    /* False when the server refused block transfers and the read ran segmented. */
+    bool block;
+    CO_SDO_abortCode_t abortCode;
+} fw_readback_result_t;
+
+/* Sink into a caller buffer; data beyond capacity fails the read. */
+typedef struct {
+    uint8_t *buf;
+    size_t capacity;
+    size_t used;
+} fw_readback_buffer_t;
+
+bool fw_readback_sink_buffer(void *object, const uint8_t *data, size_t len);
+/* Sink into an open FILE *. */
+bool fw_readback_sink_file(void *object, const uint8_t *data, size_t len);
+
+/**
+ * Upload one object of nodeId into sink, block transfer first and segmented when the server
+ * refuses that. A NULL sink only computes the CRC. Blocks the calling task.
+ */
+bool fw_readback_object(uint8_t nodeId, uint16_t index, uint8_t subIndex, fw_sdo_sink_t sink, void *sinkObject,
+                        fw_readback_result_t *out);
+
+/**
+ * Point the slave's 0x2103 at offset..offset+length of a partition and read it; length 0
+ * reads to the end of the partition.
+ */
+bool fw_readback_partition(uint8_t nodeId, fw_readback_region_t region, uint32_t offset, uint32_t length,
+                           fw_sdo_sink_t sink, void *sinkObject, fw_readback_result_t *out);
+
+/** fw_readback_partition into the file at path, which is created or truncated. */
+bool fw_readback_partition_to_file(uint8_t nodeId, fw_readback_region_t region, uint32_t offset, uint32_t length,
+                                   const char *path, fw_readback_result_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_READBACK_H */
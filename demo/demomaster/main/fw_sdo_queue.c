@@ -0,0 +1,421 @@
+#include "fw_sdo_queue.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "CANopen.h"
+#include "sdkconfig.h"
+
+#ifndef CONFIG_DEMO_MASTER_SDO_MIN_TIMEOUT_MS
+#define CONFIG_DEMO_MASTER_SDO_MIN_TIMEOUT_MS 750
+#endif
+
+#ifndef CONFIG_DEMO_MASTER_SDO_MAX_TIMEOUT_MS
+#define CONFIG_DEMO_MASTER_SDO_MAX_TIMEOUT_MS 5000
+#endif
+
+/* Timeout before the first response of a node has been measured, as in RFC 6298. */
+#define FW_SDO_INITIAL_TIMEOUT_MS 1000U
+#define FW_SDO_MAX_NODES          128U
+
+/* Sinks run on the engine task; room for a file sink writing to SPIFFS. */
+#define FW_SDO_QUEUE_STACK    4096U
+#define FW_SDO_QUEUE_PRIORITY 5U
+/* Upload data passes through this much engine stack on its way to a sink. */
+#define FW_SDO_SINK_CHUNK 128U
+/*
+ * Wake-up period while a transfer is in flight. Responses wake the engine on their own when
+ * the client signals them (CO_CONFIG_FLAG_CALLBACK_PRE); this only drives timeouts then.
+ */
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_CALLBACK_PRE) != 0
+#define FW_SDO_QUEUE_POLL_MS 10U
+#else
+#define FW_SDO_QUEUE_POLL_MS 1U
+#endif
+
+/* One SDO client and the request it is working on. */
+typedef struct {
+    CO_SDOclient_t *client;
+    fw_sdo_req_t *active;
+    uint8_t nodeId; /* node the client is set up for, 0 before the first request */
+    bool callerFailed; /* the request's source or sink gave up */
+    CO_SDO_return_t lastRet;
+    int64_t lastStepUs;
+} fw_sdo_lane_t;
+
+/*
+ * Pending requests form a singly linked list through fw_sdo_req_t.next, guarded by lock.
+ * Lanes are touched by the engine task only.
+ */
+typedef struct {
+    fw_sdo_lane_t lanes[FW_SDO_QUEUE_MAX_CLIENTS];
+    size_t laneCount;
+    fw_sdo_req_t *head;
+    fw_sdo_req_t *tail;
+    SemaphoreHandle_t lock;
+    TaskHandle_t task;
+} fw_sdo_queue_t;
+
+static const char *TAG = "fw_sdo_queue";
+static fw_sdo_queue_t s_queue;
+/* Indexed by node id; written by the engine task only. */
+static fw_sdo_timing_t s_timing[FW_SDO_MAX_NODES];
+
+static uint32_t fw_sdo_clamp_timeout(uint64_t us) {
+    const uint64_t minUs = (uint64_t)CONFIG_DEMO_MASTER_SDO_MIN_TIMEOUT_MS * 1000U;
+    const uint64_t maxUs = (uint64_t)CONFIG_DEMO_MASTER_SDO_MAX_TIMEOUT_MS * 1000U;
+    return (uint32_t)(us < minUs ? minUs : (us > maxUs ? maxUs : us));
+}
+
+static void fw_sdo_timing_sample(fw_sdo_timing_t *t, uint32_t rttUs) {
+    if (t->samples == 0U) {
+        t->srttUs = rttUs;
+        t->rttvarUs = rttUs / 2U;
+    } else {
+        uint32_t err = rttUs > t->srttUs ? rttUs - t->srttUs : t->srttUs - rttUs;
+        t->rttvarUs = t->rttvarUs - t->rttvarUs / 4U + err / 4U;
+        t->srttUs = t->srttUs - t->srttUs / 8U + rttUs / 8U;
+    }
+    t->samples++;
+    t->timeoutUs = fw_sdo_clamp_timeout((uint64_t)t->srttUs + 4U * (uint64_t)t->rttvarUs);
+}
+
+static void fw_sdo_timing_backoff(fw_sdo_timing_t *t) {
+    t->timeouts++;
+    t->timeoutUs = fw_sdo_clamp_timeout(2U * (uint64_t)t->timeoutUs);
+}
+
+static TickType_t fw_sdo_queue_poll_ticks(void) {
+    TickType_t ticks = pdMS_TO_TICKS(FW_SDO_QUEUE_POLL_MS);
+    return ticks > 0 ? ticks : 1;
+}
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_CALLBACK_PRE) != 0
+/* Runs on the CAN receive task for every response a client accepted. */
+static void fw_sdo_queue_signal(void *object) {
+    (void)object;
+    (void)xTaskNotifyGive(s_queue.task);
+}
+#endif
+
+/* Source handed to the client; a short answer from the caller's source fails the transfer. */
+static size_t fw_sdo_queue_pull(void *object, uint8_t *buf, size_t count) {
+    fw_sdo_lane_t *lane = (fw_sdo_lane_t *)object;
+    fw_sdo_req_t *req = lane->active;
+    size_t got = req->source(req->sourceObject, buf, count);
+    if (got < count) {
+        lane->callerFailed = true;
+    }
+    return got;
+}
+
+static bool fw_sdo_queue_node_busy(uint8_t nodeId) {
+    for (size_t i = 0; i < s_queue.laneCount; i++) {
+        if (s_queue.lanes[i].active != NULL && s_queue.lanes[i].active->nodeId == nodeId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Oldest pending request whose node no other client is talking to, unlinked from the list. */
+static fw_sdo_req_t *fw_sdo_queue_take(void) {
+    (void)xSemaphoreTake(s_queue.lock, portMAX_DELAY);
+    fw_sdo_req_t *prev = NULL;
+    fw_sdo_req_t *req = s_queue.head;
+    while (req != NULL && fw_sdo_queue_node_busy(req->nodeId)) {
+        prev = req;
+        req = req->next;
+    }
+    if (req != NULL) {
+        if (prev == NULL) {
+            s_queue.head = req->next;
+        } else {
+            prev->next = req->next;
+        }
+        if (s_queue.tail == req) {
+            s_queue.tail = prev;
+        }
+        req->next = NULL;
+    }
+    (void)xSemaphoreGive(s_queue.lock);
+    return req;
+}
+
+static bool fw_sdo_lane_begin(fw_sdo_lane_t *lane, fw_sdo_req_t *req) {
+    CO_SDOclient_t *client = lane->client;
+    lane->active = req;
+    lane->callerFailed = false;
+    lane->lastRet = CO_SDO_RT_waitingResponse;
+    lane->lastStepUs = esp_timer_get_time();
+
+    if (lane->nodeId != req->nodeId) {
+        CO_SDO_return_t ret = CO_SDOclient_setup(client, CO_CAN_ID_SDO_CLI + req->nodeId,
+                                                 CO_CAN_ID_SDO_SRV + req->nodeId, req->nodeId);
+        if (ret != CO_SDO_RT_ok_communicationEnd) {
+            ESP_LOGE(TAG, "CO_SDOclient_setup for node %u failed (ret=%d)", (unsigned)req->nodeId, ret);
+            lane->nodeId = 0U;
+            return false;
+        }
+        lane->nodeId = req->nodeId;
+    }
+
+    uint16_t timeoutMs = req->timeoutMs;
+    if (timeoutMs == FW_SDO_TIMEOUT_ADAPTIVE) {
+        timeoutMs = (uint16_t)((s_timing[req->nodeId].timeoutUs + 999U) / 1000U);
+    }
+    if (req->upload) {
+        return CO_SDOclientUploadInitiate(client, req->index, req->subIndex, timeoutMs, req->block) ==
+               CO_SDO_RT_ok_communicationEnd;
+    }
+    if (CO_SDOclientDownloadInitiate(client, req->index, req->subIndex, req->len + req->sourceLen, timeoutMs,
+                                     false) != CO_SDO_RT_ok_communicationEnd) {
+        return false;
+    }
+    if (req->len > 0U && CO_SDOclientDownloadBufWrite(client, req->data, req->len) != req->len) {
+        ESP_LOGE(TAG, "%u bytes do not fit the SDO client buffer", (unsigned)req->len);
+        return false;
+    }
+    return req->sourceLen == 0U ||
+           CO_SDOclientDownloadSource(client, fw_sdo_queue_pull, lane) == CO_SDO_RT_ok_communicationEnd;
+}
+
+/*
+ * Move what the client has received on to the request. Emptying the buffer before every call
+ * into the client matters for block uploads: the next sub-block is sized from the free space.
+ */
+static void fw_sdo_lane_drain(fw_sdo_lane_t *lane) {
+    CO_SDOclient_t *client = lane->client;
+    fw_sdo_req_t *req = lane->active;
+    if (req->sink == NULL) {
+        req->transferred +=
+            CO_SDOclientUploadBufRead(client, req->buf + req->transferred, req->bufLen - req->transferred);
+        return;
+    }
+    uint8_t chunk[FW_SDO_SINK_CHUNK];
+    size_t got;
+    while (!lane->callerFailed && (got = CO_SDOclientUploadBufRead(client, chunk, sizeof(chunk))) > 0U) {
+        if (!req->sink(req->sinkObject, chunk, got)) {
+            lane->callerFailed = true;
+            break;
+        }
+        req->transferred += got;
+    }
+}
+
+/* Advance the lane's transfer by one call into the client; false once it has ended. */
+static bool fw_sdo_lane_step(fw_sdo_lane_t *lane, int64_t nowUs) {
+    CO_SDOclient_t *client = lane->client;
+    fw_sdo_req_t *req = lane->active;
+    uint32_t diffUs = (uint32_t)(nowUs - lane->lastStepUs);
+    lane->lastStepUs = nowUs;
+
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    CO_SDO_return_t ret;
+    if (req->upload) {
+        fw_sdo_lane_drain(lane);
+        bool overflow = req->sink == NULL && lane->lastRet == CO_SDO_RT_uploadDataBufferFull &&
+                        req->transferred == req->bufLen;
+        if (overflow) {
+            abortCode = CO_SDO_AB_OUT_OF_MEM;
+        } else if (lane->callerFailed) {
+            abortCode = CO_SDO_AB_GENERAL;
+        }
+        ret = CO_SDOclientUpload(client, diffUs, overflow || lane->callerFailed, &abortCode, NULL, NULL, NULL);
+        fw_sdo_lane_drain(lane);
+    } else {
+        if (lane->callerFailed) {
+            abortCode = CO_SDO_AB_GENERAL;
+        }
+        ret = CO_SDOclientDownload(client, diffUs, lane->callerFailed, false, &abortCode, &req->transferred, NULL);
+    }
+    lane->lastRet = ret;
+
+    /*
+     * Every response tightens the estimate, and the rest of this transfer runs on it already.
+     * The end of a sub-block is timed from its previous frame, not from a request, so block
+     * transfers keep the estimate as it is.
+     */
+    fw_sdo_timing_t *timing = &s_timing[req->nodeId];
+    bool adaptive = req->timeoutMs == FW_SDO_TIMEOUT_ADAPTIVE;
+    if (client->rttSample_us != 0U) {
+        if (adaptive && !req->block) {
+            fw_sdo_timing_sample(timing, client->rttSample_us);
+            client->SDOtimeoutTime_us = timing->timeoutUs;
+        }
+        client->rttSample_us = 0U;
+    }
+
+    if (ret > 0) {
+        return true;
+    }
+    /* A sink can still refuse the last bytes after the server finished. */
+    if (ret == CO_SDO_RT_ok_communicationEnd && lane->callerFailed) {
+        abortCode = CO_SDO_AB_GENERAL;
+        ret = CO_SDO_RT_endedWithClientAbort;
+    }
+    req->ok = ret == CO_SDO_RT_ok_communicationEnd;
+    req->abortCode = req->ok ? CO_SDO_AB_NONE : abortCode;
+    if (adaptive && req->abortCode == CO_SDO_AB_TIMEOUT) {
+        fw_sdo_timing_backoff(timing);
+    }
+    return false;
+}
+
+static void fw_sdo_lane_finish(fw_sdo_lane_t *lane) {
+    fw_sdo_req_t *req = lane->active;
+    lane->active = NULL;
+    if (req->done != NULL) {
+        req->done(req);
+    }
+}
+
+/*
+ * One pass over every client. A client whose transfer ended picks up the next request right
+ * away, so back-to-back requests cost no extra wake-up. True while anything is in flight.
+ */
+static bool fw_sdo_queue_pass(void) {
+    bool busy = false;
+    for (size_t i = 0; i < s_queue.laneCount; i++) {
+        fw_sdo_lane_t *lane = &s_queue.lanes[i];
+        for (;;) {
+            if (lane->active == NULL) {
+                fw_sdo_req_t *req = fw_sdo_queue_take();
+                if (req == NULL) {
+                    break;
+                }
+                if (!fw_sdo_lane_begin(lane, req)) {
+                    req->ok = false;
+                    req->abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+                    fw_sdo_lane_finish(lane);
+                    continue;
+                }
+            }
+            if (fw_sdo_lane_step(lane, esp_timer_get_time())) {
+                busy = true;
+                break;
+            }
+            fw_sdo_lane_finish(lane);
+        }
+    }
+    return busy;
+}
+
+static void fw_sdo_queue_task(void *arg) {
+    (void)arg;
+    for (;;) {
+        bool busy = fw_sdo_queue_pass();
+        (void)ulTaskNotifyTake(pdTRUE, busy ? fw_sdo_queue_poll_ticks() : portMAX_DELAY);
+    }
+}
+
+bool fw_sdo_queue_start(CO_SDOclient_t *clients, size_t count) {
+    if (s_queue.task != NULL) {
+        return true;
+    }
+    if (clients == NULL || count == 0U) {
+        return false;
+    }
+
+    memset(&s_queue, 0, sizeof(s_queue));
+    memset(s_timing, 0, sizeof(s_timing));
+    for (size_t i = 0; i < FW_SDO_MAX_NODES; i++) {
+        s_timing[i].timeoutUs = fw_sdo_clamp_timeout((uint64_t)FW_SDO_INITIAL_TIMEOUT_MS * 1000U);
+    }
+    s_queue.laneCount = count < FW_SDO_QUEUE_MAX_CLIENTS ? count : FW_SDO_QUEUE_MAX_CLIENTS;
+    for (size_t i = 0; i < s_queue.laneCount; i++) {
+        s_queue.lanes[i].client = &clients[i];
+    }
+    s_queue.lock = xSemaphoreCreateMutex();
+    if (s_queue.lock == NULL) {
+        ESP_LOGE(TAG, "Out of memory for the request queue lock");
+        return false;
+    }
+    if (xTaskCreate(fw_sdo_queue_task, "fw_sdo_queue", FW_SDO_QUEUE_STACK, NULL, FW_SDO_QUEUE_PRIORITY,
+                    &s_queue.task) != pdPASS) {
+        ESP_LOGE(TAG, "Unable to create SDO queue task");
+        vSemaphoreDelete(s_queue.lock);
+        s_queue.lock = NULL;
+        s_queue.task = NULL;
+        return false;
+    }
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_CALLBACK_PRE) != 0
+    for (size_t i = 0; i < s_queue.laneCount; i++) {
+        CO_SDOclient_initCallbackPre(s_queue.lanes[i].client, NULL, fw_sdo_queue_signal);
+    }
+#endif
+    ESP_LOGI(TAG, "SDO request engine running on %u client(s), adaptive timeouts %u..%u ms",
+             (unsigned)s_queue.laneCount, (unsigned)CONFIG_DEMO_MASTER_SDO_MIN_TIMEOUT_MS,
+             (unsigned)CONFIG_DEMO_MASTER_SDO_MAX_TIMEOUT_MS);
+    return true;
+}
+
+bool fw_sdo_queue_submit(fw_sdo_req_t *req) {
+    if (s_queue.task == NULL || req == NULL || req->nodeId == 0U || req->nodeId > 127U) {
+        return false;
+    }
+    if (req->upload ? (req->sink == NULL && req->buf == NULL && req->bufLen > 0U)
+                    : ((req->data == NULL && req->len > 0U) || (req->source == NULL && req->sourceLen > 0U))) {
+        return false;
+    }
+    req->ok = false;
+    req->abortCode = CO_SDO_AB_NONE;
+    req->transferred = 0U;
+    req->next = NULL;
+
+    (void)xSemaphoreTake(s_queue.lock, portMAX_DELAY);
+    if (s_queue.tail == NULL) {
+        s_queue.head = req;
+    } else {
+        s_queue.tail->next = req;
+    }
+    s_queue.tail = req;
+    (void)xSemaphoreGive(s_queue.lock);
+
+    (void)xTaskNotifyGive(s_queue.task);
+    return true;
+}
+
+static void fw_sdo_queue_wake_waiter(fw_sdo_req_t *req) {
+    (void)xTaskNotifyGive((TaskHandle_t)req->ctx);
+}
+
+bool fw_sdo_queue_run(fw_sdo_req_t *reqs, size_t count) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    size_t queued = 0U;
+    for (size_t i = 0; i < count; i++) {
+        reqs[i].done = fw_sdo_queue_wake_waiter;
+        reqs[i].ctx = self;
+        if (fw_sdo_queue_submit(&reqs[i])) {
+            queued++;
+        } else {
+            reqs[i].ok = false;
+            reqs[i].abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+    }
+    /* Notifications count up, so completions that arrive before the wait are not lost. */
+    while (queued > 0U) {
+        if (ulTaskNotifyTake(pdFALSE, portMAX_DELAY) > 0U) {
+            queued--;
+        }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        ok = ok && reqs[i].ok;
+    }
+    return ok;
+}
+
+bool fw_sdo_queue_node_timing(uint8_t nodeId, fw_sdo_timing_t *out) {
+    if (out == NULL || nodeId == 0U || nodeId >= FW_SDO_MAX_NODES) {
+        return false;
+    }
+    *out = s_timing[nodeId];
+    return true;
+}
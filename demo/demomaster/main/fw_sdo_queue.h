@@ -0,0 +1,113 @@
+#ifndef FW_SDO_QUEUE_H
+#define FW_SDO_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CO_SDOclient.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* SDO clients the engine drives at most; extra ones in the OD are left alone. */
+#define FW_SDO_QUEUE_MAX_CLIENTS 4U
+
+/* fw_sdo_req_t.timeoutMs: derive the timeout from the node's measured round trips. */
+#define FW_SDO_TIMEOUT_ADAPTIVE 0U
+
+/*
+ * Asynchronous SDO transfers. Requests are queued and run by one engine task on every SDO
+ * client the master has. A finished transfer hands its client to the next request in the
+ * same pass, and server responses wake the engine straight from the CAN receive path, so
+ * consecutive transfers no longer wait for the task that queued them to be scheduled.
+ * Requests to one node run in the order they were queued; with several clients, requests
+ * to different nodes run side by side.
+ *
+ * A request is owned by the caller and has to stay valid until its done callback ran. The
+ * callback runs on the engine task; it must not block, but it may submit more requests.
+ */
+typedef struct fw_sdo_req fw_sdo_req_t;
+typedef void (*fw_sdo_done_t)(fw_sdo_req_t *req);
+/*
+ * Takes upload data as it arrives, on the engine task; false aborts the transfer. A slow sink
+ * holds up the other clients' transfers meanwhile.
+ */
+typedef bool (*fw_sdo_sink_t)(void *object, const uint8_t *data, size_t len);
+
+struct fw_sdo_req {
+    uint8_t nodeId;
+    uint16_t index;
+    uint8_t subIndex;
+    bool upload;
+    /*
+     * Download: len bytes from data first (at most CO_CONFIG_SDO_CLI_BUFFER_SIZE), then
+     * sourceLen bytes pulled from source while the transfer runs. A source that returns
+     * fewer bytes than asked for has failed and the transfer is aborted.
+     */
+    const uint8_t *data;
+    size_t len;
+    CO_SDOclient_source_t source;
+    void *sourceObject;
+    size_t sourceLen;
+    /*
+     * Upload: into buf, where a response longer than bufLen is aborted, or, with a sink, into
+     * the sink as the client receives it, with no limit. block asks the server for a block
+     * transfer (CRC-checked sub-blocks of up to 127 frames); servers without block support
+     * abort the initiate.
+     */
+    uint8_t *buf;
+    size_t bufLen;
+    fw_sdo_sink_t sink;
+    void *sinkObject;
+    bool block;
+    /*
+     * FW_SDO_TIMEOUT_ADAPTIVE for ordinary requests. Operations known to keep the server busy
+     * (erase, finalize) pass a fixed timeout instead and do not feed the estimate.
+     */
+    uint16_t timeoutMs;
+    fw_sdo_done_t done;
+    void *ctx;
+    /* Filled in by the engine before done is called. */
+    bool ok;
+    CO_SDO_abortCode_t abortCode;
+    size_t transferred;
+    fw_sdo_req_t *next;
+};
+
+/*
+ * Round-trip estimate per node, kept the way TCP derives its retransmission timeout
+ * (RFC 6298): every response of an adaptive request updates a smoothed RTT and its mean
+ * deviation, and the timeout is srtt + 4 * rttvar, clamped to the configured bounds. A
+ * timeout doubles it until the next response arrives.
+ */
+typedef struct {
+    uint32_t srttUs;
+    uint32_t rttvarUs;
+    uint32_t timeoutUs;
+    uint32_t samples;
+    uint32_t timeouts;
+} fw_sdo_timing_t;
+
+/** Start the engine task on clients[0..count); callbacks of those clients are taken over. */
+bool fw_sdo_queue_start(CO_SDOclient_t *clients, size_t count);
+
+/** Queue a request; false when the engine is not running or the request is malformed. */
+bool fw_sdo_queue_submit(fw_sdo_req_t *req);
+
+/**
+ * Queue count requests at once and block the calling task until all of them finished.
+ * Their done and ctx fields are overwritten. True when every request succeeded. Not for
+ * use from a done callback, which would wait on its own engine.
+ */
+bool fw_sdo_queue_run(fw_sdo_req_t *reqs, size_t count);
+
+/** Current estimate for a node; nodes never heard from report the initial timeout. */
+bool fw_sdo_queue_node_timing(uint8_t nodeId, fw_sdo_timing_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_SDO_QUEUE_H */
@@ -0,0 +1,197 @@
+#include "fw_transfer_stats.h"
+
+#include <string.h>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+#include "CANopen.h"
+#include "OD.h"
+
+typedef struct {
+    int64_t timeUs;
+    uint32_t bytes;
+} fw_stats_sample_t;
+
+typedef struct {
+    fw_transfer_stats_t stats;
+    fw_progress_cb_t cb;
+    void *cbCtx;
+    int64_t sessionStartUs;
+    int64_t phaseStartUs;
+    int64_t dataStartUs;
+    fw_stats_sample_t window[FW_STATS_WINDOW];
+    uint8_t windowHead;
+    uint8_t windowCount;
+} fw_stats_context_t;
+
+static fw_stats_context_t s_ctx;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t fw_stats_ms_since(int64_t startUs, int64_t nowUs) {
+    return (uint32_t)((nowUs - startUs) / 1000);
+}
+
+/* Called with the lock held: derive rates and ETA from the sample window; frozen outside the data phase. */
+static void fw_stats_update_rates(int64_t nowUs) {
+    fw_transfer_stats_t *st = &s_ctx.stats;
+    st->elapsedMs = fw_stats_ms_since(s_ctx.sessionStartUs, nowUs);
+
+    if (st->phase != FW_PHASE_DATA) {
+        return;
+    }
+    if (nowUs > s_ctx.dataStartUs) {
+        st->avgBytesPerSecond = (uint32_t)(((uint64_t)st->bytesSent * 1000000ULL) /
+                                           (uint64_t)(nowUs - s_ctx.dataStartUs));
+    }
+
+    if (s_ctx.windowCount < 2U) {
+        return;
+    }
+    uint8_t newest = (uint8_t)((s_ctx.windowHead + FW_STATS_WINDOW - 1U) % FW_STATS_WINDOW);
+    uint8_t oldest = (uint8_t)((s_ctx.windowHead + FW_STATS_WINDOW - s_ctx.windowCount) % FW_STATS_WINDOW);
+    int64_t spanUs = s_ctx.window[newest].timeUs - s_ctx.window[oldest].timeUs;
+    if (spanUs <= 0) {
+        return;
+    }
+    uint32_t spanBytes = s_ctx.window[newest].bytes - s_ctx.window[oldest].bytes;
+    st->bytesPerSecond = (uint32_t)(((uint64_t)spanBytes * 1000000ULL) / (uint64_t)spanUs);
+
+    uint32_t remaining = st->imageBytes > st->bytesSent ? st->imageBytes - st->bytesSent : 0U;
+    st->etaMs = st->bytesPerSecond > 0U
+                    ? (uint32_t)(((uint64_t)remaining * 1000ULL) / st->bytesPerSecond)
+                    : 0U;
+}
+
+/* Mirror into 0x2110 so a configuration tool can watch the session over SDO. */
+static void fw_stats_publish(const fw_transfer_stats_t *st) {
+    OD_RAM.x2110_fwTransferStats.phase = (uint8_t)st->phase;
+    OD_RAM.x2110_fwTransferStats.imageBytes = st->imageBytes;
+    OD_RAM.x2110_fwTransferStats.bytesSent = st->bytesSent;
+    OD_RAM.x2110_fwTransferStats.bytesPerSecond = st->bytesPerSecond;
+    OD_RAM.x2110_fwTransferStats.etaMs = st->etaMs;
+    OD_RAM.x2110_fwTransferStats.sdoAborts = st->sdoAborts;
+    OD_RAM.x2110_fwTransferStats.retries = st->retries;
+    OD_RAM.x2110_fwTransferStats.preflightMs = st->phaseMs[FW_PHASE_PREFLIGHT];
+    OD_RAM.x2110_fwTransferStats.metadataMs = st->phaseMs[FW_PHASE_METADATA];
+    OD_RAM.x2110_fwTransferStats.startMs = st->phaseMs[FW_PHASE_START];
+    OD_RAM.x2110_fwTransferStats.dataMs = st->phaseMs[FW_PHASE_DATA];
+    OD_RAM.x2110_fwTransferStats.finalizeMs = st->phaseMs[FW_PHASE_FINALIZE];
+}
+
+/* Publish and notify outside the lock; the callback gets its own copy. */
+static void fw_stats_notify(void) {
+    fw_transfer_stats_t copy;
+    fw_progress_cb_t cb;
+    void *cbCtx;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    copy = s_ctx.stats;
+    cb = s_ctx.cb;
+    cbCtx = s_ctx.cbCtx;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    fw_stats_publish(&copy);
+    if (cb != NULL) {
+        cb(&copy, cbCtx);
+    }
+}
+
+static void fw_stats_close_phase(int64_t nowUs) {
+    fw_phase_t current = s_ctx.stats.phase;
+    if (current > FW_PHASE_IDLE && current < FW_PHASE_DONE) {
+        s_ctx.stats.phaseMs[current] += fw_stats_ms_since(s_ctx.phaseStartUs, nowUs);
+    }
+    s_ctx.phaseStartUs = nowUs;
+}
+
+void fw_stats_begin(uint32_t imageBytes, fw_progress_cb_t cb, void *ctx) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    memset(&s_ctx, 0, sizeof(s_ctx));
+    s_ctx.stats.imageBytes = imageBytes;
+    s_ctx.cb = cb;
+    s_ctx.cbCtx = ctx;
+    s_ctx.sessionStartUs = now;
+    s_ctx.phaseStartUs = now;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    fw_stats_notify();
+}
+
+void fw_stats_phase(fw_phase_t phase) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    fw_stats_close_phase(now);
+    s_ctx.stats.phase = phase;
+    if (phase == FW_PHASE_DATA) {
+        s_ctx.dataStartUs = now;
+        s_ctx.window[0].timeUs = now;
+        s_ctx.window[0].bytes = s_ctx.stats.bytesSent;
+        s_ctx.windowHead = 1U;
+        s_ctx.windowCount = 1U;
+    }
+    fw_stats_update_rates(now);
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    fw_stats_notify();
+}
+
+void fw_stats_add_bytes(uint32_t bytes) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_ctx.stats.bytesSent += bytes;
+    s_ctx.window[s_ctx.windowHead].timeUs = now;
+    s_ctx.window[s_ctx.windowHead].bytes = s_ctx.stats.bytesSent;
+    s_ctx.windowHead = (uint8_t)((s_ctx.windowHead + 1U) % FW_STATS_WINDOW);
+    if (s_ctx.windowCount < FW_STATS_WINDOW) {
+        s_ctx.windowCount++;
+    }
+    fw_stats_update_rates(now);
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    fw_stats_notify();
+}
+
+void fw_stats_note_abort(void) {
+    portENTER_CRITICAL(&s_stats_lock);
+    s_ctx.stats.sdoAborts++;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void fw_stats_note_retry(void) {
+    portENTER_CRITICAL(&s_stats_lock);
+    s_ctx.stats.retries++;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void fw_stats_mark_skipped(void) {
+    portENTER_CRITICAL(&s_stats_lock);
+    s_ctx.stats.skipped = true;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void fw_stats_end(bool ok) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    fw_stats_close_phase(now);
+    s_ctx.stats.phase = ok ? FW_PHASE_DONE : FW_PHASE_FAILED;
+    fw_stats_update_rates(now);
+    s_ctx.stats.etaMs = 0U;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    fw_stats_notify();
+}
+
+void fw_stats_snapshot(fw_transfer_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *out = s_ctx.stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
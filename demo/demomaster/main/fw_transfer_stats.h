@@ -0,0 +1,58 @@
+#ifndef FW_TRANSFER_STATS_H
+#define FW_TRANSFER_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of chunk samples the instantaneous throughput is averaged over. */
+#define FW_STATS_WINDOW 8U
+
+typedef enum {
+    FW_PHASE_IDLE = 0,
+    FW_PHASE_PREFLIGHT,
+    FW_PHASE_METADATA,
+    FW_PHASE_START,
+    FW_PHASE_DATA,
+    FW_PHASE_FINALIZE,
+    FW_PHASE_DONE,
+    FW_PHASE_FAILED,
+    FW_PHASE_COUNT
+} fw_phase_t;
+
+typedef struct {
+    fw_phase_t phase;
+    bool skipped;
+    uint32_t imageBytes;
+    uint32_t bytesSent;
+    uint32_t bytesPerSecond;    /* over the last FW_STATS_WINDOW chunks */
+    uint32_t avgBytesPerSecond; /* over the whole data phase so far */
+    uint32_t etaMs;             /* 0 until the window holds two samples */
+    uint32_t sdoAborts;
+    uint32_t retries;
+    uint32_t elapsedMs;
+    uint32_t phaseMs[FW_PHASE_COUNT];
+} fw_transfer_stats_t;
+
+/* Runs in the uploader task after every chunk and phase change; keep it short. */
+typedef void (*fw_progress_cb_t)(const fw_transfer_stats_t *stats, void *ctx);
+
+void fw_stats_begin(uint32_t imageBytes, fw_progress_cb_t cb, void *ctx);
+void fw_stats_phase(fw_phase_t phase);
+void fw_stats_add_bytes(uint32_t bytes);
+void fw_stats_note_abort(void);
+void fw_stats_note_retry(void);
+void fw_stats_mark_skipped(void);
+void fw_stats_end(bool ok);
+
+/** Copy of the current (or last finished) session; safe to call from any task. */
+void fw_stats_snapshot(fw_transfer_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_TRANSFER_STATS_H */
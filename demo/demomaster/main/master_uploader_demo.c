@@ -6,14 +6,27 @@
 #include <string.h>
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
 
 #include "CANopen.h"
 #include "CO_SDOclient.h"
 
-#define log_master(fmt, ...) printf("[FW-MASTER] " fmt, ##__VA_ARGS__)
-#define log_error(fmt, ...)  printf("[FW-ERROR ] " fmt, ##__VA_ARGS__)
-#define log_warn(fmt, ...)   printf("[FW-WARN  ] " fmt, ##__VA_ARGS__)
+#include "fw_bundle.h"
+#include "fw_digest.h"
+#include "fw_image_catalog.h"
+#include "fw_log.h"
+#include "fw_rx_map.h"
+#include "fw_sdo_queue.h"
+#include "fw_trace.h"
+
+#define log_master(fmt, ...) FW_LOG_AT(FW_LOG_LEVEL_INFO, printf, "[FW-MASTER] " fmt, ##__VA_ARGS__)
+#define log_error(fmt, ...)  FW_LOG_AT(FW_LOG_LEVEL_ERROR, printf, "[FW-ERROR ] " fmt, ##__VA_ARGS__)
+#define log_warn(fmt, ...)   FW_LOG_AT(FW_LOG_LEVEL_WARN, printf, "[FW-WARN  ] " fmt, ##__VA_ARGS__)
+#define log_debug(fmt, ...)  FW_LOG_AT(FW_LOG_LEVEL_DEBUG, printf, "[FW-DEBUG ] " fmt, ##__VA_ARGS__)
 
 #define RETURN_IF_FALSE(cond, msg, ...)                                                                                \
     do {                                                                                                               \
@@ -23,21 +36,119 @@
         }                                                                                                              \
     } while (0)
 
-#define SDO_TIMEOUT_US 60000U
-#define SDO_POLL_US     1000U
+#ifndef CONFIG_DEMO_MASTER_SDO_SLOW_TIMEOUT_MS
+#define CONFIG_DEMO_MASTER_SDO_SLOW_TIMEOUT_MS 20000
+#endif
+
+/* Start erases the target bank and finalize closes OTA; both answer only once that is done. */
+#define FW_SLOW_TIMEOUT_MS ((uint16_t)CONFIG_DEMO_MASTER_SDO_SLOW_TIMEOUT_MS)
+
+/* Most reads queued in one fw_sdo_read_batch: the 16 counters of 0x2101. */
+#define FW_SDO_BATCH_MAX 16U
+
+#ifndef CONFIG_DEMO_MASTER_READAHEAD_VBUF_BYTES
+#define CONFIG_DEMO_MASTER_READAHEAD_VBUF_BYTES 4096
+#endif
+
+#define FW_READAHEAD_MAX_DEPTH  8U
+#define FW_READAHEAD_POLL_MS    20U
+#define FW_READAHEAD_WAIT_MS    2000U
+#define FW_READAHEAD_STACK      3072U
+#define FW_READAHEAD_PRIORITY   4U
+
+/* The slave re-hashes the written bank after finalize; a 1 MB SHA-256 readback takes well under a second. */
+#define FW_VERIFY_POLL_MS 20U
+#define FW_VERIFY_WAIT_MS 5000U
+
+/* Image header + first segment header + esp_app_desc_t: the span a slave holds back and checks before erasing. */
+#define FW_APP_HEAD_BYTES 288U
+
+/* Framed sessions give up once this many chunks in a row got no answer; the node is likely gone. */
+#define FW_MAX_LOST_IN_ROW 8U
+
+/* A slave whose flash writer is behind refuses the chunk untouched (out of memory); it is sent again. */
+#define FW_SLAVE_BUSY_WAIT_MS 10U
+#define FW_SLAVE_BUSY_RETRIES 50U
 
 enum {
     FW_META_INDEX = 0x1F57,
     FW_CTRL_INDEX = 0x1F51,
     FW_DATA_INDEX = 0x1F50,
-    FW_STATUS_INDEX = 0x1F5A
+    FW_STATUS_INDEX = 0x1F5A,
+    FW_IDENTITY_INDEX = 0x1018,
+    FW_RUNNING_IMAGE_INDEX = 0x2100,
+    FW_SLAVE_PERF_INDEX = 0x2101,
+    FW_SLAVE_HOLES_INDEX = 0x2102
 };
 
+enum {
+    FW_IDENTITY_SUB_REVISION = 3,
+    FW_RUNNING_SUB_BYTES = 1,
+    FW_RUNNING_SUB_CRC = 2,
+    FW_RUNNING_SUB_SHA256 = 3,
+    FW_STATUS_SUB_VERIFY = 2,
+    FW_DATA_SUB_STREAM = 1,
+    FW_DATA_SUB_FRAMED = 2,
+    FW_HOLES_SUB_MISSING = 1,
+    FW_HOLES_SUB_RANGES = 3
+};
+
+/* Values of the slave's 0x1F5A:02. */
+enum {
+    FW_VERIFY_NONE = 0,
+    FW_VERIFY_RUNNING = 1,
+    FW_VERIFY_PASSED = 2,
+    FW_VERIFY_FAILED = 3
+};
+
+/* Sub-indices 1..14 of the slave's 0x2101 record, in order. */
+static const char *const s_slave_perf_names[] = {
+    "chunks", "bytes", "sdo writes", "write min us", "write avg us", "write max us", "erase us",
+    "crc us", "idle ms", "metadata ms", "erasing ms", "receiving ms", "verifying ms", "ready ms"};
+
+/* Sub-indices 0x15/0x16: sector diff results, only non-zero with skip-identical enabled on the slave. */
+#define FW_SLAVE_PERF_SECTORS_SUB 0x15U
+static const char *const s_slave_sector_names[] = {"sectors same", "sectors prog"};
+
 typedef struct {
     FILE *file;
+    char *ioBuffer;
     size_t size;
 } fw_payload_t;
 
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t offset;
+} fw_chunk_slot_t;
+
+/*
+ * Data of one SDO download. The SDO client pulls it straight into its own buffer
+ * (CO_SDOclientDownloadSource), from memory or from the image file at fileOffset.
+ */
+typedef struct {
+    const uint8_t *data; /* NULL: read from file */
+    FILE *file;
+    size_t fileOffset;
+    size_t len;
+    size_t done;
+    bool failed;
+} fw_source_t;
+
+/* Producer/consumer state shared between the read-ahead task and the sender. */
+typedef struct {
+    FILE *file;
+    size_t size;
+    size_t chunkCapacity;
+    uint8_t depth;
+    uint8_t *pool;
+    fw_chunk_slot_t slots[FW_READAHEAD_MAX_DEPTH];
+    QueueHandle_t freeQueue;
+    QueueHandle_t readyQueue;
+    SemaphoreHandle_t done;
+    volatile bool abort;
+} fw_readahead_t;
+
 typedef struct __attribute__((packed)) {
     uint32_t imageBytes;
     uint16_t crc;
@@ -45,95 +156,284 @@ typedef struct __attribute__((packed)) {
     uint8_t bank;
 } fw_metadata_record_t;
 
+/* 0x1F57:02; the slave checks this digest instead of running a CRC16 over every byte. */
+typedef struct __attribute__((packed)) {
+    uint8_t type;
+    uint8_t reserved[3];
+    uint8_t digest[FW_DIGEST_MAX_LEN];
+} fw_digest_record_t;
+
 enum {
     FW_CTRL_CMD_START = 0x01
 };
 
+/* One read in a fw_sdo_read_batch. */
+typedef struct {
+    uint16_t index;
+    uint8_t subIndex;
+    void *buf;
+    size_t len;
+    const char *label;
+    bool ok;
+} fw_sdo_read_t;
+
 static CO_SDOclient_t *s_sdo_client = NULL;
-static uint8_t s_bound_node_id = 0U;
+static uint8_t s_target_node = 0U;
+static CO_SDO_abortCode_t s_last_abort = CO_SDO_AB_NONE;
+/* Per session: chunks carry their offset (0x1F50:02), and how many of them went unanswered. */
+static bool s_framed = false;
+static uint32_t s_lost_chunks = 0U;
+static uint32_t s_lost_in_row = 0U;
+/* Stream offset whose arrival makes the slave erase its slot (image header or bundle table); 0 = at start. */
+static uint32_t s_erase_at = 0U;
+/* Chunk pacing against the driver's bulk budget: saved-up bits and time waited this session. */
+static int64_t s_pace_tokens = 0;
+static int64_t s_pace_refill_us = 0;
+static uint64_t s_pace_wait_us = 0U;
 
 static bool fw_master_select_target(uint8_t nodeId);
-static bool fw_sdo_download(uint16_t index, uint8_t subIndex, const uint8_t *data, size_t len, const char *label);
+static bool fw_sdo_download(uint16_t index, uint8_t subIndex, const uint8_t *data, size_t len, uint16_t timeoutMs,
+                            const char *label);
+static bool fw_sdo_download_parts(uint16_t index, uint8_t subIndex, const uint8_t *head, size_t headLen,
+                                  fw_source_t *src, uint16_t timeoutMs, const char *label);
+static bool fw_sdo_upload(uint16_t index, uint8_t subIndex, uint8_t *buf, size_t len, size_t *readLen,
+                          const char *label);
+static bool fw_sdo_should_retry(uint8_t attempt, uint8_t retries, const char *label);
 
 bool fw_master_bind_sdo_client(CO_SDOclient_t *client) {
     s_sdo_client = client;
-    s_bound_node_id = 0U;
+    s_target_node = 0U;
     return s_sdo_client != NULL;
 }
 
+/* Node the following requests go to; the SDO queue sets its clients up per request. */
 static bool fw_master_select_target(uint8_t nodeId) {
-    RETURN_IF_FALSE(s_sdo_client != NULL, "SDO client not available");
-    if (s_bound_node_id == nodeId) {
+    RETURN_IF_FALSE(nodeId >= 1U && nodeId <= 127U, "Node id %u is out of range", nodeId);
+    s_target_node = nodeId;
+    return true;
+}
+
+static fw_source_t fw_source_mem(const uint8_t *data, size_t len) {
+    return (fw_source_t){.data = data, .len = len};
+}
+
+static fw_source_t fw_source_file(FILE *file, size_t offset, size_t len) {
+    return (fw_source_t){.file = file, .fileOffset = offset, .len = len};
+}
+
+/* Called by the SDO client with free space in its buffer. */
+static size_t fw_source_pull(void *object, uint8_t *buf, size_t count) {
+    fw_source_t *src = (fw_source_t *)object;
+    size_t take = src->len - src->done < count ? src->len - src->done : count;
+    if (src->data != NULL) {
+        memcpy(buf, src->data + src->done, take);
+    } else if (fread(buf, 1, take, src->file) != take) {
+        src->failed = true;
+        return 0U;
+    }
+    src->done += take;
+    return take;
+}
+
+/* Start over, so a chunk can go out again after a fallback. */
+static bool fw_source_rewind(fw_source_t *src) {
+    src->done = 0U;
+    src->failed = false;
+    if (src->data != NULL || src->len == 0U) {
         return true;
     }
+    return ftell(src->file) == (long)src->fileOffset || fseek(src->file, (long)src->fileOffset, SEEK_SET) == 0;
+}
 
-    CO_SDO_return_t ret =
-        CO_SDOclient_setup(s_sdo_client, CO_CAN_ID_SDO_CLI + nodeId, CO_CAN_ID_SDO_SRV + nodeId, nodeId);
-    RETURN_IF_FALSE(ret == CO_SDO_RT_ok_communicationEnd, "CO_SDOclient_setup failed (ret=%d)", ret);
+static bool fw_sdo_download(uint16_t index, uint8_t subIndex, const uint8_t *data, size_t len, uint16_t timeoutMs,
+                            const char *label) {
+    fw_source_t src = fw_source_mem(data, len);
+    return fw_sdo_download_parts(index, subIndex, NULL, 0U, &src, timeoutMs, label);
+}
 
-    s_bound_node_id = nodeId;
-    return true;
+static void fw_sdo_note_abort(const fw_sdo_req_t *req) {
+    FW_TRACE(FW_EV_SDO_ABORT, ((uint32_t)req->index << 8) | req->subIndex, req->abortCode);
+    s_last_abort = req->abortCode;
+    fw_stats_note_abort();
+}
+
+/* One download of head followed by src; head has to fit the client's empty buffer. */
+static bool fw_sdo_download_parts(uint16_t index, uint8_t subIndex, const uint8_t *head, size_t headLen,
+                                  fw_source_t *src, uint16_t timeoutMs, const char *label) {
+    RETURN_IF_FALSE(fw_source_rewind(src), "Cannot seek to the %s data", label);
+
+    fw_sdo_req_t req = {.nodeId = s_target_node,
+                        .index = index,
+                        .subIndex = subIndex,
+                        .data = head,
+                        .len = headLen,
+                        .source = fw_source_pull,
+                        .sourceObject = src,
+                        .sourceLen = src->len,
+                        .timeoutMs = timeoutMs};
+    s_last_abort = CO_SDO_AB_NONE;
+    if (fw_sdo_queue_run(&req, 1U)) {
+        return true;
+    }
+    if (src->failed) {
+        log_error("Short read from the firmware file for %s\n", label);
+    } else {
+        log_error("SDO download for %s aborted (0x%08X)\n", label, req.abortCode);
+    }
+    fw_sdo_note_abort(&req);
+    return false;
+}
+
+static fw_sdo_req_t fw_sdo_read_req(uint16_t index, uint8_t subIndex, void *buf, size_t len) {
+    return (fw_sdo_req_t){.nodeId = s_target_node,
+                          .index = index,
+                          .subIndex = subIndex,
+                          .upload = true,
+                          .buf = (uint8_t *)buf,
+                          .bufLen = len,
+                          .timeoutMs = FW_SDO_TIMEOUT_ADAPTIVE};
 }
 
-static bool fw_sdo_download(uint16_t index, uint8_t subIndex, const uint8_t *data, size_t len, const char *label) {
-    RETURN_IF_FALSE(s_sdo_client != NULL, "SDO client not available");
+static bool fw_sdo_upload(uint16_t index, uint8_t subIndex, uint8_t *buf, size_t len, size_t *readLen,
+                          const char *label) {
+    fw_sdo_req_t req = fw_sdo_read_req(index, subIndex, buf, len);
+    s_last_abort = CO_SDO_AB_NONE;
+    if (!fw_sdo_queue_run(&req, 1U)) {
+        log_error("SDO upload for %s aborted (0x%08X)\n", label, req.abortCode);
+        fw_sdo_note_abort(&req);
+        return false;
+    }
+    *readLen = req.transferred;
+    return true;
+}
 
-    CO_SDO_return_t ret = CO_SDOclientDownloadInitiate(s_sdo_client, index, subIndex, len, SDO_TIMEOUT_US, false);
-    RETURN_IF_FALSE(ret == CO_SDO_RT_ok_communicationEnd, "SDO init failed for %s (ret=%d)", label, ret);
+/* Aborts that say the transfer got lost or garbled, not that the slave refused it. */
+static bool fw_last_abort_is_transport(void) {
+    switch (s_last_abort) {
+    case CO_SDO_AB_TIMEOUT:
+    case CO_SDO_AB_TOGGLE_BIT:
+    case CO_SDO_AB_CMD:
+    case CO_SDO_AB_GENERAL:
+        return true;
+    default:
+        return false;
+    }
+}
 
-    size_t totalWritten = 0U;
-    bool_t bufferPartial = false;
-    if (len > 0U) {
-        size_t written = CO_SDOclientDownloadBufWrite(s_sdo_client, data, len);
-        totalWritten = written;
-        bufferPartial = totalWritten < len;
+/*
+ * Only transport-level aborts are worth repeating, and only for transfers that leave the
+ * slave in the same state when applied twice: metadata writes and reads. Start erases the
+ * bank and finalize ends OTA, so those never retry. Stream chunks advance the slave's offset;
+ * framed chunks name theirs and are resent from the slave's hole list instead (fw_fill_holes).
+ */
+static bool fw_sdo_should_retry(uint8_t attempt, uint8_t retries, const char *label) {
+    if (attempt >= retries || !fw_last_abort_is_transport()) {
+        return false;
     }
+    log_warn("Retrying %s (%u/%u)\n", label, (unsigned)attempt + 1U, retries);
+    FW_TRACE(FW_EV_SDO_RETRY, s_last_abort, attempt + 1U);
+    fw_stats_note_retry();
+    return true;
+}
 
-    do {
-        CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
-        ret = CO_SDOclientDownload(s_sdo_client, SDO_POLL_US, false, bufferPartial, &abortCode, NULL, NULL);
-        if (ret < 0) {
-            log_error("SDO download for %s aborted (0x%08X)", label, abortCode);
+static bool fw_sdo_download_idempotent(uint16_t index, uint8_t subIndex, const uint8_t *data, size_t len,
+                                       uint8_t retries, const char *label) {
+    for (uint8_t attempt = 0U;; attempt++) {
+        if (fw_sdo_download(index, subIndex, data, len, FW_SDO_TIMEOUT_ADAPTIVE, label)) {
+            return true;
+        }
+        if (!fw_sdo_should_retry(attempt, retries, label)) {
             return false;
         }
+    }
+}
 
-        if (ret > 0) {
-            if (bufferPartial && totalWritten < len) {
-                size_t written = CO_SDOclientDownloadBufWrite(s_sdo_client, data + totalWritten, len - totalWritten);
-                totalWritten += written;
-                bufferPartial = totalWritten < len;
-            }
-            vTaskDelay(pdMS_TO_TICKS(1));
+static bool fw_sdo_upload_idempotent(uint16_t index, uint8_t subIndex, uint8_t *buf, size_t len, size_t *readLen,
+                                     uint8_t retries, const char *label) {
+    for (uint8_t attempt = 0U;; attempt++) {
+        if (fw_sdo_upload(index, subIndex, buf, len, readLen, label)) {
+            return true;
         }
-    } while (ret > 0);
+        if (!fw_sdo_should_retry(attempt, retries, label)) {
+            return false;
+        }
+    }
+}
 
-    return true;
+/*
+ * Independent reads queued together run back to back on the bus instead of one per wake-up
+ * of this task. Reads that fail with a transport abort get their retries one by one after
+ * the batch. A read only counts as ok when exactly len bytes came back.
+ */
+static bool fw_sdo_read_batch(fw_sdo_read_t *reads, size_t count, uint8_t retries) {
+    /* Static: one session at a time, and 16 requests are too much for the caller's stack. */
+    static fw_sdo_req_t reqs[FW_SDO_BATCH_MAX];
+    RETURN_IF_FALSE(count <= FW_SDO_BATCH_MAX, "%zu reads do not fit one batch", count);
+
+    for (size_t i = 0; i < count; i++) {
+        reqs[i] = fw_sdo_read_req(reads[i].index, reads[i].subIndex, reads[i].buf, reads[i].len);
+    }
+    (void)fw_sdo_queue_run(reqs, count);
+
+    bool all = true;
+    for (size_t i = 0; i < count; i++) {
+        size_t readLen = reqs[i].transferred;
+        bool ok = reqs[i].ok;
+        if (!ok) {
+            log_error("SDO upload for %s aborted (0x%08X)\n", reads[i].label, reqs[i].abortCode);
+            fw_sdo_note_abort(&reqs[i]);
+        }
+        for (uint8_t attempt = 0U; !ok && fw_sdo_should_retry(attempt, retries, reads[i].label); attempt++) {
+            ok = fw_sdo_upload(reads[i].index, reads[i].subIndex, (uint8_t *)reads[i].buf, reads[i].len, &readLen,
+                               reads[i].label);
+        }
+        reads[i].ok = ok && readLen == reads[i].len;
+        all = all && reads[i].ok;
+    }
+    return all;
 }
 
-static bool fw_open_payload(const fw_upload_plan_t *plan, fw_payload_t *payload) {
-    payload->file = fopen(plan->firmwarePath, "rb");
-    RETURN_IF_FALSE(payload->file != NULL, "Cannot open firmware file %s", plan->firmwarePath);
+/* Ask the slave what it runs; true only when size and digest prove it is the image we would send. */
+static bool fw_slave_runs_image(const fw_upload_plan_t *plan, size_t imageBytes, uint16_t crc,
+                                const fw_catalog_entry_t *image) {
+    RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Unable to reach node %u", plan->targetNodeId);
 
-    if (fseek(payload->file, 0, SEEK_END) != 0) {
-        fclose(payload->file);
-        payload->file = NULL;
-        log_error("Failed to seek to end of %s\n", plan->firmwarePath);
+    uint32_t revision = 0U;
+    uint32_t runningBytes = 0U;
+    uint16_t runningCrc = 0U;
+    uint8_t runningSha[FW_CATALOG_SHA256_LEN] = {0};
+    size_t readLen = 0U;
+
+    fw_sdo_read_t reads[] = {
+        {FW_IDENTITY_INDEX, FW_IDENTITY_SUB_REVISION, &revision, sizeof(revision), "identity revision", false},
+        {FW_RUNNING_IMAGE_INDEX, FW_RUNNING_SUB_BYTES, &runningBytes, sizeof(runningBytes), "running image size",
+         false},
+        {FW_RUNNING_IMAGE_INDEX, FW_RUNNING_SUB_CRC, &runningCrc, sizeof(runningCrc), "running image crc", false}};
+    (void)fw_sdo_read_batch(reads, sizeof(reads) / sizeof(reads[0]), plan->sdoRetries);
+    if (reads[0].ok) {
+        log_master("Slave %u reports revision 0x%08" PRIX32 "\n", plan->targetNodeId, revision);
+    }
+    if (!reads[1].ok || !reads[2].ok) {
+        log_warn("Slave %u does not publish its running image; transferring\n", plan->targetNodeId);
         return false;
     }
 
-    long fileSize = ftell(payload->file);
-    RETURN_IF_FALSE(fileSize > 0, "Firmware file %s is empty", plan->firmwarePath);
-
-    if (fseek(payload->file, 0, SEEK_SET) != 0) {
-        fclose(payload->file);
-        payload->file = NULL;
-        log_error("Failed to rewind file %s\n", plan->firmwarePath);
+    log_master("Slave runs %" PRIu32 " bytes crc 0x%04X; candidate is %zu bytes crc 0x%04X\n", runningBytes,
+               runningCrc, imageBytes, crc);
+    if (runningBytes != imageBytes || runningCrc != crc) {
         return false;
     }
+    if (image == NULL) {
+        return true;
+    }
 
-    payload->size = (size_t)fileSize;
-    log_master("Prepared %zu-byte firmware image from %s\n", payload->size, plan->firmwarePath);
-    return true;
+    /* The catalog holds a SHA-256 as well, so a CRC16 collision cannot skip a real update. */
+    if (!fw_sdo_upload_idempotent(FW_RUNNING_IMAGE_INDEX, FW_RUNNING_SUB_SHA256, runningSha, sizeof(runningSha),
+                                  &readLen, plan->sdoRetries, "running image sha256") ||
+        readLen != sizeof(runningSha)) {
+        return false;
+    }
+    return memcmp(runningSha, image->sha256, sizeof(runningSha)) == 0;
 }
 
 static void fw_close_payload(fw_payload_t *payload) {
@@ -141,43 +441,113 @@ static void fw_close_payload(fw_payload_t *payload) {
         fclose(payload->file);
         payload->file = NULL;
     }
+    free(payload->ioBuffer);
+    payload->ioBuffer = NULL;
     payload->size = 0U;
 }
 
-static uint16_t fw_crc16_update(uint16_t crc, const uint8_t *data, size_t len) {
-    for (size_t i = 0; i < len; i++) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (int bit = 0; bit < 8; bit++) {
-            if (crc & 0x8000U) {
-                crc = (uint16_t)((crc << 1) ^ 0x1021U);
-            } else {
-                crc <<= 1;
-            }
-        }
+static bool fw_open_payload(const char *path, const fw_catalog_entry_t *image, fw_payload_t *payload) {
+    payload->file = fopen(path, "rb");
+    RETURN_IF_FALSE(payload->file != NULL, "Cannot open firmware file %s", path);
+
+    /* Large fully buffered reads keep SPIFFS page lookups off the per-chunk path. */
+    payload->ioBuffer = (char *)malloc(CONFIG_DEMO_MASTER_READAHEAD_VBUF_BYTES);
+    if (payload->ioBuffer == NULL ||
+        setvbuf(payload->file, payload->ioBuffer, _IOFBF, CONFIG_DEMO_MASTER_READAHEAD_VBUF_BYTES) != 0) {
+        log_warn("Falling back to default stdio buffering for %s\n", path);
+        free(payload->ioBuffer);
+        payload->ioBuffer = NULL;
     }
-    return crc;
+
+    if (image != NULL) {
+        /* The catalog already knows the size; skip the seek-to-end round trip through SPIFFS. */
+        payload->size = image->imageBytes;
+        log_master("Prepared %zu-byte firmware image from %s (catalog)\n", payload->size, path);
+        return true;
+    }
+
+    if (fseek(payload->file, 0, SEEK_END) != 0) {
+        fw_close_payload(payload);
+        log_error("Failed to seek to end of %s\n", path);
+        return false;
+    }
+
+    long fileSize = ftell(payload->file);
+    if (fileSize <= 0) {
+        fw_close_payload(payload);
+        log_error("Firmware file %s is empty\n", path);
+        return false;
+    }
+
+    if (fseek(payload->file, 0, SEEK_SET) != 0) {
+        fw_close_payload(payload);
+        log_error("Failed to rewind file %s\n", path);
+        return false;
+    }
+
+    payload->size = (size_t)fileSize;
+    log_master("Prepared %zu-byte firmware image from %s\n", payload->size, path);
+    return true;
 }
 
-static bool fw_crc16_stream(FILE *file, size_t fileSize, uint8_t *scratch, size_t scratchLen, uint16_t *outCrc) {
+/* One read of the file for whatever the catalog could not supply; pass NULL/NONE for what is known. */
+static bool fw_hash_stream(FILE *file, size_t fileSize, uint8_t *scratch, size_t scratchLen, uint16_t *outCrc,
+                           fw_digest_type_t digestType, uint8_t *outDigest) {
     RETURN_IF_FALSE(file != NULL, "Firmware file handle is NULL");
     RETURN_IF_FALSE(scratch != NULL && scratchLen > 0U, "Scratch buffer not available");
 
+    fw_digest_t digest;
+    RETURN_IF_FALSE(fw_digest_begin(&digest, digestType), "Digest type %u not available", (unsigned)digestType);
+
     uint16_t crc = 0xFFFFU;
     size_t remaining = fileSize;
     while (remaining > 0U) {
         size_t chunk = remaining < scratchLen ? remaining : scratchLen;
         size_t read = fread(scratch, 1, chunk, file);
-        RETURN_IF_FALSE(read == chunk, "Short read while computing CRC");
-        crc = fw_crc16_update(crc, scratch, chunk);
+        if (read != chunk) {
+            fw_digest_abort(&digest);
+            log_error("Short read while computing CRC\n");
+            return false;
+        }
+        if (outCrc != NULL) {
+            crc = fw_crc16_update(crc, scratch, chunk);
+        }
+        fw_digest_update(&digest, scratch, chunk);
         remaining -= chunk;
     }
+    (void)fw_digest_finish(&digest, outDigest);
 
     RETURN_IF_FALSE(fseek(file, 0, SEEK_SET) == 0, "Failed to rewind firmware after CRC pass");
-    *outCrc = crc;
+    if (outCrc != NULL) {
+        *outCrc = crc;
+    }
+    return true;
+}
+
+/* Read the bundle table up front so a malformed file is refused before the slave erases anything. */
+/* tocBytes: size of the table, the part of the stream the slave collects before it erases. */
+static bool fw_check_bundle(fw_payload_t *payload, uint32_t *tocBytes) {
+    uint8_t tocBuf[FW_BUNDLE_MAX_TOC_BYTES];
+    size_t got = fread(tocBuf, 1, sizeof(tocBuf), payload->file);
+    RETURN_IF_FALSE(fseek(payload->file, 0, SEEK_SET) == 0, "Failed to rewind bundle");
+
+    fw_bundle_toc_t toc;
+    RETURN_IF_FALSE(fw_bundle_parse(tocBuf, got, &toc), "Bundle table is malformed");
+    *tocBytes = fw_bundle_toc_bytes(tocBuf, got);
+    RETURN_IF_FALSE(toc.totalBytes == payload->size, "Bundle table describes %" PRIu32 " bytes, file has %zu",
+                    toc.totalBytes, payload->size);
+    for (uint8_t i = 0; i < toc.count; i++) {
+        const fw_bundle_section_t *section = &toc.sections[i];
+        log_master(" - section %u    : %s, %" PRIu32 " bytes, bank %u\n", (unsigned)i,
+                   fw_bundle_section_name(section->type), section->size, section->bank);
+    }
     return true;
 }
 
-static bool send_metadata_to_slave(const fw_upload_plan_t *plan, size_t imageBytes, uint16_t crc) {
+static bool send_metadata_to_slave(const fw_upload_plan_t *plan, size_t imageBytes, uint16_t crc,
+                                   const uint8_t *digest) {
+    fw_stats_phase(FW_PHASE_METADATA);
+    FW_TRACE(FW_EV_META_TX, imageBytes, crc);
     log_master("Sending metadata to slave node %u\n", plan->targetNodeId);
     log_master(" - image bytes : %zu\n", imageBytes);
     log_master(" - crc         : 0x%04X\n", crc);
@@ -191,62 +561,475 @@ static bool send_metadata_to_slave(const fw_upload_plan_t *plan, size_t imageByt
         .imageType = (uint8_t)plan->type,
         .bank = plan->targetBank};
 
-    return fw_sdo_download(FW_META_INDEX, 1U, (const uint8_t *)&meta, sizeof(meta), "metadata");
+    if (!fw_sdo_download_idempotent(FW_META_INDEX, 1U, (const uint8_t *)&meta, sizeof(meta), plan->sdoRetries,
+                                    "metadata")) {
+        return false;
+    }
+    if (plan->digestType == FW_DIGEST_NONE) {
+        return true;
+    }
+
+    fw_digest_record_t record = {.type = (uint8_t)plan->digestType};
+    memcpy(record.digest, digest, fw_digest_length(plan->digestType));
+    log_master(" - digest      : %s\n", plan->digestType == FW_DIGEST_SHA256 ? "sha256" : "crc32");
+    if (fw_sdo_download_idempotent(FW_META_INDEX, 2U, (const uint8_t *)&record, sizeof(record), plan->sdoRetries,
+                                   "digest")) {
+        return true;
+    }
+    /* Older slaves only know sub 1; they still verify the CRC16. */
+    if (s_last_abort == CO_SDO_AB_SUB_UNKNOWN) {
+        log_warn("Slave has no digest support; relying on CRC16\n");
+        return true;
+    }
+    return false;
 }
 
 static bool send_start_command(const fw_upload_plan_t *plan) {
+    fw_stats_phase(FW_PHASE_START);
+    FW_TRACE(FW_EV_START_TX, plan->type, plan->targetBank);
     log_master("Issuing start command through object 0x1F51\n");
     RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Unable to reach node %u", plan->targetNodeId);
 
     const uint8_t controlPayload[3] = {FW_CTRL_CMD_START, (uint8_t)plan->type, plan->targetBank};
-    return fw_sdo_download(FW_CTRL_INDEX, 1U, controlPayload, sizeof(controlPayload), "start command");
+    return fw_sdo_download(FW_CTRL_INDEX, 1U, controlPayload, sizeof(controlPayload), FW_SLOW_TIMEOUT_MS,
+                           "start command");
+}
+
+static bool fw_send_framed(fw_source_t *chunk, size_t offset, uint16_t timeoutMs) {
+    const uint8_t head[FW_RX_FRAME_HEADER_BYTES] = {(uint8_t)offset, (uint8_t)(offset >> 8), (uint8_t)(offset >> 16),
+                                                    (uint8_t)(offset >> 24)};
+    return fw_sdo_download_parts(FW_DATA_INDEX, FW_DATA_SUB_FRAMED, head, sizeof(head), chunk, timeoutMs, "chunk");
+}
+
+static bool fw_send_stream(fw_source_t *chunk, uint16_t timeoutMs) {
+    return fw_sdo_download_parts(FW_DATA_INDEX, FW_DATA_SUB_STREAM, NULL, 0U, chunk, timeoutMs, "chunk");
 }
 
-static bool send_chunk_to_slave(const fw_upload_plan_t *plan, const uint8_t *chunk, size_t len, size_t offset) {
-    log_master("Sending chunk offset %zu size %zu\n", offset, len);
+/*
+ * A framed chunk that got no answer is not fatal: the slave only counts it once it arrived
+ * complete, and fw_fill_holes sends it again later.
+ */
+static bool fw_framed_chunk_lost(size_t len, size_t offset) {
+    if (!fw_last_abort_is_transport() || ++s_lost_in_row > FW_MAX_LOST_IN_ROW) {
+        return false;
+    }
+    s_lost_chunks++;
+    log_warn("Chunk @%zu (%zu bytes) lost; it will be resent\n", offset, len);
+    return true;
+}
+
+/*
+ * Wait until the driver's bulk budget has room for every request frame of the next chunk.
+ * The driver holds back single frames on its own, but a hold in the middle of a segmented
+ * transfer counts against the slave's SDO timeout; pacing whole chunks here keeps the frames
+ * of one chunk together and lets this task sleep instead of polling a full TX buffer.
+ */
+static void fw_pace_chunk(size_t len) {
+    CO_CANmodule_t *can = s_sdo_client->CANdevTx;
+    size_t payload = len + (s_framed ? FW_RX_FRAME_HEADER_BYTES : 0U);
+    int64_t cost = (int64_t)(1U + (payload + 6U) / 7U) * CO_CAN_FRAME_BITS(8U);
+    int64_t waitFrom = esp_timer_get_time();
+    uint32_t rate = CO_CANbulkBitsPerSecond(can);
+
+    while (rate != 0U) {
+        int64_t now = esp_timer_get_time();
+        s_pace_tokens += (now - s_pace_refill_us) * (int64_t)rate / 1000000;
+        s_pace_refill_us = now;
+        if (s_pace_tokens >= cost) {
+            /* Saving up is capped at one chunk so an idle spell does not turn into a burst. */
+            s_pace_tokens = 0;
+            break;
+        }
+        TickType_t ticks = pdMS_TO_TICKS((uint32_t)((cost - s_pace_tokens) * 1000 / rate) + 1U);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+        rate = CO_CANbulkBitsPerSecond(can);
+    }
+    int64_t waited = esp_timer_get_time() - waitFrom;
+    if (rate == 0U) {
+        s_pace_refill_us = esp_timer_get_time();
+    } else if (waited > 1000) {
+        FW_TRACE(FW_EV_PACE, (uint32_t)waited, rate / 1000U);
+        s_pace_wait_us += (uint64_t)waited;
+    }
+}
+
+static bool send_chunk_to_slave(const fw_upload_plan_t *plan, fw_source_t *chunk, size_t offset) {
+    size_t len = chunk->len;
+    log_debug("Sending chunk offset %zu size %zu\n", offset, len);
     RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Unable to reach node %u", plan->targetNodeId);
-    return fw_sdo_download(FW_DATA_INDEX, 1U, chunk, len, "chunk");
+    fw_pace_chunk(len);
+    FW_TRACE(FW_EV_CHUNK_TX, offset, len);
+    /* The slave erases its slot before it answers this one, so it must not time out or feed the RTT estimate. */
+    uint16_t timeoutMs =
+        offset < s_erase_at && offset + len >= s_erase_at ? FW_SLOW_TIMEOUT_MS : FW_SDO_TIMEOUT_ADAPTIVE;
+    int64_t sentAt = esp_timer_get_time();
+    bool sent = s_framed ? fw_send_framed(chunk, offset, timeoutMs) : fw_send_stream(chunk, timeoutMs);
+    /* A slave without 0x1F50:02 turns the session back to stream chunks on the first one. */
+    if (!sent && s_framed && offset == 0U &&
+        (s_last_abort == CO_SDO_AB_SUB_UNKNOWN || s_last_abort == CO_SDO_AB_NOT_EXIST)) {
+        log_warn("Node %u has no framed chunks (0x1F50:02); streaming in order\n", plan->targetNodeId);
+        s_framed = false;
+        sent = fw_send_stream(chunk, timeoutMs);
+    }
+    for (uint8_t busy = 0U; !sent && s_last_abort == CO_SDO_AB_OUT_OF_MEM && busy < FW_SLAVE_BUSY_RETRIES; busy++) {
+        TickType_t ticks = pdMS_TO_TICKS(FW_SLAVE_BUSY_WAIT_MS);
+        FW_TRACE(FW_EV_SDO_RETRY, s_last_abort, busy + 1U);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+        sent = s_framed ? fw_send_framed(chunk, offset, timeoutMs) : fw_send_stream(chunk, timeoutMs);
+    }
+    if (!sent) {
+        if (offset < FW_APP_HEAD_BYTES && s_last_abort == CO_SDO_AB_INVALID_VALUE) {
+            log_error("Node %u refused the image header; check its log for chip id or project mismatch\n",
+                      plan->targetNodeId);
+        }
+        return s_framed && !chunk->failed && fw_framed_chunk_lost(len, offset);
+    }
+    s_lost_in_row = 0U;
+    FW_TRACE(FW_EV_CHUNK_DONE, offset, esp_timer_get_time() - sentAt);
+    fw_stats_add_bytes((uint32_t)len);
+    return true;
+}
+
+/*
+ * A slave with readback verification acknowledges finalize before it has checked flash and
+ * only switches partitions once the check passes. Slaves without 0x1F5A:02 are done as soon
+ * as finalize is acknowledged.
+ */
+static bool fw_wait_slave_verify(const fw_upload_plan_t *plan) {
+    for (uint32_t waitedMs = 0U;; waitedMs += FW_VERIFY_POLL_MS) {
+        uint8_t state = FW_VERIFY_NONE;
+        size_t readLen = 0U;
+        if (!fw_sdo_upload_idempotent(FW_STATUS_INDEX, FW_STATUS_SUB_VERIFY, &state, sizeof(state), &readLen,
+                                      plan->sdoRetries, "verify state")) {
+            return s_last_abort == CO_SDO_AB_SUB_UNKNOWN || s_last_abort == CO_SDO_AB_NOT_EXIST;
+        }
+        FW_TRACE(FW_EV_VERIFY_POLL, state, waitedMs);
+        switch (state) {
+        case FW_VERIFY_RUNNING:
+            break;
+        case FW_VERIFY_FAILED:
+            log_error("Slave %u rejected the image on flash readback\n", plan->targetNodeId);
+            return false;
+        case FW_VERIFY_PASSED:
+            log_master("Slave %u verified the written image after %" PRIu32 " ms\n", plan->targetNodeId, waitedMs);
+            return true;
+        default:
+            return true;
+        }
+        if (waitedMs >= FW_VERIFY_WAIT_MS) {
+            log_error("Slave %u still verifying after %u ms\n", plan->targetNodeId, (unsigned)FW_VERIFY_WAIT_MS);
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(FW_VERIFY_POLL_MS));
+    }
 }
 
 static bool send_finalize_request(const fw_upload_plan_t *plan, uint16_t crc) {
+    fw_stats_phase(FW_PHASE_FINALIZE);
+    FW_TRACE(FW_EV_FINALIZE_TX, crc, 0U);
     log_master("Sending finalize request with crc 0x%04X\n", crc);
     RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Unable to reach node %u", plan->targetNodeId);
     uint8_t crcBytes[2] = {(uint8_t)(crc & 0xFFU), (uint8_t)(crc >> 8)};
-    return fw_sdo_download(FW_STATUS_INDEX, 1U, crcBytes, sizeof(crcBytes), "finalize request");
+    return fw_sdo_download(FW_STATUS_INDEX, 1U, crcBytes, sizeof(crcBytes), FW_SLOW_TIMEOUT_MS,
+                           "finalize request") &&
+           fw_wait_slave_verify(plan);
 }
 
-static bool fw_stream_payload(const fw_upload_plan_t *plan,
-                              fw_payload_t *payload,
-                              uint8_t *chunkBuffer,
-                              size_t chunkCapacity) {
+/* The SDO client reads every chunk straight from the file into its buffer. */
+static bool fw_stream_payload(const fw_upload_plan_t *plan, fw_payload_t *payload, size_t chunkCapacity) {
     RETURN_IF_FALSE(payload->file != NULL, "Firmware file handle is NULL");
-    RETURN_IF_FALSE(chunkBuffer != NULL && chunkCapacity > 0U, "Chunk buffer missing");
+    RETURN_IF_FALSE(chunkCapacity > 0U, "Chunk size must be greater than zero");
+    fw_stats_phase(FW_PHASE_DATA);
 
     size_t offset = 0;
     while (offset < payload->size) {
         size_t remaining = payload->size - offset;
-        size_t toRead = remaining < chunkCapacity ? remaining : chunkCapacity;
-        size_t read = fread(chunkBuffer, 1, toRead, payload->file);
-        RETURN_IF_FALSE(read == toRead, "Short read while streaming firmware");
-        if (!send_chunk_to_slave(plan, chunkBuffer, read, offset)) {
+        size_t take = remaining < chunkCapacity ? remaining : chunkCapacity;
+        fw_source_t chunk = fw_source_file(payload->file, offset, take);
+        if (!send_chunk_to_slave(plan, &chunk, offset)) {
             return false;
         }
+        offset += chunk.len;
+    }
+    return true;
+}
+
+/* Producer: keeps every free slot filled from the file so the sender never waits on storage. */
+static void fw_readahead_task(void *arg) {
+    fw_readahead_t *ra = (fw_readahead_t *)arg;
+    size_t offset = 0U;
+
+    while (offset < ra->size && !ra->abort) {
+        fw_chunk_slot_t *slot = NULL;
+        if (xQueueReceive(ra->freeQueue, &slot, pdMS_TO_TICKS(FW_READAHEAD_POLL_MS)) != pdTRUE) {
+            continue;
+        }
+        size_t remaining = ra->size - offset;
+        size_t toRead = remaining < ra->chunkCapacity ? remaining : ra->chunkCapacity;
+        size_t read = fread(slot->data, 1, toRead, ra->file);
+        slot->offset = offset;
+        /* A zero-length slot tells the sender that the file could not be read. */
+        slot->len = (read == toRead) ? read : 0U;
+        (void)xQueueSend(ra->readyQueue, &slot, portMAX_DELAY);
+        if (slot->len == 0U) {
+            break;
+        }
         offset += read;
     }
+
+    xSemaphoreGive(ra->done);
+    vTaskDelete(NULL);
+}
+
+static void fw_readahead_release(fw_readahead_t *ra) {
+    if (ra->freeQueue != NULL) {
+        vQueueDelete(ra->freeQueue);
+    }
+    if (ra->readyQueue != NULL) {
+        vQueueDelete(ra->readyQueue);
+    }
+    if (ra->done != NULL) {
+        vSemaphoreDelete(ra->done);
+    }
+    free(ra->pool);
+    memset(ra, 0, sizeof(*ra));
+}
+
+static bool fw_readahead_start(fw_readahead_t *ra, fw_payload_t *payload, size_t chunkCapacity, uint8_t depth) {
+    memset(ra, 0, sizeof(*ra));
+    ra->file = payload->file;
+    ra->size = payload->size;
+    ra->chunkCapacity = chunkCapacity;
+    ra->depth = depth > FW_READAHEAD_MAX_DEPTH ? FW_READAHEAD_MAX_DEPTH : depth;
+
+    ra->pool = (uint8_t *)malloc(chunkCapacity * ra->depth);
+    ra->freeQueue = xQueueCreate(ra->depth, sizeof(fw_chunk_slot_t *));
+    ra->readyQueue = xQueueCreate(ra->depth, sizeof(fw_chunk_slot_t *));
+    ra->done = xSemaphoreCreateBinary();
+    if (ra->pool == NULL || ra->freeQueue == NULL || ra->readyQueue == NULL || ra->done == NULL) {
+        log_error("Out of memory while allocating %u read-ahead buffers\n", ra->depth);
+        fw_readahead_release(ra);
+        return false;
+    }
+
+    for (uint8_t i = 0; i < ra->depth; i++) {
+        fw_chunk_slot_t *slot = &ra->slots[i];
+        slot->data = ra->pool + ((size_t)i * chunkCapacity);
+        (void)xQueueSend(ra->freeQueue, &slot, 0);
+    }
+
+    if (xTaskCreate(fw_readahead_task, "fw_readahead", FW_READAHEAD_STACK, ra, FW_READAHEAD_PRIORITY, NULL) !=
+        pdPASS) {
+        log_error("Unable to create read-ahead task\n");
+        fw_readahead_release(ra);
+        return false;
+    }
+    return true;
+}
+
+static void fw_readahead_stop(fw_readahead_t *ra) {
+    ra->abort = true;
+    (void)xSemaphoreTake(ra->done, portMAX_DELAY);
+    fw_readahead_release(ra);
+}
+
+static bool fw_stream_payload_readahead(const fw_upload_plan_t *plan, fw_payload_t *payload) {
+    RETURN_IF_FALSE(payload->file != NULL, "Firmware file handle is NULL");
+
+    fw_stats_phase(FW_PHASE_DATA);
+    fw_readahead_t ra;
+    if (!fw_readahead_start(&ra, payload, plan->maxChunkBytes, plan->readAheadDepth)) {
+        return false;
+    }
+    log_master("Streaming with %u read-ahead buffers of %" PRIu32 " bytes\n", ra.depth, plan->maxChunkBytes);
+
+    bool ok = true;
+    size_t offset = 0U;
+    while (offset < payload->size) {
+        fw_chunk_slot_t *slot = NULL;
+        if (xQueueReceive(ra.readyQueue, &slot, pdMS_TO_TICKS(FW_READAHEAD_WAIT_MS)) != pdTRUE) {
+            log_error("Timed out waiting for firmware data at offset %zu\n", offset);
+            ok = false;
+            break;
+        }
+        if (slot->len == 0U || slot->offset != offset) {
+            log_error("Short read while streaming firmware at offset %zu\n", offset);
+            ok = false;
+            break;
+        }
+        fw_source_t chunk = fw_source_mem(slot->data, slot->len);
+        if (!send_chunk_to_slave(plan, &chunk, slot->offset)) {
+            ok = false;
+            break;
+        }
+        offset += slot->len;
+        (void)xQueueSend(ra.freeQueue, &slot, 0);
+    }
+
+    fw_readahead_stop(&ra);
+    return ok;
+}
+
+static bool fw_resend_range(const fw_upload_plan_t *plan, fw_payload_t *payload, const fw_rx_range_t *range) {
+    RETURN_IF_FALSE(range->offset < payload->size && range->length <= payload->size - range->offset,
+                    "Slave reported a hole outside the image");
+    for (size_t done = 0U; done < range->length;) {
+        size_t take = range->length - done < plan->maxChunkBytes ? range->length - done : plan->maxChunkBytes;
+        fw_source_t chunk = fw_source_file(payload->file, range->offset + done, take);
+        if (!send_chunk_to_slave(plan, &chunk, range->offset + done)) {
+            return false;
+        }
+        done += take;
+    }
+    return true;
+}
+
+/*
+ * Ask the slave what is still missing (0x2102) and send only that, until nothing is left.
+ * The slave lists at most FW_RX_MAX_RANGES holes at a time, so this may take several passes;
+ * it gives up once sdoRetries passes in a row brought no progress.
+ */
+static bool fw_fill_holes(const fw_upload_plan_t *plan, fw_payload_t *payload) {
+    uint32_t lastMissing = UINT32_MAX;
+    uint8_t idlePasses = 0U;
+    for (;;) {
+        RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Unable to reach node %u", plan->targetNodeId);
+        uint32_t missing = 0U;
+        size_t readLen = 0U;
+        if (!fw_sdo_upload_idempotent(FW_SLAVE_HOLES_INDEX, FW_HOLES_SUB_MISSING, (uint8_t *)&missing,
+                                      sizeof(missing), &readLen, plan->sdoRetries, "missing bytes") ||
+            readLen != sizeof(missing)) {
+            log_error("Slave %u cannot report missing data\n", plan->targetNodeId);
+            return false;
+        }
+        if (missing == 0U) {
+            return true;
+        }
+        if (missing >= lastMissing && ++idlePasses > plan->sdoRetries) {
+            log_error("Slave %u still misses %" PRIu32 " bytes; giving up\n", plan->targetNodeId, missing);
+            return false;
+        }
+        lastMissing = missing;
+
+        uint8_t rangeBytes[FW_RX_RANGES_BYTES];
+        if (!fw_sdo_upload_idempotent(FW_SLAVE_HOLES_INDEX, FW_HOLES_SUB_RANGES, rangeBytes, sizeof(rangeBytes),
+                                      &readLen, plan->sdoRetries, "missing ranges")) {
+            return false;
+        }
+        fw_rx_range_t ranges[FW_RX_MAX_RANGES];
+        size_t count = fw_rx_ranges_decode(rangeBytes, readLen, ranges, FW_RX_MAX_RANGES);
+        FW_TRACE(FW_EV_HOLES, count, missing);
+        log_master("Slave %u misses %" PRIu32 " bytes; resending %u ranges\n", plan->targetNodeId, missing,
+                   (unsigned)count);
+        s_lost_in_row = 0U;
+        for (size_t i = 0; i < count; i++) {
+            if (!fw_resend_range(plan, payload, &ranges[i])) {
+                return false;
+            }
+        }
+    }
+}
+
+/*
+ * Best effort: the slave reboots shortly after a good finalize, so every counter is queued
+ * at once and whatever arrives is printed.
+ */
+static void fw_pull_slave_counters(const fw_upload_plan_t *plan) {
+    if (!fw_master_select_target(plan->targetNodeId)) {
+        return;
+    }
+    const size_t perfCount = sizeof(s_slave_perf_names) / sizeof(s_slave_perf_names[0]);
+    const size_t total = perfCount + sizeof(s_slave_sector_names) / sizeof(s_slave_sector_names[0]);
+    uint32_t values[FW_SDO_BATCH_MAX] = {0};
+    fw_sdo_read_t reads[FW_SDO_BATCH_MAX];
+    for (size_t i = 0; i < total; i++) {
+        bool sector = i >= perfCount;
+        reads[i] = (fw_sdo_read_t){
+            .index = FW_SLAVE_PERF_INDEX,
+            .subIndex = sector ? (uint8_t)(FW_SLAVE_PERF_SECTORS_SUB + i - perfCount) : (uint8_t)(i + 1U),
+            .buf = &values[i],
+            .len = sizeof(values[i]),
+            .label = sector ? s_slave_sector_names[i - perfCount] : s_slave_perf_names[i]};
+    }
+    (void)fw_sdo_read_batch(reads, total, 0U);
+
+    log_master("Slave %u counters (0x2101):\n", plan->targetNodeId);
+    for (size_t i = 0; i < total; i++) {
+        /* Older slaves end the record at 0x14; nothing more to report then. */
+        if (!reads[i].ok) {
+            if (i < perfCount) {
+                log_warn("Slave counters unavailable\n");
+            }
+            return;
+        }
+        log_master(" - %-13s: %" PRIu32 "\n", reads[i].label, values[i]);
+    }
+}
+
+static void fw_log_session_stats(void) {
+    fw_transfer_stats_t st;
+    fw_stats_snapshot(&st);
+    log_master("Session %s: %" PRIu32 "/%" PRIu32 " bytes in %" PRIu32 " ms, avg %" PRIu32 " B/s, %" PRIu32
+               " aborts, %" PRIu32 " retries\n",
+               st.phase == FW_PHASE_DONE ? "done" : "failed", st.bytesSent, st.imageBytes, st.elapsedMs,
+               st.avgBytesPerSecond, st.sdoAborts, st.retries);
+    log_master(" - phases ms   : preflight %" PRIu32 ", metadata %" PRIu32 ", start %" PRIu32 ", data %" PRIu32
+               ", finalize %" PRIu32 "\n",
+               st.phaseMs[FW_PHASE_PREFLIGHT], st.phaseMs[FW_PHASE_METADATA], st.phaseMs[FW_PHASE_START],
+               st.phaseMs[FW_PHASE_DATA], st.phaseMs[FW_PHASE_FINALIZE]);
+    const CO_CANbulk_t *bulk = &s_sdo_client->CANdevTx->bulk;
+    if (bulk->loadPercent != 0U) {
+        log_master(" - bus budget  : ceiling %u%%, other nodes %u%%, chunks paced %" PRIu32 " ms, frames held %" PRIu32
+                   "\n",
+                   (unsigned)bulk->loadPercent, (unsigned)bulk->othersPercent, (uint32_t)(s_pace_wait_us / 1000U),
+                   bulk->framesHeld);
+    }
+    fw_sdo_timing_t timing;
+    if (fw_sdo_queue_node_timing(s_target_node, &timing) && timing.samples > 0U) {
+        log_master(" - sdo timing  : srtt %" PRIu32 " us, rttvar %" PRIu32 " us, timeout %" PRIu32 " ms, %" PRIu32
+                   " timeouts\n",
+                   timing.srttUs, timing.rttvarUs, timing.timeoutUs / 1000U, timing.timeouts);
+    }
+}
+
+bool fw_get_transfer_stats(fw_transfer_stats_t *out) {
+    RETURN_IF_FALSE(out != NULL, "Stats destination is NULL");
+    fw_stats_snapshot(out);
     return true;
 }
 
 bool fw_run_upload_session(const fw_upload_plan_t *plan) {
     RETURN_IF_FALSE(plan != NULL, "Upload plan is NULL");
+    RETURN_IF_FALSE(plan->maxChunkBytes > 0U, "Chunk size must be greater than zero");
     RETURN_IF_FALSE(s_sdo_client != NULL, "CANopen transport not bound");
     RETURN_IF_FALSE(fw_master_select_target(plan->targetNodeId), "Failed to select node %u", plan->targetNodeId);
 
+    /* Resolve the image through the catalog so size and CRC come from the index, not a rescan. */
+    char catalogPath[FW_CATALOG_PATH_MAX];
+    const char *firmwarePath = plan->firmwarePath;
+    (void)fw_catalog_refresh();
+    const fw_catalog_entry_t *image = NULL;
+    if (plan->firmwareVersion != NULL && plan->firmwareVersion[0] != '\0') {
+        image = fw_catalog_find_by_version(plan->firmwareVersion);
+        RETURN_IF_FALSE(image != NULL, "No catalog image provides version %s", plan->firmwareVersion);
+        RETURN_IF_FALSE(fw_catalog_entry_path(image, catalogPath, sizeof(catalogPath)), "Catalog path too long");
+        firmwarePath = catalogPath;
+        log_master("Version %s resolved to %s\n", plan->firmwareVersion, firmwarePath);
+    } else {
+        RETURN_IF_FALSE(firmwarePath != NULL, "Upload plan has neither a path nor a version");
+        image = fw_catalog_find_by_path(firmwarePath);
+    }
+
     fw_payload_t payload = {0};
-    if (!fw_open_payload(plan, &payload)) {
+    if (!fw_open_payload(firmwarePath, image, &payload)) {
+        return false;
+    }
+    uint32_t tocBytes = 0U;
+    if (plan->type == FW_IMAGE_BUNDLE && !fw_check_bundle(&payload, &tocBytes)) {
+        fw_close_payload(&payload);
         return false;
     }
 
-    RETURN_IF_FALSE(plan->maxChunkBytes > 0U, "Chunk size must be greater than zero");
     uint8_t *chunkBuffer = (uint8_t *)malloc(plan->maxChunkBytes);
     if (chunkBuffer == NULL) {
         fw_close_payload(&payload);
@@ -255,20 +1038,81 @@ bool fw_run_upload_session(const fw_upload_plan_t *plan) {
     }
 
     uint16_t crc = plan->expectedCrc;
-    if (crc == 0U) {
-        if (!fw_crc16_stream(payload.file, payload.size, chunkBuffer, plan->maxChunkBytes, &crc)) {
+    uint8_t digest[FW_DIGEST_MAX_LEN] = {0};
+    fw_digest_type_t digestToCompute = plan->digestType;
+    if (image != NULL && plan->digestType == FW_DIGEST_SHA256) {
+        memcpy(digest, image->sha256, sizeof(image->sha256));
+        digestToCompute = FW_DIGEST_NONE;
+    } else if (image != NULL && plan->digestType == FW_DIGEST_CRC32) {
+        for (size_t i = 0; i < 4U; i++) {
+            digest[i] = (uint8_t)(image->crc32 >> (8U * i));
+        }
+        digestToCompute = FW_DIGEST_NONE;
+    }
+
+    if (crc == 0U && image != NULL) {
+        crc = image->crc16;
+        log_master("Using catalog crc: 0x%04X\n", crc);
+    }
+    if (crc == 0U || digestToCompute != FW_DIGEST_NONE) {
+        bool needCrc = crc == 0U;
+        if (!fw_hash_stream(payload.file, payload.size, chunkBuffer, plan->maxChunkBytes, needCrc ? &crc : NULL,
+                            digestToCompute, digest)) {
             free(chunkBuffer);
             fw_close_payload(&payload);
             return false;
         }
-        log_master("Auto-computed crc: 0x%04X\n", crc);
-    } else {
+        if (needCrc) {
+            log_master("Auto-computed crc: 0x%04X\n", crc);
+        }
+    }
+    if (plan->expectedCrc != 0U) {
         log_master("Using provided crc: 0x%04X\n", crc);
     }
 
-    bool ok = send_metadata_to_slave(plan, payload.size, crc) && send_start_command(plan) &&
-              fw_stream_payload(plan, &payload, chunkBuffer, plan->maxChunkBytes) &&
+    fw_stats_begin((uint32_t)payload.size, plan->onProgress, plan->progressCtx);
+    fw_trace_reset();
+    FW_TRACE(FW_EV_SESSION_BEGIN, payload.size, crc);
+    /* 0x2100 describes the running app only, so bundles are always sent. */
+    if (plan->skipIfIdentical && plan->type != FW_IMAGE_BUNDLE) {
+        fw_stats_phase(FW_PHASE_PREFLIGHT);
+        if (fw_slave_runs_image(plan, payload.size, crc, image)) {
+            log_master("Slave %u already runs %s; skipping transfer\n", plan->targetNodeId, firmwarePath);
+            fw_stats_mark_skipped();
+            fw_stats_end(true);
+            free(chunkBuffer);
+            fw_close_payload(&payload);
+            return true;
+        }
+    }
+
+    s_framed = plan->framedChunks;
+    s_erase_at = plan->type == FW_IMAGE_BUNDLE ? tocBytes : plan->type == FW_IMAGE_MAIN ? FW_APP_HEAD_BYTES : 0U;
+    s_lost_chunks = 0U;
+    s_lost_in_row = 0U;
+    s_pace_tokens = 0;
+    s_pace_refill_us = esp_timer_get_time();
+    s_pace_wait_us = 0U;
+    s_sdo_client->CANdevTx->bulk.framesHeld = 0U;
+    if (s_framed && plan->maxChunkBytes % FW_RX_BLOCK_BYTES != 0U) {
+        log_warn("Chunk size %" PRIu32 " is not a multiple of %u; sending chunks in order only\n",
+                 plan->maxChunkBytes, (unsigned)FW_RX_BLOCK_BYTES);
+        s_framed = false;
+    }
+
+    bool readAhead = plan->readAheadDepth >= 2U;
+    bool ok = send_metadata_to_slave(plan, payload.size, crc, digest) && send_start_command(plan) &&
+              (readAhead ? fw_stream_payload_readahead(plan, &payload)
+                         : fw_stream_payload(plan, &payload, plan->maxChunkBytes)) &&
+              (s_lost_chunks == 0U || fw_fill_holes(plan, &payload)) &&
               send_finalize_request(plan, crc);
+    fw_stats_end(ok);
+    FW_TRACE(FW_EV_SESSION_END, ok, payload.size);
+    fw_log_session_stats();
+    fw_trace_dump("master upload");
+    if (plan->pullSlaveCounters) {
+        fw_pull_slave_counters(plan);
+    }
 
     free(chunkBuffer);
     fw_close_payload(&payload);
@@ -6,6 +6,8 @@
 #include <stdint.h>
 
 #include "CO_SDOclient.h"
+#include "fw_digest.h"
+#include "fw_transfer_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,20 +16,45 @@ extern "C" {
 typedef enum {
     FW_IMAGE_MAIN = 0,
     FW_IMAGE_BOOTLOADER = 1,
-    FW_IMAGE_CONFIG = 2
+    FW_IMAGE_CONFIG = 2,
+    /* Several images behind a table of contents (fw_bundle.h), applied with one reboot. */
+    FW_IMAGE_BUNDLE = 3
 } fw_image_type_t;
 
 typedef struct {
+    /* Image to stream; ignored when firmwareVersion names an image in the catalog. */
     const char *firmwarePath;
+    const char *firmwareVersion;
     fw_image_type_t type;
     uint8_t targetBank;
     uint8_t targetNodeId;
     uint32_t maxChunkBytes;
     uint16_t expectedCrc;
+    /* Digest announced in 0x1F57:02 and checked by the slave at finalize; FW_DIGEST_NONE keeps CRC16 only. */
+    fw_digest_type_t digestType;
+    /* Number of chunk buffers filled ahead of the sender; values below 2 stream synchronously. */
+    uint8_t readAheadDepth;
+    /* Compare against the slave's running image (0x2100) first and skip the transfer on a match. */
+    bool skipIfIdentical;
+    /* Read the slave's 0x2101 counters after the session and print them. */
+    bool pullSlaveCounters;
+    /*
+     * Send chunks with their offset (0x1F50:02) so a chunk lost on the bus is resent from the
+     * slave's hole list (0x2102) instead of failing the session. maxChunkBytes has to be a
+     * multiple of FW_RX_BLOCK_BYTES; slaves without the sub-index get stream chunks.
+     */
+    bool framedChunks;
+    /* Extra attempts for transfers that are safe to repeat (metadata, reads). */
+    uint8_t sdoRetries;
+    /* Optional; called from the uploader task after every chunk and phase change. */
+    fw_progress_cb_t onProgress;
+    void *progressCtx;
 } fw_upload_plan_t;
 
 bool fw_master_bind_sdo_client(CO_SDOclient_t *client);
 bool fw_run_upload_session(const fw_upload_plan_t *plan);
+/** Stats of the running or most recent session; also mirrored in OD object 0x2110. */
+bool fw_get_transfer_stats(fw_transfer_stats_t *out);
 
 #ifdef __cplusplus
 }
@@ -142,6 +142,16 @@ OD_find(OD_t* od, uint16_t index) {
         return NULL;
     }
 
+    /* Hash generated with the OD. A miss falls through to the binary search, so a table that was not regenerated after
+     * the OD changed still gives correct results. */
+    if (od->hash != NULL) {
+        const OD_hash_t* hash = od->hash;
+        uint16_t pos = hash->slots[(uint16_t)((uint32_t)index * hash->multiplier) >> hash->shift];
+        if ((pos != 0U) && (pos <= od->size) && (od->list[pos - 1U].index == index)) {
+            return &od->list[pos - 1U];
+        }
+    }
+
     uint16_t min = 0;
     uint16_t max = od->size - 1U;
 
@@ -268,6 +278,36 @@ OD_getSub(const OD_entry_t* entry, uint8_t subIndex, OD_IO_t* io, bool_t odOrig)
     return ret;
 }
 
+ODR_t
+OD_getSubCached(OD_t* od, uint16_t index, uint8_t subIndex, OD_IO_t* io, OD_IOcache_t* cache) {
+    OD_entry_t* entry = cache->entry;
+
+    if ((entry != NULL) && (entry->index == index) && (cache->subIndex == subIndex)
+        && (entry->extension == cache->extension)) {
+        /* The extension may also have been re-initialized in place with other functions */
+        const OD_extension_t* ext = entry->extension;
+        if ((ext == NULL)
+            || ((ext->object == cache->io.stream.object)
+                && (((ext->read != NULL) ? ext->read : OD_readDisabled) == cache->io.read)
+                && (((ext->write != NULL) ? ext->write : OD_writeDisabled) == cache->io.write))) {
+            *io = cache->io;
+            return ODR_OK;
+        }
+    }
+
+    entry = OD_find(od, index);
+    ODR_t ret = OD_getSub(entry, subIndex, io, false);
+    if (ret == ODR_OK) {
+        cache->io = *io;
+        cache->entry = entry;
+        cache->extension = entry->extension;
+        cache->subIndex = subIndex;
+    } else {
+        cache->entry = NULL;
+    }
+    return ret;
+}
+
 uint32_t
 OD_getSDOabCode(ODR_t returnCode) {
     static const uint32_t abortCodes[(uint8_t)ODR_COUNT] = {
@@ -376,7 +376,11 @@ CO_SDOclientDownloadInitiate(CO_SDOclient_t* SDO_C, uint16_t index, uint8_t subI
     SDO_C->finished = false;
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000U;
     SDO_C->timeoutTimer = 0;
+    SDO_C->rttSample_us = 0;
     CO_fifo_reset(&SDO_C->bufFifo);
+    SDO_C->source = NULL;
+    SDO_C->sourceObject = NULL;
+    SDO_C->sourceLeft = 0;
 
 #if ((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_LOCAL) != 0
     /* if node-ID of the SDO server is the same as node-ID of this node, then transfer data within this node */
@@ -421,6 +425,46 @@ CO_SDOclientDownloadBufWrite(CO_SDOclient_t* SDO_C, const uint8_t* buf, size_t c
     return ret;
 }
 
+CO_SDO_return_t
+CO_SDOclientDownloadSource(CO_SDOclient_t* SDO_C, CO_SDOclient_source_t source, void* object) {
+    if ((SDO_C == NULL) || (source == NULL) || (SDO_C->sizeInd == 0U)) {
+        return CO_SDO_RT_wrongArguments;
+    }
+    size_t occupied = CO_fifo_getOccupied(&SDO_C->bufFifo);
+    if (occupied > SDO_C->sizeInd) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    SDO_C->source = source;
+    SDO_C->sourceObject = object;
+    SDO_C->sourceLeft = SDO_C->sizeInd - occupied;
+    return CO_SDO_RT_ok_communicationEnd;
+}
+
+/* Fill the free part of the fifo from the source, in place. */
+static void
+CO_SDOclient_pullSource(CO_SDOclient_t* SDO_C) {
+    while (SDO_C->sourceLeft > 0U) {
+        uint8_t* dest;
+        size_t span = CO_fifo_writeSpan(&SDO_C->bufFifo, &dest);
+        if (span > SDO_C->sourceLeft) {
+            span = SDO_C->sourceLeft;
+        }
+        if (span == 0U) {
+            break;
+        }
+        size_t count = SDO_C->source(SDO_C->sourceObject, dest, span);
+        if (count > span) {
+            count = span;
+        }
+        CO_fifo_writeCommit(&SDO_C->bufFifo, count);
+        SDO_C->sourceLeft -= count;
+        if (count < span) {
+            break;
+        }
+    }
+}
+
 CO_SDO_return_t
 CO_SDOclientDownload(CO_SDOclient_t* SDO_C, uint32_t timeDifference_us, bool_t send_abort, bool_t bufferPartial,
                      CO_SDO_abortCode_t* SDOabortCode, size_t* sizeTransferred, uint32_t* timerNext_us) {
@@ -430,6 +474,11 @@ CO_SDOclientDownload(CO_SDOclient_t* SDO_C, uint32_t timeDifference_us, bool_t s
     CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
 
+    if ((SDO_C != NULL) && (SDO_C->source != NULL) && !send_abort) {
+        CO_SDOclient_pullSource(SDO_C);
+        bufferPartial = SDO_C->sourceLeft > 0U;
+    }
+
     if ((SDO_C == NULL) || !SDO_C->valid) {
         abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
         ret = CO_SDO_RT_wrongArguments;
@@ -761,6 +810,7 @@ CO_SDOclientDownload(CO_SDOclient_t* SDO_C, uint32_t timeDifference_us, bool_t s
                 }
             }
         }
+        SDO_C->rttSample_us = SDO_C->timeoutTimer + timeDifference_us;
         SDO_C->timeoutTimer = 0;
         timeDifference_us = 0;
         CO_FLAG_CLEAR(SDO_C->CANrxNew);
@@ -1057,6 +1107,7 @@ CO_SDOclientUploadInitiate(CO_SDOclient_t* SDO_C, uint16_t index, uint8_t subInd
     CO_fifo_reset(&SDO_C->bufFifo);
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000U;
     SDO_C->timeoutTimer = 0;
+    SDO_C->rttSample_us = 0;
 #if ((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_BLOCK) != 0
     SDO_C->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700U;
 #endif
@@ -1464,6 +1515,7 @@ CO_SDOclientUpload(CO_SDOclient_t* SDO_C, uint32_t timeDifference_us, bool_t sen
                 }
             }
         }
+        SDO_C->rttSample_us = SDO_C->timeoutTimer + timeDifference_us;
         SDO_C->timeoutTimer = 0;
         timeDifference_us = 0;
         CO_FLAG_CLEAR(SDO_C->CANrxNew);
@@ -145,6 +145,14 @@ write_SDO(CO_SDOclient_t* SDO_C, uint8_t nodeId, uint16_t index, uint8_t subInde
  * @see @ref CO_SDOserver
  */
 
+/**
+ * Data source for a download, see CO_SDOclientDownloadSource().
+ *
+ * Copies up to count bytes of the next data into buf and returns how many it copied. Returning fewer bytes means that
+ * no more data is available right now; the source is asked again on the next CO_SDOclientDownload() call.
+ */
+typedef size_t (*CO_SDOclient_source_t)(void* object, uint8_t* buf, size_t count);
+
 /**
  * SDO client object
  */
@@ -179,12 +187,17 @@ typedef struct {
     volatile CO_SDO_state_t state; /**< Internal state of the SDO client */
     uint32_t SDOtimeoutTime_us;    /**< Maximum timeout time between request and response in microseconds */
     uint32_t timeoutTimer;         /**< Timeout timer for SDO communication */
+    uint32_t rttSample_us;         /**< Time from the last request to the response just processed, in microseconds.
+                                        The application may read it after each processing call and clear it. */
     CO_fifo_t bufFifo;             /**< CO_fifo_t object for data buffer (not pointer) */
     uint8_t buf[CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1U]; /**< Data buffer of usable size @ref CO_CONFIG_SDO_CLI_BUFFER_SIZE,
                                                         used inside bufFifo. Must be one byte larger for fifo usage. */
     volatile void* CANrxNew; /**< Indicates, if new SDO message received from CAN bus. It is not cleared, until received
                                 message is completely processed. */
     uint8_t CANrxData[8];    /**< 8 data bytes of the received message */
+    CO_SDOclient_source_t source; /**< From CO_SDOclientDownloadSource() or NULL */
+    void* sourceObject;           /**< From CO_SDOclientDownloadSource() or NULL */
+    size_t sourceLeft;            /**< Bytes the source still has to deliver for the current download */
 #if (((CO_CONFIG_SDO_CLI)&CO_CONFIG_FLAG_CALLBACK_PRE) != 0) || defined CO_DOXYGEN
     void (*pFunctSignal)(void* object); /**< From CO_SDOclient_initCallbackPre() or NULL */
     void* functSignalObject;            /**< From CO_SDOclient_initCallbackPre() or NULL */
@@ -316,6 +329,24 @@ void CO_SDOclientDownloadInitSize(CO_SDOclient_t* SDO_C, size_t sizeIndicated);
  */
 size_t CO_SDOclientDownloadBufWrite(CO_SDOclient_t* SDO_C, const uint8_t* buf, size_t count);
 
+/**
+ * Let SDO client pull download data from a source instead of CO_SDOclientDownloadBufWrite().
+ *
+ * Each CO_SDOclientDownload() call fills the free part of the internal fifo by calling the source with pointers into
+ * the fifo itself, so data is copied once, from the source into the buffer the segments or blocks are sent from, and
+ * bufferPartial argument of CO_SDOclientDownload() is ignored. Must be called after CO_SDOclientDownloadInitiate() with
+ * sizeIndicated different than zero. Data already written with CO_SDOclientDownloadBufWrite(), for example a header,
+ * is sent first; the source delivers the rest of sizeIndicated. The source is released when the next download is
+ * initiated.
+ *
+ * @param SDO_C This object.
+ * @param source Function which copies the data, see #CO_SDOclient_source_t.
+ * @param object Passed to source.
+ *
+ * @return #CO_SDO_return_t, CO_SDO_RT_ok_communicationEnd or CO_SDO_RT_wrongArguments
+ */
+CO_SDO_return_t CO_SDOclientDownloadSource(CO_SDOclient_t* SDO_C, CO_SDOclient_source_t source, void* object);
+
 /**
  * Process SDO download communication.
  *
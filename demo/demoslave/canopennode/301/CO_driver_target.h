@@ -12,6 +12,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +89,12 @@ typedef struct {
 #define CO_FLAG_SET(rxNew)  do { CO_MemoryBarrier(); rxNew = (void*)1L; } while (0)
 #define CO_FLAG_CLEAR(rxNew) do { CO_MemoryBarrier(); rxNew = NULL; } while (0)
 
+/* Free-running microsecond clock for the CO_process() statistics (CO_CONFIG_PROCESS_STATS). */
+#define CO_PROCESS_TIME_US() ((uint32_t)esp_timer_get_time())
+
+/* CO_USE_GLOBALS: start the CANopen objects on a cache line, 32 bytes on the ESP32 family. */
+#define CO_GLOBALS_ATTRIBUTE __attribute__((aligned(32)))
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -75,51 +75,64 @@ CO_fifo_init(CO_fifo_t* fifo, uint8_t* buf, size_t bufSize) {
  *        empty       3 bytes       4 bytes       buffer                      *
  *        buffer      in buff       in buff       full                        *
  ******************************************************************************/
+size_t
+CO_fifo_writeSpan(CO_fifo_t* fifo, uint8_t** dest) {
+    size_t writePtr = fifo->writePtr;
+    size_t readPtr = fifo->readPtr;
+
+    *dest = &fifo->buf[writePtr];
+    /* one byte always stays free, so a full buffer differs from an empty one */
+    if (readPtr > writePtr) {
+        return readPtr - writePtr - 1U;
+    }
+    return fifo->bufSize - writePtr - ((readPtr == 0U) ? 1U : 0U);
+}
+
+void
+CO_fifo_writeCommit(CO_fifo_t* fifo, size_t count) {
+    size_t writePtr = fifo->writePtr + count;
+    fifo->writePtr = (writePtr == fifo->bufSize) ? 0U : writePtr;
+}
+
 size_t
 CO_fifo_write(CO_fifo_t* fifo, const uint8_t* buf, size_t count, uint16_t* crc) {
-    size_t i;
-    uint8_t* bufDest;
+    size_t written = 0U;
 
     if ((fifo == NULL) || (fifo->buf == NULL) || (buf == NULL)) {
         return 0;
     }
 
-    bufDest = &fifo->buf[fifo->writePtr];
-    for (i = count; i > 0U; i--) {
-        size_t writePtrNext = fifo->writePtr + 1U;
+    /* Copy in at most two contiguous spans, up to the end of the buffer and then from its start. writePtr is only
+     * advanced after the data is in place. */
+    while (written < count) {
+        uint8_t* bufDest;
+        size_t span = CO_fifo_writeSpan(fifo, &bufDest);
 
-        /* is circular buffer full */
-        if ((writePtrNext == fifo->readPtr) || ((writePtrNext == fifo->bufSize) && (fifo->readPtr == 0U))) {
+        if (span == 0U) {
             break;
         }
+        if (span > (count - written)) {
+            span = count - written;
+        }
 
-        *bufDest = *buf;
+        (void)memcpy(bufDest, &buf[written], span);
 
 #if ((CO_CONFIG_FIFO)&CO_CONFIG_FIFO_CRC16_CCITT) != 0
         if (crc != NULL) {
-            crc16_ccitt_single(crc, *buf);
+            *crc = crc16_ccitt(&buf[written], span, *crc);
         }
 #endif
 
-        /* increment variables */
-        if (writePtrNext == fifo->bufSize) {
-            fifo->writePtr = 0;
-            bufDest = &fifo->buf[0];
-        } else {
-            fifo->writePtr++;
-            bufDest++;
-        }
-        buf++;
+        CO_fifo_writeCommit(fifo, span);
+        written += span;
     }
 
-    return count - i;
+    return written;
 }
 
 size_t
 CO_fifo_read(CO_fifo_t* fifo, uint8_t* buf, size_t count, bool_t* eof) {
-    size_t i;
-    const uint8_t* bufSrc;
-    bool_t alive_cycle = true;
+    size_t total = 0U;
 
     if (eof != NULL) {
         *eof = false;
@@ -128,62 +141,66 @@ CO_fifo_read(CO_fifo_t* fifo, uint8_t* buf, size_t count, bool_t* eof) {
         return 0;
     }
 
-    bufSrc = &fifo->buf[fifo->readPtr];
-    for (i = count; (i > 0U) && alive_cycle;) {
-        const uint8_t c = *bufSrc;
+    /* Same two spans as CO_fifo_write(): up to writePtr or to the end of the buffer, then from its start. */
+    while (total < count) {
+        size_t readPtr = fifo->readPtr;
+        size_t writePtr = fifo->writePtr;
+        size_t span = (writePtr >= readPtr) ? (writePtr - readPtr) : (fifo->bufSize - readPtr);
+        const uint8_t* bufSrc = &fifo->buf[readPtr];
+        bool_t delimiter = false;
 
-        /* is circular buffer empty */
-        if (fifo->readPtr == fifo->writePtr) {
-            alive_cycle = false;
-        } else {
-            *buf = c;
-            buf++;
-
-            /* increment variables */
-            if (++fifo->readPtr == fifo->bufSize) {
-                fifo->readPtr = 0;
-                bufSrc = &fifo->buf[0];
-            } else {
-                bufSrc++;
-            }
-            i--;
+        if (span == 0U) {
+            break;
+        }
+        if (span > (count - total)) {
+            span = count - total;
+        }
 
 #if ((CO_CONFIG_FIFO)&CO_CONFIG_FIFO_ASCII_COMMANDS) != 0
-            /* is delimiter? */
-            if ((eof != NULL) && (c == DELIM_COMMAND)) {
-                *eof = true;
-                alive_cycle = false;
+        /* stop after the delimiter, it is copied too */
+        if (eof != NULL) {
+            const uint8_t* delim = (const uint8_t*)memchr(bufSrc, DELIM_COMMAND, span);
+            if (delim != NULL) {
+                span = (size_t)(delim - bufSrc) + 1U;
+                delimiter = true;
             }
+        }
 #endif
+
+        (void)memcpy(&buf[total], bufSrc, span);
+
+        readPtr += span;
+        fifo->readPtr = (readPtr == fifo->bufSize) ? 0U : readPtr;
+        total += span;
+
+        if (delimiter) {
+            *eof = true;
+            break;
         }
     }
 
-    return count - i;
+    return total;
 }
 
 #if ((CO_CONFIG_FIFO)&CO_CONFIG_FIFO_ALT_READ) != 0
 size_t
 CO_fifo_altBegin(CO_fifo_t* fifo, size_t offset) {
-    size_t i;
+    size_t available;
+    size_t altReadPtr;
 
     if (fifo == NULL) {
         return 0;
     }
 
-    fifo->altReadPtr = fifo->readPtr;
-    for (i = offset; i > 0U; i--) {
-        /* is circular buffer empty */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
-        }
-
-        /* increment variable */
-        if (++fifo->altReadPtr == fifo->bufSize) {
-            fifo->altReadPtr = 0;
-        }
+    available = (fifo->writePtr >= fifo->readPtr) ? (fifo->writePtr - fifo->readPtr)
+                                                   : (fifo->bufSize - fifo->readPtr + fifo->writePtr);
+    if (offset > available) {
+        offset = available;
     }
+    altReadPtr = fifo->readPtr + offset;
+    fifo->altReadPtr = (altReadPtr >= fifo->bufSize) ? (altReadPtr - fifo->bufSize) : altReadPtr;
 
-    return offset - i;
+    return offset;
 }
 
 void
@@ -193,52 +210,46 @@ CO_fifo_altFinish(CO_fifo_t* fifo, uint16_t* crc) {
         return;
     }
 
-    if (crc == NULL) {
-        fifo->readPtr = fifo->altReadPtr;
-    } else {
-        const uint8_t* bufSrc = &fifo->buf[fifo->readPtr];
-        while (fifo->readPtr != fifo->altReadPtr) {
 #if ((CO_CONFIG_FIFO)&CO_CONFIG_FIFO_CRC16_CCITT) != 0
-            crc16_ccitt_single(crc, *bufSrc);
-#endif
-            /* increment variable */
-            if (++fifo->readPtr == fifo->bufSize) {
-                fifo->readPtr = 0;
-                bufSrc = &fifo->buf[0];
-            } else {
-                bufSrc++;
-            }
+    if (crc != NULL) {
+        /* consumed data is at most two spans: up to the end of the buffer, then from its start */
+        if (fifo->altReadPtr < fifo->readPtr) {
+            *crc = crc16_ccitt(&fifo->buf[fifo->readPtr], fifo->bufSize - fifo->readPtr, *crc);
+            fifo->readPtr = 0;
         }
+        *crc = crc16_ccitt(&fifo->buf[fifo->readPtr], fifo->altReadPtr - fifo->readPtr, *crc);
     }
+#else
+    (void)crc;
+#endif
+    fifo->readPtr = fifo->altReadPtr;
 }
 
 size_t
 CO_fifo_altRead(CO_fifo_t* fifo, uint8_t* buf, size_t count) {
-    size_t i;
-    const uint8_t* bufSrc;
+    size_t total = 0U;
 
-    bufSrc = &fifo->buf[fifo->altReadPtr];
-    for (i = count; i > 0U; i--) {
-        const uint8_t c = *bufSrc;
+    while (total < count) {
+        size_t altReadPtr = fifo->altReadPtr;
+        size_t writePtr = fifo->writePtr;
+        size_t span = (writePtr >= altReadPtr) ? (writePtr - altReadPtr) : (fifo->bufSize - altReadPtr);
 
         /* is there no more data */
-        if (fifo->altReadPtr == fifo->writePtr) {
+        if (span == 0U) {
             break;
         }
+        if (span > (count - total)) {
+            span = count - total;
+        }
 
-        *buf = c;
-        buf++;
+        (void)memcpy(&buf[total], &fifo->buf[altReadPtr], span);
 
-        /* increment variables */
-        if (++fifo->altReadPtr == fifo->bufSize) {
-            fifo->altReadPtr = 0;
-            bufSrc = &fifo->buf[0];
-        } else {
-            bufSrc++;
-        }
+        altReadPtr += span;
+        fifo->altReadPtr = (altReadPtr == fifo->bufSize) ? 0U : altReadPtr;
+        total += span;
     }
 
-    return count - i;
+    return total;
 }
 #endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ */
 
@@ -226,6 +226,28 @@ CO_fifo_getc(CO_fifo_t* fifo, uint8_t* buf) {
  */
 size_t CO_fifo_write(CO_fifo_t* fifo, const uint8_t* buf, size_t count, uint16_t* crc);
 
+/**
+ * Get contiguous free space of CO_fifo_t object, for writing data in place.
+ *
+ * Free space ends where the buffer wraps or where it would become full, so filling all free space takes at most two
+ * CO_fifo_writeSpan() / CO_fifo_writeCommit() pairs. Bytes placed at *dest become part of the fifo only after
+ * CO_fifo_writeCommit().
+ *
+ * @param fifo This object
+ * @param [out] dest Where the next byte goes
+ *
+ * @return number of bytes that fit at dest, 0 if fifo is full.
+ */
+size_t CO_fifo_writeSpan(CO_fifo_t* fifo, uint8_t** dest);
+
+/**
+ * Add bytes written in place after CO_fifo_writeSpan() to the fifo.
+ *
+ * @param fifo This object
+ * @param count Number of bytes written, not more than returned by CO_fifo_writeSpan()
+ */
+void CO_fifo_writeCommit(CO_fifo_t* fifo, size_t count);
+
 /**
  * Read data from CO_fifo_t object.
  *
@@ -45,6 +45,14 @@
 extern "C" {
 #endif
 
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_PROCESS
+#define CO_CONFIG_PROCESS (0)
+#endif
+#ifndef CO_CONFIG_PROCESS_IDLE_US
+#define CO_CONFIG_PROCESS_IDLE_US 100000U
+#endif
+
 /**
  * @defgroup CO_CANopen CANopen
  * @{
@@ -165,11 +173,31 @@ extern "C" {
  * If macro is defined externally, then global variables for CANopen objects
  * will be used instead of heap. This is possible only if CO_MULTIPLE_OD is not
  * defined.
+ *
+ * All objects are members of one static structure, sized from "OD.h" at compile time. @ref CO_GLOBALS_ATTRIBUTE
+ * may align or place it.
  */
 #ifdef CO_DOXYGEN
 #define CO_USE_GLOBALS
 #endif
 
+/**
+ * If macro is defined externally together with @ref CO_USE_GLOBALS, then CANmodule, its receive array, SDO servers
+ * and SDO clients are placed first and contiguous in the static structure, so the receive path and SDO transfers
+ * touch as few cache lines as possible.
+ */
+#ifdef CO_DOXYGEN
+#define CO_GLOBALS_HOT_FIRST
+#endif
+
+/**
+ * Attribute of the static structure used with @ref CO_USE_GLOBALS, for example alignment to a cache line. May be
+ * defined in CO_driver_target.h, empty by default.
+ */
+#ifndef CO_GLOBALS_ATTRIBUTE
+#define CO_GLOBALS_ATTRIBUTE
+#endif
+
 #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
 /**
  * CANopen configuration, used with @ref CO_new()
@@ -234,6 +262,45 @@ typedef struct {
 typedef void CO_config_t;
 #endif /* CO_MULTIPLE_OD */
 
+/**
+ * Objects processed by @ref CO_process(), index into CO_t::processStats.
+ */
+typedef enum {
+    CO_PROCESS_CAN = 0, /**< CO_CANmodule_process() */
+    CO_PROCESS_LSS_SLV, /**< CO_LSSslave_process() */
+    CO_PROCESS_LEDS,    /**< CO_LEDs_process() */
+    CO_PROCESS_EM,      /**< CO_EM_process() */
+    CO_PROCESS_NMT,     /**< CO_NMT_process() */
+    CO_PROCESS_SDO_SRV, /**< CO_SDOserver_process(), all SDO servers together */
+    CO_PROCESS_HB_CONS, /**< CO_HBconsumer_process() */
+    CO_PROCESS_NG,      /**< Node guarding slave and master */
+    CO_PROCESS_TIME,    /**< CO_TIME_process() */
+    CO_PROCESS_GTWA,    /**< CO_GTWA_process() */
+    CO_PROCESS_COUNT    /**< Number of entries */
+} CO_processModule_t;
+
+/**
+ * Scheduling state of one object inside @ref CO_process(), see @ref CO_CONFIG_PROCESS_SCHEDULE.
+ */
+typedef struct {
+    volatile uint8_t ready; /**< Set from the receive callback of the object, cleared when it is processed */
+    uint32_t elapsed_us;    /**< Time since the object was processed last */
+    uint32_t due_us;        /**< Elapsed time at which it must be processed, from its timerNext_us */
+    void* co;               /**< CO_t object, which owns the slot */
+} CO_processSlot_t;
+
+/**
+ * Time spent in one object inside @ref CO_process(), see @ref CO_CONFIG_PROCESS_STATS.
+ *
+ * Counters are never cleared by the stack, application may clear them after reading.
+ */
+typedef struct {
+    uint32_t calls;      /**< Number of times the object was processed */
+    uint32_t skips;      /**< Number of times it was skipped, because it had nothing to do */
+    uint32_t time_us;    /**< Total processing time, wraps around */
+    uint32_t timeMax_us; /**< Longest single processing time */
+} CO_processStat_t;
+
 /**
  * CANopen object - collection of all CANopenNode objects
  */
@@ -364,20 +431,32 @@ typedef struct {
 #if ((CO_CONFIG_TRACE)&CO_CONFIG_TRACE_ENABLE) || defined CO_DOXYGEN
     CO_trace_t* trace; /**< Trace object, initialised by @ref CO_trace_init(). */
 #endif
+#if (((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0) || defined CO_DOXYGEN
+    CO_processSlot_t processSlot[CO_PROCESS_COUNT]; /**< Scheduling of the objects, except SDO servers */
+    CO_processSlot_t* SDOserverSlot; /**< Scheduling of each SDO server, one per SDO server object */
+    CO_NMT_internalState_t processNMTstate; /**< NMT state seen by the previous CO_process() */
+    uint16_t processCANerrorStatus;          /**< CAN error status seen by the previous CO_process() */
+    void (*pFunctSignalProcess)(void* object); /**< From CO_process_initCallbackPre() or NULL */
+    void* functSignalObjectProcess;            /**< From CO_process_initCallbackPre() or NULL */
+#endif
+#if (((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_STATS) != 0) || defined CO_DOXYGEN
+    CO_processStat_t processStats[CO_PROCESS_COUNT]; /**< Time spent in each object, see @ref CO_processModule_t */
+#endif
 } CO_t;
 
 /**
  * Create new CANopen object
  *
- * If CO_USE_GLOBALS is defined, then function uses global static variables for all the CANopenNode objects. Otherwise
- * it allocates all objects from heap.
+ * If CO_USE_GLOBALS is defined, then function uses global static variables for all the CANopenNode objects and clears
+ * them. Otherwise it allocates all objects from heap.
  *
  * @remark
  * With some microcontrollers it is necessary to specify Heap size within linker configuration, if heap is used.
  *
  * @param config Configuration structure, used if @ref CO_MULTIPLE_OD is defined. It must stay in memory permanently. If
  * CO_MULTIPLE_OD is not defined, config should be NULL and parameters are retrieved from default "OD.h" file.
- * @param [out] heapMemoryUsed Information about heap memory used. Ignored if NULL.
+ * @param [out] heapMemoryUsed Information about heap memory used, or size of the static objects if CO_USE_GLOBALS is
+ * defined. Ignored if NULL.
  *
  * @return Successfully allocated and configured CO_t object or NULL.
  */
@@ -513,10 +592,28 @@ CO_ReturnError_t CO_CANopenInitSRDO(CO_t* co, CO_EM_t* em, OD_t* od, uint8_t nod
  * should also trigger calling of CO_process() function. Parameter is ignored if NULL. See also @ref
  * CO_CONFIG_FLAG_CALLBACK_PRE configuration macro.
  *
+ * With @ref CO_CONFIG_PROCESS_SCHEDULE objects without received messages or expired timers are skipped, see
+ * @ref CO_processSlot_t. timerNext_us then also covers the skipped objects.
+ *
  * @return Node or communication reset request, from @ref CO_NMT_process().
  */
 CO_NMT_reset_cmd_t CO_process(CO_t* co, bool_t enableGateway, uint32_t timeDifference_us, uint32_t* timerNext_us);
 
+#if (((CO_CONFIG_PROCESS)&CO_CONFIG_PROCESS_SCHEDULE) != 0) || defined CO_DOXYGEN
+/**
+ * Initialize callback, which signals, that CO_process() has work to do.
+ *
+ * With @ref CO_CONFIG_PROCESS_SCHEDULE the callbacks of the scheduled objects are used by CO_process() itself. They
+ * mark the object ready and then call this function, which may wake up the task running CO_process(). Function may
+ * be called any time, also before CO_CANopenInit().
+ *
+ * @param co CANopen object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can be NULL
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_process_initCallbackPre(CO_t* co, void* object, void (*pFunctSignal)(void* object));
+#endif
+
 #if (((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0) || defined CO_DOXYGEN
 /**
  * Process CANopen SYNC objects.
@@ -204,9 +204,9 @@ CO_CANtxBufferInit(CO_CANmodule_t* CANmodule, uint16_t index, uint16_t ident, bo
         /* get specific buffer */
         buffer = &CANmodule->txArray[index];
 
-        /* CAN identifier, DLC and rtr, bit aligned with CAN module transmit buffer, microcontroller specific. */
-        buffer->ident = ((uint32_t)ident & 0x07FFU) | ((uint32_t)(((uint32_t)noOfBytes & 0xFU) << 11U))
-                        | ((uint32_t)(rtr ? 0x8000U : 0U));
+        /* CAN identifier with the rtr flag as CO_CANtransmit() reads it, DLC separate. */
+        buffer->ident = ((uint32_t)ident & 0x07FFU) | ((uint32_t)(rtr ? 0x0800U : 0U));
+        buffer->DLC = (uint8_t)(noOfBytes & 0xFU);
 
         buffer->bufferFull = false;
         buffer->syncFlag = syncFlag;
@@ -1,10 +1,9 @@
 /*******************************************************************************
     CANopen Object Dictionary definition for CANopenNode V4
 
-    This file was automatically generated by CANopenEditor v4.1-1-ga49a51a
+    This file was automatically generated by eds2od.py from demo_slave.eds
 
     https://github.com/CANopenNode/CANopenNode
-    https://github.com/CANopenNode/CANopenEditor
 
     DON'T EDIT THIS FILE MANUALLY, UNLESS YOU KNOW WHAT YOU ARE DOING !!!!
 *******************************************************************************/
@@ -27,50 +26,45 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
     .x1007_synchronousWindowLength = 0x00000000,
     .x1012_COB_IDTimeStampObject = 0x00000100,
     .x1014_COB_ID_EMCY = 0x00000080,
-    .x1015_inhibitTimeEMCY = 0x0000,
-    .x1016_consumerHeartbeatTime_sub0 = 0x08,
     .x1016_consumerHeartbeatTime = {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
-    .x1017_producerHeartbeatTime = 0x0000,
     .x1018_identity = {
-        .highestSub_indexSupported = 0x04,
         .vendor_ID = 0x00000000,
         .productCode = 0x00000000,
         .revisionNumber = 0x00000000,
-        .serialNumber = 0x00000000
+        .serialNumber = 0x00000000,
+        .highestSub_indexSupported = 0x04
     },
-    .x1019_synchronousCounterOverflowValue = 0x00,
     .x1280_SDOClientParameter = {
-        .highestSub_indexSupported = 0x03,
         .COB_IDClientToServerTx = 0x80000000,
         .COB_IDServerToClientRx = 0x80000000,
+        .highestSub_indexSupported = 0x03,
         .node_IDOfTheSDOServer = 0x01
     },
     .x1400_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000200,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1401_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000300,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1402_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000400,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1403_RPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x80000500,
-        .transmissionType = 0xFE,
-        .eventTimer = 0x0000
+        .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x05,
+        .transmissionType = 0xFE
     },
     .x1600_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -78,10 +72,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1601_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -89,10 +83,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1602_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -100,10 +94,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1603_RPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -111,42 +105,42 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1800_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000180,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1801_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000280,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1802_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000380,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1803_TPDOCommunicationParameter = {
-        .highestSub_indexSupported = 0x06,
         .COB_IDUsedByTPDO = 0xC0000480,
-        .transmissionType = 0xFE,
         .inhibitTime = 0x0000,
         .eventTimer = 0x0000,
+        .highestSub_indexSupported = 0x06,
+        .transmissionType = 0xFE,
         .SYNCStartValue = 0x00
     },
     .x1A00_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -154,10 +148,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A01_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -165,10 +159,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A02_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -176,10 +170,10 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
     },
     .x1A03_TPDOMappingParameter = {
-        .numberOfMappedApplicationObjectsInPDO = 0x00,
         .applicationObject1 = 0x00000000,
         .applicationObject2 = 0x00000000,
         .applicationObject3 = 0x00000000,
@@ -187,36 +181,114 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .applicationObject5 = 0x00000000,
         .applicationObject6 = 0x00000000,
         .applicationObject7 = 0x00000000,
-        .applicationObject8 = 0x00000000
-    }
+        .applicationObject8 = 0x00000000,
+        .numberOfMappedApplicationObjectsInPDO = 0x00
+    },
+    .x1015_inhibitTimeEMCY = 0x0000,
+    .x1017_producerHeartbeatTime = 0x0000,
+    .x1016_consumerHeartbeatTime_sub0 = 0x08,
+    .x1019_synchronousCounterOverflowValue = 0x00
 };
 
 OD_ATTR_RAM OD_RAM_t OD_RAM = {
-    .x1001_errorRegister = 0x00,
-    .x1010_storeParameters_sub0 = 0x04,
     .x1010_storeParameters = {0x00000001, 0x00000001, 0x00000001, 0x00000001},
-    .x1011_restoreDefaultParameters_sub0 = 0x04,
     .x1011_restoreDefaultParameters = {0x00000001, 0x00000001, 0x00000001, 0x00000001},
     .x1200_SDOServerParameter = {
-        .highestSub_indexSupported = 0x02,
         .COB_IDClientToServerRx = 0x00000600,
-        .COB_IDServerToClientTx = 0x00000580
+        .COB_IDServerToClientTx = 0x00000580,
+        .highestSub_indexSupported = 0x02
+    },
+    .x1201_SDOServer2Parameter = {
+        .COB_IDClientToServerRx = 0x80000000,
+        .COB_IDServerToClientTx = 0x80000000,
+        .highestSub_indexSupported = 0x03,
+        .node_IDOfTheSDOClient = 0x00
+    },
+    .x1202_SDOServer3Parameter = {
+        .COB_IDClientToServerRx = 0x80000000,
+        .COB_IDServerToClientTx = 0x80000000,
+        .highestSub_indexSupported = 0x03,
+        .node_IDOfTheSDOClient = 0x00
     },
+    .x1F57_programIdentification = {
+        .payload = {0},
+        .digest = {0}
+    },
+    .x2100_runningImageIdentity = {
+        .imageBytes = 0x00000000,
+        .sha256 = {0},
+        .crc = 0x0000
+    },
+    .x2101_fwPerfCounters = {
+        .chunks = 0x00000000,
+        .bytes = 0x00000000,
+        .sdoWrites = 0x00000000,
+        .writeMinUs = 0x00000000,
+        .writeAvgUs = 0x00000000,
+        .writeMaxUs = 0x00000000,
+        .eraseUs = 0x00000000,
+        .crcUs = 0x00000000,
+        .idleMs = 0x00000000,
+        .metadataReadyMs = 0x00000000,
+        .erasingMs = 0x00000000,
+        .receivingMs = 0x00000000,
+        .verifyingMs = 0x00000000,
+        .readyToBootMs = 0x00000000,
+        .writeLatencyHistogram = {0},
+        .sdoStageBusyPermille = 0x00000000,
+        .writerStageBusyPermille = 0x00000000,
+        .pipelineStalls = 0x00000000,
+        .pipelinePeakDepth = 0x00000000,
+        .verifyUs = 0x00000000,
+        .sectorsSkipped = 0x00000000,
+        .sectorsProgrammed = 0x00000000
+    },
+    .x2102_fwMissingRanges = {
+        .missingBytes = 0x00000000,
+        .holeCount = 0x00000000,
+        .ranges = {0}
+    },
+    .x2103_fwReadback = {
+        .offset = 0x00000000,
+        .length = 0x00000000,
+        .region = 0x00
+    },
+    .x1F5A_programStatus = {
+        .payload = {0},
+        .verifyState = 0x00
+    },
+    .x1001_errorRegister = 0x00,
+    .x1010_storeParameters_sub0 = 0x04,
+    .x1011_restoreDefaultParameters_sub0 = 0x04,
+    .x1F51_programControl = {
+        .payload = {0}
+    }
+};
+
+OD_ATTR_ROM CO_PROGMEM OD_ROM_t OD_ROM = {
     .x1F50_programDownload = {
-        .highestSub_indexSupported = 0x01,
-        .data = 0x00
+        .highestSub_indexSupported = 0x02
     },
     .x1F51_programControl = {
-        .highestSub_indexSupported = 0x01,
-        .payload = {0x00, 0x00, 0x00}
+        .highestSub_indexSupported = 0x01
     },
     .x1F57_programIdentification = {
-        .highestSub_indexSupported = 0x01,
-        .payload = {0}
+        .highestSub_indexSupported = 0x02
     },
     .x1F5A_programStatus = {
-        .highestSub_indexSupported = 0x01,
-        .payload = {0x00, 0x00}
+        .highestSub_indexSupported = 0x02
+    },
+    .x2100_runningImageIdentity = {
+        .highestSub_indexSupported = 0x03
+    },
+    .x2101_fwPerfCounters = {
+        .highestSub_indexSupported = 0x16
+    },
+    .x2102_fwMissingRanges = {
+        .highestSub_indexSupported = 0x03
+    },
+    .x2103_fwReadback = {
+        .highestSub_indexSupported = 0x04
     }
 };
 
@@ -242,6 +314,8 @@ typedef struct {
     OD_obj_record_t o_1018_identity[5];
     OD_obj_var_t o_1019_synchronousCounterOverflowValue;
     OD_obj_record_t o_1200_SDOServerParameter[3];
+    OD_obj_record_t o_1201_SDOServer2Parameter[4];
+    OD_obj_record_t o_1202_SDOServer3Parameter[4];
     OD_obj_record_t o_1280_SDOClientParameter[4];
     OD_obj_record_t o_1400_RPDOCommunicationParameter[4];
     OD_obj_record_t o_1401_RPDOCommunicationParameter[4];
@@ -259,10 +333,14 @@ typedef struct {
     OD_obj_record_t o_1A01_TPDOMappingParameter[9];
     OD_obj_record_t o_1A02_TPDOMappingParameter[9];
     OD_obj_record_t o_1A03_TPDOMappingParameter[9];
-    OD_obj_record_t o_1F50_programDownload[2];
+    OD_obj_record_t o_1F50_programDownload[3];
     OD_obj_record_t o_1F51_programControl[2];
-    OD_obj_record_t o_1F57_programIdentification[2];
-    OD_obj_record_t o_1F5A_programStatus[2];
+    OD_obj_record_t o_1F57_programIdentification[3];
+    OD_obj_record_t o_1F5A_programStatus[3];
+    OD_obj_record_t o_2100_runningImageIdentity[4];
+    OD_obj_record_t o_2101_fwPerfCounters[23];
+    OD_obj_record_t o_2102_fwMissingRanges[4];
+    OD_obj_record_t o_2103_fwReadback[5];
 } ODObjs_t;
 
 static CO_PROGMEM ODObjs_t ODObjs = {
@@ -400,6 +478,58 @@ static CO_PROGMEM ODObjs_t ODObjs = {
             .dataLength = 4
         }
     },
+    .o_1201_SDOServer2Parameter = {
+        {
+            .dataOrig = &OD_RAM.x1201_SDOServer2Parameter.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x1201_SDOServer2Parameter.COB_IDClientToServerRx,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x1201_SDOServer2Parameter.COB_IDServerToClientTx,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x1201_SDOServer2Parameter.node_IDOfTheSDOClient,
+            .subIndex = 3,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        }
+    },
+    .o_1202_SDOServer3Parameter = {
+        {
+            .dataOrig = &OD_RAM.x1202_SDOServer3Parameter.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x1202_SDOServer3Parameter.COB_IDClientToServerRx,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x1202_SDOServer3Parameter.COB_IDServerToClientTx,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x1202_SDOServer3Parameter.node_IDOfTheSDOClient,
+            .subIndex = 3,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        }
+    },
     .o_1280_SDOClientParameter = {
         {
             .dataOrig = &OD_PERSIST_COMM.x1280_SDOClientParameter.highestSub_indexSupported,
@@ -543,6 +673,12 @@ static CO_PROGMEM ODObjs_t ODObjs = {
             .attribute = ODA_SDO_RW | ODA_MB,
             .dataLength = 4
         },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1600_RPDOMappingParameter.applicationObject2,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
         {
             .dataOrig = &OD_PERSIST_COMM.x1600_RPDOMappingParameter.applicationObject3,
             .subIndex = 3,
@@ -1126,21 +1262,27 @@ static CO_PROGMEM ODObjs_t ODObjs = {
     },
     .o_1F50_programDownload = {
         {
-            .dataOrig = &OD_RAM.x1F50_programDownload.highestSub_indexSupported,
+            .dataOrig = (void *)&OD_ROM.x1F50_programDownload.highestSub_indexSupported,
             .subIndex = 0,
             .attribute = ODA_SDO_R,
             .dataLength = 1
         },
         {
-            .dataOrig = &OD_RAM.x1F50_programDownload.data,
+            .dataOrig = NULL,
             .subIndex = 1,
-            .attribute = ODA_SDO_W | ODA_MB,
+            .attribute = ODA_SDO_W,
+            .dataLength = 0
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 2,
+            .attribute = ODA_SDO_W,
             .dataLength = 0
         }
     },
     .o_1F51_programControl = {
         {
-            .dataOrig = &OD_RAM.x1F51_programControl.highestSub_indexSupported,
+            .dataOrig = (void *)&OD_ROM.x1F51_programControl.highestSub_indexSupported,
             .subIndex = 0,
             .attribute = ODA_SDO_R,
             .dataLength = 1
@@ -1148,13 +1290,13 @@ static CO_PROGMEM ODObjs_t ODObjs = {
         {
             .dataOrig = &OD_RAM.x1F51_programControl.payload[0],
             .subIndex = 1,
-            .attribute = ODA_SDO_RW | ODA_MB,
-            .dataLength = sizeof(OD_RAM.x1F51_programControl.payload)
+            .attribute = ODA_SDO_RW,
+            .dataLength = 3
         }
     },
     .o_1F57_programIdentification = {
         {
-            .dataOrig = &OD_RAM.x1F57_programIdentification.highestSub_indexSupported,
+            .dataOrig = (void *)&OD_ROM.x1F57_programIdentification.highestSub_indexSupported,
             .subIndex = 0,
             .attribute = ODA_SDO_R,
             .dataLength = 1
@@ -1162,13 +1304,19 @@ static CO_PROGMEM ODObjs_t ODObjs = {
         {
             .dataOrig = &OD_RAM.x1F57_programIdentification.payload[0],
             .subIndex = 1,
-            .attribute = ODA_SDO_RW | ODA_MB,
-            .dataLength = sizeof(OD_RAM.x1F57_programIdentification.payload)
+            .attribute = ODA_SDO_RW,
+            .dataLength = 8
+        },
+        {
+            .dataOrig = &OD_RAM.x1F57_programIdentification.digest[0],
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 36
         }
     },
     .o_1F5A_programStatus = {
         {
-            .dataOrig = &OD_RAM.x1F5A_programStatus.highestSub_indexSupported,
+            .dataOrig = (void *)&OD_ROM.x1F5A_programStatus.highestSub_indexSupported,
             .subIndex = 0,
             .attribute = ODA_SDO_R,
             .dataLength = 1
@@ -1176,8 +1324,238 @@ static CO_PROGMEM ODObjs_t ODObjs = {
         {
             .dataOrig = &OD_RAM.x1F5A_programStatus.payload[0],
             .subIndex = 1,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 2
+        },
+        {
+            .dataOrig = &OD_RAM.x1F5A_programStatus.verifyState,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        }
+    },
+    .o_2100_runningImageIdentity = {
+        {
+            .dataOrig = (void *)&OD_ROM.x2100_runningImageIdentity.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2100_runningImageIdentity.imageBytes,
+            .subIndex = 1,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2100_runningImageIdentity.crc,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 2
+        },
+        {
+            .dataOrig = &OD_RAM.x2100_runningImageIdentity.sha256[0],
+            .subIndex = 3,
+            .attribute = ODA_SDO_R,
+            .dataLength = 32
+        }
+    },
+    .o_2101_fwPerfCounters = {
+        {
+            .dataOrig = (void *)&OD_ROM.x2101_fwPerfCounters.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.chunks,
+            .subIndex = 1,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.bytes,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.sdoWrites,
+            .subIndex = 3,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.writeMinUs,
+            .subIndex = 4,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.writeAvgUs,
+            .subIndex = 5,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.writeMaxUs,
+            .subIndex = 6,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.eraseUs,
+            .subIndex = 7,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.crcUs,
+            .subIndex = 8,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.idleMs,
+            .subIndex = 9,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.metadataReadyMs,
+            .subIndex = 10,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.erasingMs,
+            .subIndex = 11,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.receivingMs,
+            .subIndex = 12,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.verifyingMs,
+            .subIndex = 13,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.readyToBootMs,
+            .subIndex = 14,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.writeLatencyHistogram[0],
+            .subIndex = 15,
+            .attribute = ODA_SDO_R,
+            .dataLength = 32
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.sdoStageBusyPermille,
+            .subIndex = 16,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.writerStageBusyPermille,
+            .subIndex = 17,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.pipelineStalls,
+            .subIndex = 18,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.pipelinePeakDepth,
+            .subIndex = 19,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.verifyUs,
+            .subIndex = 20,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.sectorsSkipped,
+            .subIndex = 21,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2101_fwPerfCounters.sectorsProgrammed,
+            .subIndex = 22,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        }
+    },
+    .o_2102_fwMissingRanges = {
+        {
+            .dataOrig = (void *)&OD_ROM.x2102_fwMissingRanges.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2102_fwMissingRanges.missingBytes,
+            .subIndex = 1,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2102_fwMissingRanges.holeCount,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2102_fwMissingRanges.ranges[0],
+            .subIndex = 3,
+            .attribute = ODA_SDO_R,
+            .dataLength = 128
+        }
+    },
+    .o_2103_fwReadback = {
+        {
+            .dataOrig = (void *)&OD_ROM.x2103_fwReadback.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2103_fwReadback.region,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_RAM.x2103_fwReadback.offset,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_RAM.x2103_fwReadback.length,
+            .subIndex = 3,
             .attribute = ODA_SDO_RW | ODA_MB,
-            .dataLength = sizeof(OD_RAM.x1F5A_programStatus.payload)
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 4,
+            .attribute = ODA_SDO_R,
+            .dataLength = 0
         }
     }
 };
@@ -1203,6 +1581,8 @@ static OD_ATTR_OD OD_entry_t ODList[] = {
     {0x1018, 0x05, ODT_REC, &ODObjs.o_1018_identity, NULL},
     {0x1019, 0x01, ODT_VAR, &ODObjs.o_1019_synchronousCounterOverflowValue, NULL},
     {0x1200, 0x03, ODT_REC, &ODObjs.o_1200_SDOServerParameter, NULL},
+    {0x1201, 0x04, ODT_REC, &ODObjs.o_1201_SDOServer2Parameter, NULL},
+    {0x1202, 0x04, ODT_REC, &ODObjs.o_1202_SDOServer3Parameter, NULL},
     {0x1280, 0x04, ODT_REC, &ODObjs.o_1280_SDOClientParameter, NULL},
     {0x1400, 0x04, ODT_REC, &ODObjs.o_1400_RPDOCommunicationParameter, NULL},
     {0x1401, 0x04, ODT_REC, &ODObjs.o_1401_RPDOCommunicationParameter, NULL},
@@ -1220,16 +1600,35 @@ static OD_ATTR_OD OD_entry_t ODList[] = {
     {0x1A01, 0x09, ODT_REC, &ODObjs.o_1A01_TPDOMappingParameter, NULL},
     {0x1A02, 0x09, ODT_REC, &ODObjs.o_1A02_TPDOMappingParameter, NULL},
     {0x1A03, 0x09, ODT_REC, &ODObjs.o_1A03_TPDOMappingParameter, NULL},
-    {0x1F50, 0x02, ODT_REC, &ODObjs.o_1F50_programDownload, NULL},
+    {0x1F50, 0x03, ODT_REC, &ODObjs.o_1F50_programDownload, NULL},
     {0x1F51, 0x02, ODT_REC, &ODObjs.o_1F51_programControl, NULL},
-    {0x1F57, 0x02, ODT_REC, &ODObjs.o_1F57_programIdentification, NULL},
-    {0x1F5A, 0x02, ODT_REC, &ODObjs.o_1F5A_programStatus, NULL},
+    {0x1F57, 0x03, ODT_REC, &ODObjs.o_1F57_programIdentification, NULL},
+    {0x1F5A, 0x03, ODT_REC, &ODObjs.o_1F5A_programStatus, NULL},
+    {0x2100, 0x04, ODT_REC, &ODObjs.o_2100_runningImageIdentity, NULL},
+    {0x2101, 0x17, ODT_REC, &ODObjs.o_2101_fwPerfCounters, NULL},
+    {0x2102, 0x04, ODT_REC, &ODObjs.o_2102_fwMissingRanges, NULL},
+    {0x2103, 0x05, ODT_REC, &ODObjs.o_2103_fwReadback, NULL},
     {0x0000, 0x00, 0, NULL, NULL}
 };
 
+/* Perfect hash of the indexes in ODList, see OD_hash_t. */
+static const uint16_t ODHashSlots[128] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 37, 40, 41, 0, 42,
+    43, 0, 0, 0, 38, 0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 32, 33, 34, 0, 35, 0, 0, 28, 29, 30, 0,
+    31, 0, 0, 24, 25, 26, 0, 27, 0, 0, 20, 21, 22, 0, 23, 0,
+    0, 16, 17, 18, 0, 0, 0, 0, 1, 2, 0, 0, 3, 0, 0, 4,
+    5, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
+    0, 8, 9, 0, 0, 10, 0, 11, 12, 0, 13, 14, 0, 15, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19
+};
+
+static const OD_hash_t ODHash = {0x02F9, 9, &ODHashSlots[0]};
+
 static OD_t _OD = {
     (sizeof(ODList) / sizeof(ODList[0])) - 1,
-    &ODList[0]
+    &ODList[0],
+    &ODHash
 };
 
 OD_t *OD = &_OD;
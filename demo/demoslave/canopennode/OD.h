@@ -1,28 +1,27 @@
 /*******************************************************************************
     CANopen Object Dictionary definition for CANopenNode V4
 
-    This file was automatically generated by CANopenEditor v4.1-1-ga49a51a
+    This file was automatically generated by eds2od.py from demo_slave.eds
 
     https://github.com/CANopenNode/CANopenNode
-    https://github.com/CANopenNode/CANopenEditor
 
     DON'T EDIT THIS FILE MANUALLY !!!!
 ********************************************************************************
 
     File info:
         File Names:   OD.h; OD.c
-        Project File: DS301_profile.xpd
+        Project File: demo_slave.eds
         File Version: 1
 
-        Created:      23. 11. 2020 12:00:00
+        Created:      11-23-2020 12:00PM
         Created By:   
-        Modified:     17. 03. 2023 02:07:28
+        Modified:     10-18-2026 9:00AM
         Modified By:  
 
     Device Info:
         Vendor Name:  
         Vendor ID:    
-        Product Name: New Product
+        Product Name: OTA demo slave
         Product ID:   
 
         Description:  
@@ -42,7 +41,7 @@
 #define OD_CNT_EM_PROD 1
 #define OD_CNT_HB_CONS 1
 #define OD_CNT_HB_PROD 1
-#define OD_CNT_SDO_SRV 1
+#define OD_CNT_SDO_SRV 3
 #define OD_CNT_SDO_CLI 1
 #define OD_CNT_RPDO 4
 #define OD_CNT_TPDO 4
@@ -67,50 +66,45 @@ typedef struct {
     uint32_t x1007_synchronousWindowLength;
     uint32_t x1012_COB_IDTimeStampObject;
     uint32_t x1014_COB_ID_EMCY;
-    uint16_t x1015_inhibitTimeEMCY;
-    uint8_t x1016_consumerHeartbeatTime_sub0;
     uint32_t x1016_consumerHeartbeatTime[OD_CNT_ARR_1016];
-    uint16_t x1017_producerHeartbeatTime;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t vendor_ID;
         uint32_t productCode;
         uint32_t revisionNumber;
         uint32_t serialNumber;
+        uint8_t highestSub_indexSupported;
     } x1018_identity;
-    uint8_t x1019_synchronousCounterOverflowValue;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDClientToServerTx;
         uint32_t COB_IDServerToClientRx;
+        uint8_t highestSub_indexSupported;
         uint8_t node_IDOfTheSDOServer;
     } x1280_SDOClientParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1400_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1401_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1402_RPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
-        uint8_t transmissionType;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
     } x1403_RPDOCommunicationParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -119,9 +113,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1600_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -130,9 +124,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1601_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -141,9 +135,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1602_RPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -152,41 +146,41 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1603_RPDOMappingParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1800_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1801_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1802_TPDOCommunicationParameter;
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByTPDO;
-        uint8_t transmissionType;
         uint16_t inhibitTime;
         uint16_t eventTimer;
+        uint8_t highestSub_indexSupported;
+        uint8_t transmissionType;
         uint8_t SYNCStartValue;
     } x1803_TPDOCommunicationParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -195,9 +189,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A00_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -206,9 +200,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A01_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -217,9 +211,9 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A02_TPDOMappingParameter;
     struct {
-        uint8_t numberOfMappedApplicationObjectsInPDO;
         uint32_t applicationObject1;
         uint32_t applicationObject2;
         uint32_t applicationObject3;
@@ -228,37 +222,115 @@ typedef struct {
         uint32_t applicationObject6;
         uint32_t applicationObject7;
         uint32_t applicationObject8;
+        uint8_t numberOfMappedApplicationObjectsInPDO;
     } x1A03_TPDOMappingParameter;
+    uint16_t x1015_inhibitTimeEMCY;
+    uint16_t x1017_producerHeartbeatTime;
+    uint8_t x1016_consumerHeartbeatTime_sub0;
+    uint8_t x1019_synchronousCounterOverflowValue;
 } OD_PERSIST_COMM_t;
 
 typedef struct {
-    uint8_t x1001_errorRegister;
-    uint8_t x1010_storeParameters_sub0;
     uint32_t x1010_storeParameters[OD_CNT_ARR_1010];
-    uint8_t x1011_restoreDefaultParameters_sub0;
     uint32_t x1011_restoreDefaultParameters[OD_CNT_ARR_1011];
     struct {
-        uint8_t highestSub_indexSupported;
         uint32_t COB_IDClientToServerRx;
         uint32_t COB_IDServerToClientTx;
+        uint8_t highestSub_indexSupported;
     } x1200_SDOServerParameter;
     struct {
+        uint32_t COB_IDClientToServerRx;
+        uint32_t COB_IDServerToClientTx;
         uint8_t highestSub_indexSupported;
-        uint8_t data;
-    } x1F50_programDownload;
+        uint8_t node_IDOfTheSDOClient;
+    } x1201_SDOServer2Parameter;
     struct {
+        uint32_t COB_IDClientToServerRx;
+        uint32_t COB_IDServerToClientTx;
         uint8_t highestSub_indexSupported;
+        uint8_t node_IDOfTheSDOClient;
+    } x1202_SDOServer3Parameter;
+    struct {
+        uint8_t payload[8];
+        uint8_t digest[36];
+    } x1F57_programIdentification;
+    struct {
+        uint32_t imageBytes;
+        uint8_t sha256[32];
+        uint16_t crc;
+    } x2100_runningImageIdentity;
+    struct {
+        uint32_t chunks;
+        uint32_t bytes;
+        uint32_t sdoWrites;
+        uint32_t writeMinUs;
+        uint32_t writeAvgUs;
+        uint32_t writeMaxUs;
+        uint32_t eraseUs;
+        uint32_t crcUs;
+        uint32_t idleMs;
+        uint32_t metadataReadyMs;
+        uint32_t erasingMs;
+        uint32_t receivingMs;
+        uint32_t verifyingMs;
+        uint32_t readyToBootMs;
+        uint8_t writeLatencyHistogram[32];
+        uint32_t sdoStageBusyPermille;
+        uint32_t writerStageBusyPermille;
+        uint32_t pipelineStalls;
+        uint32_t pipelinePeakDepth;
+        uint32_t verifyUs;
+        uint32_t sectorsSkipped;
+        uint32_t sectorsProgrammed;
+    } x2101_fwPerfCounters;
+    struct {
+        uint32_t missingBytes;
+        uint32_t holeCount;
+        uint8_t ranges[128];
+    } x2102_fwMissingRanges;
+    struct {
+        uint32_t offset;
+        uint32_t length;
+        uint8_t region;
+    } x2103_fwReadback;
+    struct {
+        uint8_t payload[2];
+        uint8_t verifyState;
+    } x1F5A_programStatus;
+    uint8_t x1001_errorRegister;
+    uint8_t x1010_storeParameters_sub0;
+    uint8_t x1011_restoreDefaultParameters_sub0;
+    struct {
         uint8_t payload[3];
     } x1F51_programControl;
+} OD_RAM_t;
+
+typedef struct {
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x1F50_programDownload;
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x1F51_programControl;
     struct {
         uint8_t highestSub_indexSupported;
-        uint8_t payload[8];
     } x1F57_programIdentification;
     struct {
         uint8_t highestSub_indexSupported;
-        uint8_t payload[2];
     } x1F5A_programStatus;
-} OD_RAM_t;
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x2100_runningImageIdentity;
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x2101_fwPerfCounters;
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x2102_fwMissingRanges;
+    struct {
+        uint8_t highestSub_indexSupported;
+    } x2103_fwReadback;
+} OD_ROM_t;
 
 #ifndef OD_ATTR_PERSIST_COMM
 #define OD_ATTR_PERSIST_COMM
@@ -270,6 +342,11 @@ extern OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM;
 #endif
 extern OD_ATTR_RAM OD_RAM_t OD_RAM;
 
+#ifndef OD_ATTR_ROM
+#define OD_ATTR_ROM
+#endif
+extern OD_ATTR_ROM CO_PROGMEM OD_ROM_t OD_ROM;
+
 #ifndef OD_ATTR_OD
 #define OD_ATTR_OD
 #endif
@@ -295,27 +372,33 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1018 &OD->list[13]
 #define OD_ENTRY_H1019 &OD->list[14]
 #define OD_ENTRY_H1200 &OD->list[15]
-#define OD_ENTRY_H1280 &OD->list[16]
-#define OD_ENTRY_H1400 &OD->list[17]
-#define OD_ENTRY_H1401 &OD->list[18]
-#define OD_ENTRY_H1402 &OD->list[19]
-#define OD_ENTRY_H1403 &OD->list[20]
-#define OD_ENTRY_H1600 &OD->list[21]
-#define OD_ENTRY_H1601 &OD->list[22]
-#define OD_ENTRY_H1602 &OD->list[23]
-#define OD_ENTRY_H1603 &OD->list[24]
-#define OD_ENTRY_H1800 &OD->list[25]
-#define OD_ENTRY_H1801 &OD->list[26]
-#define OD_ENTRY_H1802 &OD->list[27]
-#define OD_ENTRY_H1803 &OD->list[28]
-#define OD_ENTRY_H1A00 &OD->list[29]
-#define OD_ENTRY_H1A01 &OD->list[30]
-#define OD_ENTRY_H1A02 &OD->list[31]
-#define OD_ENTRY_H1A03 &OD->list[32]
-#define OD_ENTRY_H1F50 &OD->list[33]
-#define OD_ENTRY_H1F51 &OD->list[34]
-#define OD_ENTRY_H1F57 &OD->list[35]
-#define OD_ENTRY_H1F5A &OD->list[36]
+#define OD_ENTRY_H1201 &OD->list[16]
+#define OD_ENTRY_H1202 &OD->list[17]
+#define OD_ENTRY_H1280 &OD->list[18]
+#define OD_ENTRY_H1400 &OD->list[19]
+#define OD_ENTRY_H1401 &OD->list[20]
+#define OD_ENTRY_H1402 &OD->list[21]
+#define OD_ENTRY_H1403 &OD->list[22]
+#define OD_ENTRY_H1600 &OD->list[23]
+#define OD_ENTRY_H1601 &OD->list[24]
+#define OD_ENTRY_H1602 &OD->list[25]
+#define OD_ENTRY_H1603 &OD->list[26]
+#define OD_ENTRY_H1800 &OD->list[27]
+#define OD_ENTRY_H1801 &OD->list[28]
+#define OD_ENTRY_H1802 &OD->list[29]
+#define OD_ENTRY_H1803 &OD->list[30]
+#define OD_ENTRY_H1A00 &OD->list[31]
+#define OD_ENTRY_H1A01 &OD->list[32]
+#define OD_ENTRY_H1A02 &OD->list[33]
+#define OD_ENTRY_H1A03 &OD->list[34]
+#define OD_ENTRY_H1F50 &OD->list[35]
+#define OD_ENTRY_H1F51 &OD->list[36]
+#define OD_ENTRY_H1F57 &OD->list[37]
+#define OD_ENTRY_H1F5A &OD->list[38]
+#define OD_ENTRY_H2100 &OD->list[39]
+#define OD_ENTRY_H2101 &OD->list[40]
+#define OD_ENTRY_H2102 &OD->list[41]
+#define OD_ENTRY_H2103 &OD->list[42]
 
 
 /*******************************************************************************
@@ -337,27 +420,33 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1018_identity &OD->list[13]
 #define OD_ENTRY_H1019_synchronousCounterOverflowValue &OD->list[14]
 #define OD_ENTRY_H1200_SDOServerParameter &OD->list[15]
-#define OD_ENTRY_H1280_SDOClientParameter &OD->list[16]
-#define OD_ENTRY_H1400_RPDOCommunicationParameter &OD->list[17]
-#define OD_ENTRY_H1401_RPDOCommunicationParameter &OD->list[18]
-#define OD_ENTRY_H1402_RPDOCommunicationParameter &OD->list[19]
-#define OD_ENTRY_H1403_RPDOCommunicationParameter &OD->list[20]
-#define OD_ENTRY_H1600_RPDOMappingParameter &OD->list[21]
-#define OD_ENTRY_H1601_RPDOMappingParameter &OD->list[22]
-#define OD_ENTRY_H1602_RPDOMappingParameter &OD->list[23]
-#define OD_ENTRY_H1603_RPDOMappingParameter &OD->list[24]
-#define OD_ENTRY_H1800_TPDOCommunicationParameter &OD->list[25]
-#define OD_ENTRY_H1801_TPDOCommunicationParameter &OD->list[26]
-#define OD_ENTRY_H1802_TPDOCommunicationParameter &OD->list[27]
-#define OD_ENTRY_H1803_TPDOCommunicationParameter &OD->list[28]
-#define OD_ENTRY_H1A00_TPDOMappingParameter &OD->list[29]
-#define OD_ENTRY_H1A01_TPDOMappingParameter &OD->list[30]
-#define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[31]
-#define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[32]
-#define OD_ENTRY_H1F50_programDownload &OD->list[33]
-#define OD_ENTRY_H1F51_programControl &OD->list[34]
-#define OD_ENTRY_H1F57_programIdentification &OD->list[35]
-#define OD_ENTRY_H1F5A_programStatus &OD->list[36]
+#define OD_ENTRY_H1201_SDOServer2Parameter &OD->list[16]
+#define OD_ENTRY_H1202_SDOServer3Parameter &OD->list[17]
+#define OD_ENTRY_H1280_SDOClientParameter &OD->list[18]
+#define OD_ENTRY_H1400_RPDOCommunicationParameter &OD->list[19]
+#define OD_ENTRY_H1401_RPDOCommunicationParameter &OD->list[20]
+#define OD_ENTRY_H1402_RPDOCommunicationParameter &OD->list[21]
+#define OD_ENTRY_H1403_RPDOCommunicationParameter &OD->list[22]
+#define OD_ENTRY_H1600_RPDOMappingParameter &OD->list[23]
+#define OD_ENTRY_H1601_RPDOMappingParameter &OD->list[24]
+#define OD_ENTRY_H1602_RPDOMappingParameter &OD->list[25]
+#define OD_ENTRY_H1603_RPDOMappingParameter &OD->list[26]
+#define OD_ENTRY_H1800_TPDOCommunicationParameter &OD->list[27]
+#define OD_ENTRY_H1801_TPDOCommunicationParameter &OD->list[28]
+#define OD_ENTRY_H1802_TPDOCommunicationParameter &OD->list[29]
+#define OD_ENTRY_H1803_TPDOCommunicationParameter &OD->list[30]
+#define OD_ENTRY_H1A00_TPDOMappingParameter &OD->list[31]
+#define OD_ENTRY_H1A01_TPDOMappingParameter &OD->list[32]
+#define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[33]
+#define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[34]
+#define OD_ENTRY_H1F50_programDownload &OD->list[35]
+#define OD_ENTRY_H1F51_programControl &OD->list[36]
+#define OD_ENTRY_H1F57_programIdentification &OD->list[37]
+#define OD_ENTRY_H1F5A_programStatus &OD->list[38]
+#define OD_ENTRY_H2100_runningImageIdentity &OD->list[39]
+#define OD_ENTRY_H2101_fwPerfCounters &OD->list[40]
+#define OD_ENTRY_H2102_fwMissingRanges &OD->list[41]
+#define OD_ENTRY_H2103_fwReadback &OD->list[42]
 
 
 /*******************************************************************************
@@ -3,83 +3,344 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "esp_app_desc.h"
+#include "esp_image_format.h"
 #include "esp_log.h"
 #include "esp_ota_ops.h"
 #include "esp_partition.h"
 #include "esp_system.h"
 #include <esp_timer.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
 #include "sdkconfig.h"
 
 #include "OD.h"
+#include "fw_bundle.h"
+#include "fw_digest.h"
+#include "fw_log.h"
+#include "fw_rx_map.h"
+#include "fw_storage.h"
+#include "fw_trace.h"
+#include "fw_update_core.h"
+#include "fw_write_pipeline.h"
 
 #define FW_CTRL_CMD_START 0x01U
 
+/* 0x1F50 sub-indices: 1 continues the stream at the slave's offset, 2 carries its own offset. */
+#define FW_DATA_SUB_STREAM 1U
+#define FW_DATA_SUB_FRAMED 2U
+
+/* 0x2103: sub 1..3 pick region, offset and length, sub 4 streams the bytes. */
+#define FW_READBACK_SUB_REGION 1U
+#define FW_READBACK_SUB_OFFSET 2U
+#define FW_READBACK_SUB_LENGTH 3U
+#define FW_READBACK_SUB_DATA   4U
+#define FW_READBACK_RUNNING    0U
+#define FW_READBACK_INACTIVE   1U
+/* Flash mapped at a time while a readback runs; the mapping slides along the range. */
+#define FW_READBACK_WINDOW_BYTES (64U * 1024U)
+
 #ifndef CONFIG_DEMO_SLAVE_MAX_CHUNK_BYTES
 #define CONFIG_DEMO_SLAVE_MAX_CHUNK_BYTES 256
 #endif
 
+#ifndef CONFIG_DEMO_SLAVE_WRITE_PIPELINE
+#define CONFIG_DEMO_SLAVE_WRITE_PIPELINE 0
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_VERIFY_AFTER_WRITE
+#define CONFIG_DEMO_SLAVE_VERIFY_AFTER_WRITE 0
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_CHECK_IMAGE_HEADER
+#define CONFIG_DEMO_SLAVE_CHECK_IMAGE_HEADER 0
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_REQUIRE_SAME_PROJECT
+#define CONFIG_DEMO_SLAVE_REQUIRE_SAME_PROJECT 0
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_CONFIG_PARTITION_LABEL
+#define CONFIG_DEMO_SLAVE_CONFIG_PARTITION_LABEL "fwcfg"
+#endif
+
 #ifndef CONFIG_DEMO_SLAVE_MAX_IMAGE_BYTES
 #define CONFIG_DEMO_SLAVE_MAX_IMAGE_BYTES (512 * 1024)
 #endif
 
+#define FW_PERF_HIST_BUCKETS 8U
+#define FW_PERF_HIST_BASE_US 128U
+
+/* Image header, first segment header and esp_app_desc_t: everything checked before the erase. */
+#define FW_APP_HEAD_BYTES \
+    (sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t) + sizeof(esp_app_desc_t))
+
+#define FW_VERIFY_STACK 4096U
+#define FW_VERIFY_PRIO  4U
+
+/*
+ * Every SDO server (0x1200 and the extra ones from 0x1201) is an access channel; OD accesses
+ * that come from none of them, e.g. from the application, use FW_CHANNEL_LOCAL.
+ */
+#define FW_CHANNEL_LOCAL OD_CNT_SDO_SRV
+/* A session whose owner has been silent this long may be replaced from another channel. */
+#define FW_SESSION_STALE_US (10LL * 1000000LL)
+
 static const char *TAG = "fw_server";
 static esp_timer_handle_t s_rebootTimer;
 static bool s_rebootScheduled;
 
+/* Values of 0x1F5A:02, polled by the master after finalize; keep them stable. */
 typedef enum {
-    FW_STAGE_IDLE = 0,
-    FW_STAGE_METADATA_READY,
-    FW_STAGE_ERASING_FLASH,
-    FW_STAGE_RECEIVING_BLOCKS,
-    FW_STAGE_VERIFYING,
-    FW_STAGE_READY_TO_BOOT
-} fw_stage_t;
+    FW_VERIFY_NONE = 0,
+    FW_VERIFY_RUNNING,
+    FW_VERIFY_PASSED,
+    FW_VERIFY_FAILED
+} fw_verify_state_t;
 
+/* 0x1F57:02, written after 0x1F57:01 when the master wants more than the CRC16 checked. */
+typedef struct __attribute__((packed)) {
+    uint8_t type;
+    uint8_t reserved[3];
+    uint8_t digest[FW_DIGEST_MAX_LEN];
+} fw_digest_record_t;
+
+/*
+ * Live counters for the current session. The fields touched on every chunk are grouped at
+ * the front so the data path stays within one cache line; the rest is only read on demand.
+ * Bucket i of the write histogram counts esp_ota_write calls below 128 us << i, the last
+ * bucket everything slower.
+ */
 typedef struct {
-    uint32_t imageBytes;
-    uint16_t crc;
-    uint8_t imageType;
-    uint8_t bank;
-} fw_metadata_record_t;
+    uint32_t chunks;
+    uint32_t bytes;
+    uint32_t sdoWrites;
+    uint32_t writeMinUs;
+    uint32_t writeMaxUs;
+    uint32_t writeCount;
+    uint64_t writeTotalUs;
+    uint64_t crcUs;
+    uint32_t writeHist[FW_PERF_HIST_BUCKETS];
+    uint32_t eraseUs;
+    uint32_t verifyUs;
+    int64_t stageEnteredUs;
+    uint64_t stageUs[FW_STAGE_COUNT];
+} __attribute__((aligned(32))) fw_perf_counters_t;
 
+/*
+ * Session state. The platform-neutral part (stages, sequencing, CRC/digest, storage calls)
+ * lives in core; this adds the OTA slot and config partition backends, bundle routing and
+ * the counters behind 0x2101.
+ */
 typedef struct {
-    fw_stage_t stage;
-    uint32_t expectedSize;
-    uint32_t receivedBytes;
+    fw_core_t core;
+    fw_storage_esp_t otaSlot;
+    fw_storage_esp_t configSlot;
+    fw_storage_t configStorage;
     uint32_t currentChunkBase;
-    uint16_t expectedCrc;
-    uint16_t runningCrc;
-    uint8_t currentBank;
-    uint8_t imageType;
-    bool metadataReceived;
-    bool flashPrepared;
-    bool crcMatched;
     bool chunkInProgress;
-    const esp_partition_t *targetPartition;
-    esp_ota_handle_t otaHandle;
-    bool otaOpen;
+    /*
+     * Framed chunk in progress: its offset and data length from the frame header, and how
+     * many leading bytes are already here (a resend overlapping the frontier, or a duplicate).
+     */
+    uint32_t frameOffset;
+    uint32_t frameBytes;
+    uint32_t frameSkip;
+    /*
+     * Blocks received so far. Only kept up to date once a framed chunk skipped ahead of the
+     * frontier (core.unordered); until then core.receivedBytes says everything.
+     */
+    fw_rx_map_t rxMap;
+    uint8_t rxBits[FW_RX_MAP_BYTES(CONFIG_DEMO_SLAVE_MAX_IMAGE_BYTES)];
+    /* Went out of order while the writer still hashed queued blocks; it drops the digest itself. */
+    volatile bool dropDigest;
+    /*
+     * Application images: the first FW_APP_HEAD_BYTES are held on the SDO side until the
+     * header has been checked; only then is the OTA slot erased and the held bytes written.
+     */
+    bool headPending;
+    uint32_t headFill;
+    uint8_t headBuf[FW_APP_HEAD_BYTES];
+    /* Set while the readback task owns the context; new sessions wait for it. */
+    volatile bool verifyRunning;
+    /*
+     * Bundle sessions: the table is collected on the SDO side before any section byte is
+     * handed on, then the writer routes each byte to its section and checks its digest.
+     */
+    bool bundle;
+    bool tocReady;
+    uint32_t tocFill;
+    uint8_t tocBuf[FW_BUNDLE_MAX_TOC_BYTES];
+    fw_bundle_toc_t toc;
+    uint8_t sectionIndex;
+    fw_digest_t sectionDigest;
+    const esp_partition_t *configPartition;
+    fw_perf_counters_t perf;
 } fw_update_context_t;
 
+/*
+ * Readback through 0x2103:04. The range is read straight from a flash mapping, one window
+ * at a time, so an SDO block upload of a whole partition needs no bounce buffer. Region,
+ * offset and length (0x2103:01..03) are kept here too, so each channel reads what it asked for.
+ */
+typedef struct {
+    uint8_t region;
+    uint32_t offset;
+    uint32_t size; /* 0x2103:03 as written, 0 = to the end of the partition */
+    const esp_partition_t *partition;
+    uint32_t start;
+    uint32_t length;
+    uint32_t windowStart; /* position in the range of mapped[0] */
+    uint32_t windowBytes;
+    const uint8_t *mapped;
+    esp_partition_mmap_handle_t mapHandle;
+} fw_readback_t;
+
+/*
+ * All SDO servers are processed by the one CANopen task, so the handlers below never run at
+ * the same time, but transfers on different channels interleave frame by frame. The download
+ * session therefore belongs to the channel that sent its metadata, and each channel keeps its
+ * own readback parameters and window. Two other tasks do touch the context: the verify task
+ * owns it while verifyRunning is set, and the pipeline's writer commits what fw_pipeline_push()
+ * handed it through fw_commit_block().
+ */
 typedef struct {
     CO_t *co;
     fw_update_context_t ctx;
+    uint8_t owner;   /* channel of the current session */
+    int64_t ownerUs; /* last session write from it */
+    fw_readback_t readback[FW_CHANNEL_LOCAL + 1];
     OD_extension_t metaExt;
     OD_extension_t ctrlExt;
     OD_extension_t dataExt;
     OD_extension_t statusExt;
+    OD_extension_t perfExt;
+    OD_extension_t holesExt;
+    OD_extension_t readbackExt;
 } fw_server_state_t;
 
 static fw_server_state_t s_server = {0};
 
+static bool fw_pipeline_sink(void *arg, const uint8_t *data, size_t len, uint32_t offset);
+
+static void fw_perf_reset(fw_perf_counters_t *perf) {
+    memset(perf, 0, sizeof(*perf));
+    perf->writeMinUs = UINT32_MAX;
+    perf->stageEnteredUs = esp_timer_get_time();
+}
+
+/* Core stage hook: every stage change lands here so the time spent in each stage is accounted for. */
+static void fw_stage_changed(void *arg, fw_stage_t from, fw_stage_t to) {
+    fw_perf_counters_t *perf = (fw_perf_counters_t *)arg;
+    int64_t now = esp_timer_get_time();
+    perf->stageUs[from] += (uint64_t)(now - perf->stageEnteredUs);
+    FW_TRACE(FW_EV_STAGE, from, to);
+    perf->stageEnteredUs = now;
+}
+
+static void fw_set_stage(fw_update_context_t *ctx, fw_stage_t stage) {
+    fw_core_set_stage(&ctx->core, stage);
+}
+
+/* The OTA slot the main image went to this session, NULL when none was opened. */
+static const esp_partition_t *fw_target_partition(const fw_update_context_t *ctx) {
+    return ctx->core.storageOpen || ctx->core.storageClosed ? fw_storage_esp_partition(&ctx->core.storage) : NULL;
+}
+
+static void fw_perf_note_write(fw_perf_counters_t *perf, uint32_t us) {
+    perf->writeCount++;
+    perf->writeTotalUs += us;
+    if (us < perf->writeMinUs) {
+        perf->writeMinUs = us;
+    }
+    if (us > perf->writeMaxUs) {
+        perf->writeMaxUs = us;
+    }
+    uint32_t bucket = 0U;
+    while (bucket < (FW_PERF_HIST_BUCKETS - 1U) && us >= (FW_PERF_HIST_BASE_US << bucket)) {
+        bucket++;
+    }
+    perf->writeHist[bucket]++;
+}
+
+/* Copy a snapshot into 0x2101; the stage that is still running is counted up to now. */
+static void fw_perf_publish(const fw_update_context_t *ctx) {
+    const fw_perf_counters_t *perf = &ctx->perf;
+    uint64_t stageUs[FW_STAGE_COUNT];
+    memcpy(stageUs, perf->stageUs, sizeof(stageUs));
+    stageUs[ctx->core.stage] += (uint64_t)(esp_timer_get_time() - perf->stageEnteredUs);
+
+    OD_RAM.x2101_fwPerfCounters.chunks = perf->chunks;
+    OD_RAM.x2101_fwPerfCounters.bytes = perf->bytes;
+    OD_RAM.x2101_fwPerfCounters.sdoWrites = perf->sdoWrites;
+    OD_RAM.x2101_fwPerfCounters.writeMinUs = perf->writeCount > 0U ? perf->writeMinUs : 0U;
+    OD_RAM.x2101_fwPerfCounters.writeAvgUs =
+        perf->writeCount > 0U ? (uint32_t)(perf->writeTotalUs / perf->writeCount) : 0U;
+    OD_RAM.x2101_fwPerfCounters.writeMaxUs = perf->writeMaxUs;
+    OD_RAM.x2101_fwPerfCounters.eraseUs = perf->eraseUs;
+    OD_RAM.x2101_fwPerfCounters.crcUs = (uint32_t)perf->crcUs;
+    OD_RAM.x2101_fwPerfCounters.idleMs = (uint32_t)(stageUs[FW_STAGE_IDLE] / 1000U);
+    OD_RAM.x2101_fwPerfCounters.metadataReadyMs = (uint32_t)(stageUs[FW_STAGE_METADATA_READY] / 1000U);
+    OD_RAM.x2101_fwPerfCounters.erasingMs = (uint32_t)(stageUs[FW_STAGE_ERASING_FLASH] / 1000U);
+    OD_RAM.x2101_fwPerfCounters.receivingMs = (uint32_t)(stageUs[FW_STAGE_RECEIVING_BLOCKS] / 1000U);
+    OD_RAM.x2101_fwPerfCounters.verifyingMs = (uint32_t)(stageUs[FW_STAGE_VERIFYING] / 1000U);
+    OD_RAM.x2101_fwPerfCounters.readyToBootMs = (uint32_t)(stageUs[FW_STAGE_READY_TO_BOOT] / 1000U);
+    memcpy(OD_RAM.x2101_fwPerfCounters.writeLatencyHistogram, perf->writeHist,
+           sizeof(OD_RAM.x2101_fwPerfCounters.writeLatencyHistogram));
+
+    fw_pipeline_stats_t pipe = {0};
+    if (CONFIG_DEMO_SLAVE_WRITE_PIPELINE) {
+        fw_pipeline_get_stats(&pipe);
+    }
+    OD_RAM.x2101_fwPerfCounters.sdoStageBusyPermille = pipe.producerBusyPermille;
+    OD_RAM.x2101_fwPerfCounters.writerStageBusyPermille = pipe.consumerBusyPermille;
+    OD_RAM.x2101_fwPerfCounters.pipelineStalls = pipe.stalls;
+    OD_RAM.x2101_fwPerfCounters.pipelinePeakDepth = pipe.peakDepth;
+    OD_RAM.x2101_fwPerfCounters.verifyUs = perf->verifyUs;
+    OD_RAM.x2101_fwPerfCounters.sectorsSkipped = ctx->otaSlot.sectorsSkipped + ctx->configSlot.sectorsSkipped;
+    OD_RAM.x2101_fwPerfCounters.sectorsProgrammed =
+        ctx->otaSlot.sectorsProgrammed + ctx->configSlot.sectorsProgrammed;
+}
+
+static void fw_perf_log(const fw_update_context_t *ctx) {
+    const fw_perf_counters_t *perf = &ctx->perf;
+    FW_LOGI(TAG, "Perf: %u chunks, %u bytes, %u SDO writes, ota_write min/avg/max %u/%u/%u us, erase %u us, crc %u us",
+             (unsigned)perf->chunks, (unsigned)perf->bytes, (unsigned)perf->sdoWrites,
+             (unsigned)(perf->writeCount > 0U ? perf->writeMinUs : 0U),
+             (unsigned)(perf->writeCount > 0U ? perf->writeTotalUs / perf->writeCount : 0U),
+             (unsigned)perf->writeMaxUs, (unsigned)perf->eraseUs, (unsigned)perf->crcUs);
+    if (CONFIG_DEMO_SLAVE_WRITE_PIPELINE) {
+        fw_pipeline_stats_t pipe;
+        fw_pipeline_get_stats(&pipe);
+        FW_LOGI(TAG, "Pipeline: %u blocks, SDO stage %u.%u%% busy, writer %u.%u%% busy, %u stalls, peak depth %u",
+                 (unsigned)pipe.blocks, (unsigned)(pipe.producerBusyPermille / 10U),
+                 (unsigned)(pipe.producerBusyPermille % 10U), (unsigned)(pipe.consumerBusyPermille / 10U),
+                 (unsigned)(pipe.consumerBusyPermille % 10U), (unsigned)pipe.stalls, (unsigned)pipe.peakDepth);
+    }
+}
+
 static void fw_reset_context(fw_update_context_t *ctx) {
     memset(ctx, 0, sizeof(*ctx));
-    ctx->stage = FW_STAGE_IDLE;
-    ctx->runningCrc = 0xFFFFU;
+    fw_storage_t ota;
+    fw_storage_esp_ota_init(&ota, &ctx->otaSlot);
+    fw_storage_esp_partition_init(&ctx->configStorage, &ctx->configSlot, CONFIG_DEMO_SLAVE_CONFIG_PARTITION_LABEL);
+#if CONFIG_DEMO_SLAVE_SKIP_IDENTICAL_SECTORS
+    ctx->otaSlot.skipIdentical = true;
+    ctx->configSlot.skipIdentical = true;
+#endif
+    fw_core_init(&ctx->core, &ota, CONFIG_DEMO_SLAVE_MAX_IMAGE_BYTES);
+    fw_rx_map_init(&ctx->rxMap, ctx->rxBits, sizeof(ctx->rxBits));
+    ctx->core.stageHook = fw_stage_changed;
+    ctx->core.stageArg = &ctx->perf;
+    fw_perf_reset(&ctx->perf);
 }
 
 static void fw_reboot_cb(void *arg) {
     (void)arg;
-    ESP_LOGI(TAG, "Restarting to boot new firmware");
+    /* Printing the ring delays the restart; acceptable since the image is already committed. */
+    fw_trace_dump("slave session");
+    FW_LOGI(TAG, "Restarting to boot new firmware");
     esp_restart();
 }
 
@@ -96,7 +357,7 @@ static void fw_schedule_reboot(void) {
             .name = "fw_reboot"
         };
         if (esp_timer_create(&timerArgs, &s_rebootTimer) != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to create reboot timer, restarting immediately");
+            FW_LOGE(TAG, "Failed to create reboot timer, restarting immediately");
             esp_restart();
         }
     }
@@ -105,187 +366,753 @@ static void fw_schedule_reboot(void) {
     }
 }
 
-static uint16_t fw_crc16_step(uint16_t seed, uint8_t data) {
-    seed ^= (uint16_t)data << 8;
-    for (int i = 0; i < 8; i++) {
-        if (seed & 0x8000U) {
-            seed = (uint16_t)((seed << 1) ^ 0x1021U);
-        } else {
-            seed <<= 1;
-        }
+/* Publish size, CRC16 and SHA-256 of the running image in 0x2100 so the master can skip identical uploads. */
+static void fw_publish_running_identity(void) {
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    if (running == NULL) {
+        FW_LOGW(TAG, "Running partition unknown; image identity not published");
+        return;
+    }
+
+    const esp_partition_pos_t pos = {.offset = running->address, .size = running->size};
+    esp_image_metadata_t meta = {0};
+    if (esp_image_get_metadata(&pos, &meta) != ESP_OK || meta.image_len == 0U || meta.image_len > running->size) {
+        FW_LOGW(TAG, "Cannot parse running image in %s; identity not published", running->label);
+        return;
+    }
+
+    const void *mapped = NULL;
+    esp_partition_mmap_handle_t mapHandle;
+    esp_err_t err = esp_partition_mmap(running, 0, meta.image_len, ESP_PARTITION_MMAP_DATA, &mapped, &mapHandle);
+    if (err != ESP_OK) {
+        FW_LOGW(TAG, "esp_partition_mmap failed for %s (err=0x%X)", running->label, (unsigned)err);
+        return;
     }
-    return seed;
+
+    const uint8_t *image = (const uint8_t *)mapped;
+    uint16_t crc = fw_crc16_update(0xFFFFU, image, meta.image_len);
+    (void)mbedtls_sha256(image, meta.image_len, OD_RAM.x2100_runningImageIdentity.sha256, 0);
+    esp_partition_munmap(mapHandle);
+
+    OD_RAM.x2100_runningImageIdentity.imageBytes = meta.image_len;
+    OD_RAM.x2100_runningImageIdentity.crc = crc;
+    FW_LOGI(TAG, "Running image %s: %u bytes crc=0x%04X", running->label, (unsigned)meta.image_len, crc);
 }
 
-static bool fw_store_metadata(fw_update_context_t *ctx, const fw_metadata_record_t *meta) {
-    if (meta->imageBytes == 0U) {
-        ESP_LOGE(TAG, "Metadata rejected: size is zero");
-        return false;
+/* Runs where the digest is fed: on the writer task, or after it has stopped. */
+static void fw_drop_digest(fw_update_context_t *ctx) {
+    if (ctx->dropDigest) {
+        fw_digest_abort(&ctx->core.digest);
+        ctx->dropDigest = false;
     }
-    if (meta->imageBytes > CONFIG_DEMO_SLAVE_MAX_IMAGE_BYTES) {
-        ESP_LOGE(TAG, "Metadata rejected: size %u exceeds limit", (unsigned)meta->imageBytes);
+}
+
+static bool fw_store_metadata(fw_update_context_t *ctx, const fw_metadata_record_t *meta) {
+    if (ctx->verifyRunning) {
+        FW_LOGE(TAG, "Metadata rejected: previous image is still being verified");
         return false;
     }
-    if (meta->crc == 0U) {
-        ESP_LOGE(TAG, "Metadata rejected: CRC cannot be zero");
+    if (!fw_core_metadata_valid(&ctx->core, meta)) {
         return false;
     }
 
-    ctx->expectedSize = meta->imageBytes;
-    ctx->expectedCrc = meta->crc;
-    ctx->imageType = meta->imageType;
-    ctx->currentBank = meta->bank;
-    ctx->receivedBytes = 0U;
+    /* A new session replaces any half-received one; stop its writer before touching the digest. */
+    if (fw_pipeline_active()) {
+        fw_pipeline_abort();
+    }
+    fw_drop_digest(ctx);
+    fw_digest_abort(&ctx->sectionDigest);
+    if (ctx->configPartition != NULL) {
+        fw_storage_abort(&ctx->configStorage);
+        ctx->configPartition = NULL;
+    }
     ctx->currentChunkBase = 0U;
     ctx->chunkInProgress = false;
-    ctx->targetPartition = NULL;
-    ctx->otaHandle = 0;
-    ctx->otaOpen = false;
-    ctx->runningCrc = 0xFFFFU;
-    ctx->stage = FW_STAGE_METADATA_READY;
-    ctx->metadataReceived = true;
-    ctx->flashPrepared = false;
-    ctx->crcMatched = false;
-
-    ESP_LOGI(TAG, "Metadata accepted: size=%u bytes crc=0x%04X bank=%u type=%u", (unsigned)ctx->expectedSize,
-             ctx->expectedCrc, ctx->currentBank, ctx->imageType);
+    ctx->headPending = false;
+    ctx->headFill = 0U;
+    ctx->bundle = meta->imageType == FW_BUNDLE_IMAGE_TYPE;
+    ctx->tocReady = false;
+    ctx->tocFill = 0U;
+    ctx->sectionIndex = 0U;
+    OD_RAM.x1F5A_programStatus.verifyState = FW_VERIFY_NONE;
+    fw_perf_reset(&ctx->perf);
+    fw_trace_reset();
+    FW_TRACE(FW_EV_META_RX, meta->imageBytes, meta->crc);
+    fw_core_accept_metadata(&ctx->core, meta);
+
+    FW_LOGI(TAG, "Metadata accepted: size=%u bytes crc=0x%04X bank=%u type=%u", (unsigned)ctx->core.expectedSize,
+             ctx->core.expectedCrc, ctx->core.currentBank, ctx->core.imageType);
+    return true;
+}
+
+static bool fw_store_digest(fw_update_context_t *ctx, const fw_digest_record_t *record) {
+    fw_digest_type_t type = (fw_digest_type_t)record->type;
+    if (!fw_core_store_digest(&ctx->core, type, record->digest)) {
+        return false;
+    }
+    FW_LOGI(TAG, "Digest accepted: %s", type == FW_DIGEST_SHA256 ? "SHA-256" : type == FW_DIGEST_CRC32 ? "CRC32" : "none");
+    return true;
+}
+
+/* Erase the inactive OTA slot for an image of the given size; the caller accounts the stage. */
+static bool fw_open_ota(fw_update_context_t *ctx, uint32_t imageBytes) {
+    int64_t eraseStart = esp_timer_get_time();
+    bool opened = fw_core_open_storage(&ctx->core, imageBytes);
+    uint32_t eraseUs = (uint32_t)(esp_timer_get_time() - eraseStart);
+    ctx->perf.eraseUs += eraseUs;
+    const esp_partition_t *updatePart = fw_target_partition(ctx);
+    FW_TRACE(FW_EV_ERASE_DONE, updatePart != NULL ? updatePart->address : 0U, eraseUs);
+    if (!opened) {
+        return false;
+    }
+    FW_LOGI(TAG, "Prepared OTA partition %s (%u bytes) in %u us", updatePart->label, (unsigned)updatePart->size,
+             (unsigned)eraseUs);
     return true;
 }
 
 static bool fw_prepare_storage(fw_update_context_t *ctx) {
-    if (!ctx->metadataReceived || ctx->stage != FW_STAGE_METADATA_READY) {
-        ESP_LOGE(TAG, "Cannot prepare storage before valid metadata");
+    if (!ctx->core.metadataReceived || ctx->core.stage != FW_STAGE_METADATA_READY) {
+        FW_LOGE(TAG, "Cannot prepare storage before valid metadata");
+        return false;
+    }
+    ctx->headPending = CONFIG_DEMO_SLAVE_CHECK_IMAGE_HEADER && !ctx->bundle &&
+                       ctx->core.imageType == FW_SECTION_MAIN;
+    ctx->headFill = 0U;
+    if (ctx->headPending && ctx->core.expectedSize < FW_APP_HEAD_BYTES) {
+        FW_LOGE(TAG, "Image rejected: %u bytes cannot hold an application header", (unsigned)ctx->core.expectedSize);
+        return false;
+    }
+
+    /*
+     * A bundle's destinations are only known once its table arrives (fw_open_sections), and a
+     * checked application image is only erased once its header passed (fw_collect_head).
+     */
+    bool deferErase = ctx->bundle || ctx->headPending;
+    (void)fw_rx_map_reset(&ctx->rxMap, ctx->core.expectedSize);
+    fw_set_stage(ctx, FW_STAGE_ERASING_FLASH);
+    if ((!deferErase && !fw_open_ota(ctx, ctx->core.expectedSize)) || !fw_core_begin_receiving(&ctx->core)) {
+        fw_core_cancel(&ctx->core);
         return false;
     }
 
-    const esp_partition_t *updatePart = esp_ota_get_next_update_partition(NULL);
-    if (updatePart == NULL) {
-        ESP_LOGE(TAG, "No OTA partition available for update");
+    if (CONFIG_DEMO_SLAVE_WRITE_PIPELINE && !fw_pipeline_begin(fw_pipeline_sink, ctx)) {
+        fw_core_cancel(&ctx->core);
         return false;
     }
-    if (ctx->expectedSize > updatePart->size) {
-        ESP_LOGE(TAG, "Image size %u exceeds OTA partition %s size %u", (unsigned)ctx->expectedSize,
-                 updatePart->label, (unsigned)updatePart->size);
+    return true;
+}
+
+/* Check the table against what this slave can route, then erase every destination. */
+static bool fw_open_sections(fw_update_context_t *ctx) {
+    fw_bundle_toc_t *toc = &ctx->toc;
+    if (!fw_bundle_parse(ctx->tocBuf, ctx->tocFill, toc) || toc->totalBytes != ctx->core.expectedSize) {
+        FW_LOGE(TAG, "Bundle rejected: table does not describe a %u byte bundle", (unsigned)ctx->core.expectedSize);
         return false;
     }
 
-    esp_err_t err = esp_ota_begin(updatePart, ctx->expectedSize, &ctx->otaHandle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "esp_ota_begin failed for %s (err=0x%X)", updatePart->label, (unsigned)err);
+    const fw_bundle_section_t *mainSection = NULL;
+    const fw_bundle_section_t *configSection = NULL;
+    for (uint8_t i = 0; i < toc->count; i++) {
+        const fw_bundle_section_t *section = &toc->sections[i];
+        FW_LOGI(TAG, "Bundle section %u: %s, %u bytes, bank %u", (unsigned)i, fw_bundle_section_name(section->type),
+                 (unsigned)section->size, section->bank);
+        if (section->type == FW_SECTION_MAIN && mainSection == NULL) {
+            mainSection = section;
+        } else if (section->type == FW_SECTION_CONFIG && configSection == NULL) {
+            configSection = section;
+        } else {
+            FW_LOGE(TAG, "Bundle rejected: %s section %u is duplicated or not supported",
+                     fw_bundle_section_name(section->type), (unsigned)i);
+            return false;
+        }
+    }
+
+    fw_set_stage(ctx, FW_STAGE_ERASING_FLASH);
+    bool opened = mainSection == NULL || fw_open_ota(ctx, mainSection->size);
+    if (opened && configSection != NULL) {
+        /* The config backend looks the partition up by label and refuses sections that do not fit. */
+        int64_t eraseStart = esp_timer_get_time();
+        opened = fw_storage_begin(&ctx->configStorage, configSection->bank, configSection->size);
+        uint32_t eraseUs = (uint32_t)(esp_timer_get_time() - eraseStart);
+        ctx->perf.eraseUs += eraseUs;
+        if (opened) {
+            ctx->configPartition = fw_storage_esp_partition(&ctx->configStorage);
+            FW_TRACE(FW_EV_ERASE_DONE, ctx->configPartition->address, eraseUs);
+        } else {
+            FW_LOGE(TAG, "Bundle rejected: config section (%u bytes) has no room in \"%s\"",
+                     (unsigned)configSection->size, CONFIG_DEMO_SLAVE_CONFIG_PARTITION_LABEL);
+        }
+    }
+    opened = opened && fw_digest_begin(&ctx->sectionDigest, toc->sections[0].digestType);
+    fw_set_stage(ctx, FW_STAGE_RECEIVING_BLOCKS);
+    if (!opened) {
+        fw_core_close_storage(&ctx->core);
+        if (ctx->configPartition != NULL) {
+            fw_storage_abort(&ctx->configStorage);
+            ctx->configPartition = NULL;
+        }
         return false;
     }
+    ctx->sectionIndex = 0U;
+    ctx->tocReady = true;
+    return true;
+}
 
-    ctx->targetPartition = updatePart;
-    ctx->otaOpen = true;
-    ctx->stage = FW_STAGE_ERASING_FLASH;
-    ESP_LOGI(TAG, "Prepared OTA partition %s (%u bytes)", updatePart->label, (unsigned)updatePart->size);
-    ctx->flashPrepared = true;
-    ctx->stage = FW_STAGE_RECEIVING_BLOCKS;
+/*
+ * Gather the bundle table from the first chunks. Runs on the SDO side, so destinations are
+ * erased before the first section byte is queued for the writer.
+ */
+static bool fw_collect_toc(fw_update_context_t *ctx, const uint8_t *data, uint32_t len) {
+    while (!ctx->tocReady) {
+        uint32_t want = FW_BUNDLE_HEADER_BYTES;
+        if (ctx->tocFill >= FW_BUNDLE_HEADER_BYTES) {
+            want = fw_bundle_toc_bytes(ctx->tocBuf, ctx->tocFill);
+            if (want == 0U) {
+                FW_LOGE(TAG, "Bundle rejected: bad header");
+                return false;
+            }
+            if (ctx->tocFill == want) {
+                return fw_open_sections(ctx);
+            }
+        }
+        if (len == 0U) {
+            return true;
+        }
+        uint32_t take = want - ctx->tocFill;
+        if (take > len) {
+            take = len;
+        }
+        memcpy(ctx->tocBuf + ctx->tocFill, data, take);
+        ctx->tocFill += take;
+        data += take;
+        len -= take;
+    }
     return true;
 }
 
-static bool fw_receive_chunk(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t offset) {
-    if (!ctx->flashPrepared || ctx->stage != FW_STAGE_RECEIVING_BLOCKS) {
-        ESP_LOGE(TAG, "Chunk rejected: flash not prepared or wrong stage (%d)", (int)ctx->stage);
+/* offset is where the block sits in the received stream, partOffset where it goes in the partition. */
+static bool fw_write_ota(fw_update_context_t *ctx, const uint8_t *data, size_t len, uint32_t partOffset,
+                         uint32_t offset) {
+    int64_t writeStart = esp_timer_get_time();
+    bool stored = fw_storage_write(&ctx->core.storage, partOffset, data, len);
+    int64_t writeEnd = esp_timer_get_time();
+    if (!stored) {
+        FW_LOGE(TAG, "OTA write failed at offset %u", (unsigned)offset);
         return false;
     }
-    if (!ctx->otaOpen || ctx->targetPartition == NULL) {
-        ESP_LOGE(TAG, "Chunk rejected: OTA partition not ready");
+    fw_perf_note_write(&ctx->perf, (uint32_t)(writeEnd - writeStart));
+    FW_TRACE(FW_EV_OTA_WRITE, offset, writeEnd - writeStart);
+    return true;
+}
+
+static bool fw_write_config(fw_update_context_t *ctx, const uint8_t *data, size_t len, uint32_t partOffset,
+                            uint32_t offset) {
+    int64_t writeStart = esp_timer_get_time();
+    bool stored = fw_storage_write(&ctx->configStorage, partOffset, data, len);
+    int64_t writeEnd = esp_timer_get_time();
+    if (!stored) {
+        FW_LOGE(TAG, "Config write failed at offset %u", (unsigned)offset);
         return false;
     }
-    if (offset != ctx->receivedBytes) {
-        ESP_LOGE(TAG, "Chunk rejected: expected offset %u got %u", (unsigned)ctx->receivedBytes, (unsigned)offset);
+    fw_perf_note_write(&ctx->perf, (uint32_t)(writeEnd - writeStart));
+    FW_TRACE(FW_EV_OTA_WRITE, offset, writeEnd - writeStart);
+    return true;
+}
+
+static bool fw_close_section(fw_update_context_t *ctx) {
+    const fw_bundle_section_t *section = &ctx->toc.sections[ctx->sectionIndex];
+    uint8_t computed[FW_DIGEST_MAX_LEN];
+    size_t digestLen = fw_digest_finish(&ctx->sectionDigest, computed);
+    if (digestLen == 0U || memcmp(computed, section->digest, digestLen) != 0) {
+        FW_LOGE(TAG, "Bundle section %u (%s) digest mismatch", (unsigned)ctx->sectionIndex,
+                 fw_bundle_section_name(section->type));
         return false;
     }
-    if ((ctx->receivedBytes + len) > ctx->expectedSize) {
-        ESP_LOGE(TAG, "Chunk rejected: would overflow image size (%u)", (unsigned)ctx->expectedSize);
+    FW_LOGI(TAG, "Bundle section %u (%s) received and verified", (unsigned)ctx->sectionIndex,
+             fw_bundle_section_name(section->type));
+    ctx->sectionIndex++;
+    return ctx->sectionIndex >= ctx->toc.count ||
+           fw_digest_begin(&ctx->sectionDigest, ctx->toc.sections[ctx->sectionIndex].digestType);
+}
+
+/* Split a block along section boundaries; the table itself is only hashed, never stored. */
+static bool fw_route_bundle_block(fw_update_context_t *ctx, const uint8_t *data, size_t len, uint32_t offset) {
+    while (len > 0U) {
+        if (offset < ctx->toc.tocBytes) {
+            uint32_t skip = ctx->toc.tocBytes - offset;
+            if (skip > len) {
+                skip = (uint32_t)len;
+            }
+            data += skip;
+            len -= skip;
+            offset += skip;
+            continue;
+        }
+        if (ctx->sectionIndex >= ctx->toc.count) {
+            return false;
+        }
+        const fw_bundle_section_t *section = &ctx->toc.sections[ctx->sectionIndex];
+        uint32_t sectionEnd = section->offset + section->size;
+        uint32_t take = sectionEnd - offset;
+        if (take > len) {
+            take = (uint32_t)len;
+        }
+        bool stored = section->type == FW_SECTION_MAIN
+                          ? fw_write_ota(ctx, data, take, offset - section->offset, offset)
+                          : fw_write_config(ctx, data, take, offset - section->offset, offset);
+        if (!stored) {
+            return false;
+        }
+        fw_digest_update(&ctx->sectionDigest, data, take);
+        data += take;
+        len -= take;
+        offset += take;
+        if (offset == sectionEnd && !fw_close_section(ctx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Check the held-back header against this device; nothing has been erased at this point. */
+static bool fw_check_app_head(const uint8_t *head) {
+    esp_image_header_t header;
+    esp_app_desc_t desc;
+    memcpy(&header, head, sizeof(header));
+    memcpy(&desc, head + sizeof(header) + sizeof(esp_image_segment_header_t), sizeof(desc));
+
+    if (header.magic != ESP_IMAGE_HEADER_MAGIC) {
+        FW_LOGE(TAG, "Image rejected: not an ESP application image (magic 0x%02X)", header.magic);
         return false;
     }
-    esp_err_t err = esp_ota_write(ctx->otaHandle, data, len);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "esp_ota_write failed at offset %u (err=0x%X)", (unsigned)offset, (unsigned)err);
+    if ((unsigned)header.chip_id != (unsigned)CONFIG_IDF_FIRMWARE_CHIP_ID) {
+        FW_LOGE(TAG, "Image rejected: built for chip id 0x%04X, this device is 0x%04X", (unsigned)header.chip_id,
+                 (unsigned)CONFIG_IDF_FIRMWARE_CHIP_ID);
+        return false;
+    }
+    if (header.segment_count == 0U || header.segment_count > ESP_IMAGE_MAX_SEGMENTS) {
+        FW_LOGE(TAG, "Image rejected: %u segments", (unsigned)header.segment_count);
         return false;
     }
-    ctx->receivedBytes += len;
-    for (uint32_t i = 0; i < len; i++) {
-        ctx->runningCrc = fw_crc16_step(ctx->runningCrc, data[i]);
+    if (desc.magic_word != ESP_APP_DESC_MAGIC_WORD) {
+        FW_LOGE(TAG, "Image rejected: no application description after the first segment header");
+        return false;
+    }
+    const esp_app_desc_t *running = esp_app_get_description();
+    if (CONFIG_DEMO_SLAVE_REQUIRE_SAME_PROJECT &&
+        strncmp(desc.project_name, running->project_name, sizeof(desc.project_name)) != 0) {
+        FW_LOGE(TAG, "Image rejected: project \"%.*s\" is not the running \"%s\"", (int)sizeof(desc.project_name),
+                 desc.project_name, running->project_name);
+        return false;
     }
-    ESP_LOGI(TAG, "Chunk @%u accepted (%u bytes, total %u/%u)", (unsigned)offset, (unsigned)len,
-             (unsigned)ctx->receivedBytes, (unsigned)ctx->expectedSize);
+    FW_LOGI(TAG, "Image header accepted: %.*s %.*s, %u segments", (int)sizeof(desc.project_name), desc.project_name,
+             (int)sizeof(desc.version), desc.version, (unsigned)header.segment_count);
     return true;
 }
 
-static bool fw_finalize(fw_update_context_t *ctx, uint16_t crc) {
-    if (ctx->stage != FW_STAGE_RECEIVING_BLOCKS) {
-        ESP_LOGE(TAG, "Finalize refused: wrong stage %d", (int)ctx->stage);
+/*
+ * Program one block and fold it into the digest. With the write pipeline enabled this runs
+ * on the writer task (core 1) and sees blocks combined from several chunks; otherwise it is
+ * called inline from the SDO handler. Counters it touches are only read, never reset, from
+ * the other core while a session is running.
+ */
+/* Out of order, blocks land where their offset says and readback checks the image instead of the digest. */
+static bool fw_commit_block(fw_update_context_t *ctx, const uint8_t *data, size_t len, uint32_t offset) {
+    fw_drop_digest(ctx);
+    bool stored = ctx->bundle ? fw_route_bundle_block(ctx, data, len, offset)
+                              : fw_write_ota(ctx, data, len, offset, offset);
+    if (!stored) {
         return false;
     }
-    if (!ctx->otaOpen || ctx->targetPartition == NULL) {
-        ESP_LOGE(TAG, "Finalize refused: OTA session not active");
+    if (!ctx->core.unordered) {
+        int64_t hashStart = esp_timer_get_time();
+        fw_core_absorb(&ctx->core, data, len);
+        ctx->perf.crcUs += (uint64_t)(esp_timer_get_time() - hashStart);
+    }
+    ctx->perf.bytes += (uint32_t)len;
+    return true;
+}
+
+static bool fw_pipeline_sink(void *arg, const uint8_t *data, size_t len, uint32_t offset) {
+    return fw_commit_block((fw_update_context_t *)arg, data, len, offset);
+}
+
+/* Hand stream bytes on, to the writer task or straight to flash. */
+static bool fw_store_stream(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t offset) {
+    return CONFIG_DEMO_SLAVE_WRITE_PIPELINE ? fw_pipeline_push(data, len) : fw_commit_block(ctx, data, len, offset);
+}
+
+/* Same for a framed chunk past the frontier; the writer starts a new block where it does not continue the last. */
+static bool fw_store_at(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t offset) {
+    return CONFIG_DEMO_SLAVE_WRITE_PIPELINE ? fw_pipeline_push_at(data, len, offset)
+                                            : fw_commit_block(ctx, data, len, offset);
+}
+
+/*
+ * Hold the first bytes of an application image until the header can be checked. Runs on the
+ * SDO side, so a wrong image is refused on the chunk that completes the header, before the
+ * OTA slot is erased. A refused image also drops the metadata; the master has to start over.
+ */
+static bool fw_collect_head(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t *consumed) {
+    uint32_t take = FW_APP_HEAD_BYTES - ctx->headFill;
+    if (take > len) {
+        take = len;
+    }
+    memcpy(ctx->headBuf + ctx->headFill, data, take);
+    ctx->headFill += take;
+    *consumed = take;
+    if (ctx->headFill < FW_APP_HEAD_BYTES) {
+        return true;
+    }
+
+    bool accepted = fw_check_app_head(ctx->headBuf);
+    FW_TRACE(FW_EV_IMAGE_HEADER, accepted, ((const esp_image_header_t *)ctx->headBuf)->chip_id);
+    ctx->headPending = false;
+    if (!accepted) {
+        if (fw_pipeline_active()) {
+            fw_pipeline_abort();
+        }
+        fw_core_cancel(&ctx->core);
+        ctx->core.metadataReceived = false;
+        return false;
+    }
+    fw_set_stage(ctx, FW_STAGE_ERASING_FLASH);
+    bool opened = fw_open_ota(ctx, ctx->core.expectedSize);
+    fw_set_stage(ctx, FW_STAGE_RECEIVING_BLOCKS);
+    return opened && fw_store_stream(ctx, ctx->headBuf, FW_APP_HEAD_BYTES, 0U);
+}
+
+static bool fw_receive_chunk(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t offset) {
+    if (ctx->core.unordered) {
+        FW_LOGE(TAG, "Chunk rejected: session went out of order, only framed chunks are accepted");
         return false;
     }
-    if (ctx->receivedBytes != ctx->expectedSize) {
-        ESP_LOGE(TAG, "Finalize refused: received %u bytes but expected %u", (unsigned)ctx->receivedBytes,
-                 (unsigned)ctx->expectedSize);
+    if (!fw_core_check_chunk(&ctx->core, offset, len)) {
         return false;
     }
-    ctx->stage = FW_STAGE_VERIFYING;
-    if (ctx->runningCrc != crc || ctx->runningCrc != ctx->expectedCrc) {
-        ESP_LOGE(TAG, "CRC mismatch: computed 0x%04X expected 0x%04X (declared 0x%04X)", ctx->runningCrc,
-                 crc, ctx->expectedCrc);
+    if (!ctx->bundle && !ctx->headPending && !ctx->core.storageOpen) {
+        FW_LOGE(TAG, "Chunk rejected: OTA partition not ready");
         return false;
     }
-    esp_err_t err = esp_ota_end(ctx->otaHandle);
-    ctx->otaOpen = false;
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "esp_ota_end failed (err=0x%X)", (unsigned)err);
+    FW_TRACE(FW_EV_CHUNK_RX, offset, len);
+    if (ctx->bundle && !fw_collect_toc(ctx, data, len)) {
+        return false;
+    }
+    uint32_t held = 0U;
+    if (ctx->headPending && !fw_collect_head(ctx, data, len, &held)) {
+        return false;
+    }
+    bool stored = held == len || fw_store_stream(ctx, data + held, len - held, offset + held);
+    if (!stored) {
+        FW_LOGE(TAG, "Chunk @%u could not be stored", (unsigned)offset);
         return false;
     }
+    ctx->core.receivedBytes += len;
+    FW_LOGD(TAG, "Chunk @%u accepted (%u bytes, total %u/%u)", (unsigned)offset, (unsigned)len,
+             (unsigned)ctx->core.receivedBytes, (unsigned)ctx->core.expectedSize);
+    return true;
+}
 
-    err = esp_ota_set_boot_partition(ctx->targetPartition);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to set boot partition to %s (err=0x%X)", ctx->targetPartition->label, (unsigned)err);
+/*
+ * A framed chunk landed past the frontier. From here on data is written where it belongs and
+ * tracked in rxMap; the streaming CRC/digest is dropped and finalize checks the image by
+ * reading it back. Bundles, images whose header has not been checked yet and skip-identical
+ * slots need their data in order and refuse.
+ */
+static bool fw_go_unordered(fw_update_context_t *ctx, uint32_t offset) {
+    if (ctx->bundle || !ctx->core.storageOpen || ctx->core.receivedBytes == 0U || ctx->otaSlot.skipIdentical) {
+        FW_TRACE(FW_EV_CHUNK_REJECT, offset, ctx->core.receivedBytes);
+        FW_LOGE(TAG, "Chunk @%u rejected: this session takes data in order only (expected offset %u)",
+                 (unsigned)offset, (unsigned)ctx->core.receivedBytes);
+        return false;
+    }
+    FW_TRACE(FW_EV_UNORDERED, offset, ctx->core.receivedBytes);
+    FW_LOGW(TAG, "Chunk @%u skips ahead of %u; continuing out of order, the image will be checked by readback",
+             (unsigned)offset, (unsigned)ctx->core.receivedBytes);
+    if (fw_pipeline_active()) {
+        /* The writer keeps going; blocks still queued were hashed in order, so it drops the digest after them. */
+        ctx->dropDigest = true;
+        ctx->core.unordered = true;
+    } else {
+        fw_core_mark_unordered(&ctx->core);
+    }
+    fw_rx_map_mark(&ctx->rxMap, 0U, ctx->core.receivedBytes);
+    return true;
+}
+
+/* Check the header of a framed chunk and work out how much of it is new. */
+static bool fw_begin_frame(fw_update_context_t *ctx, uint32_t offset, uint32_t len) {
+    if (!ctx->core.flashPrepared || ctx->core.stage != FW_STAGE_RECEIVING_BLOCKS) {
+        FW_LOGE(TAG, "Chunk rejected: flash not prepared or wrong stage (%d)", (int)ctx->core.stage);
         return false;
     }
+    if (!fw_rx_map_aligned(&ctx->rxMap, offset, len)) {
+        FW_LOGE(TAG, "Framed chunk @%u (%u bytes) is not on %u byte blocks or overruns the image", (unsigned)offset,
+                 (unsigned)len, (unsigned)FW_RX_BLOCK_BYTES);
+        return false;
+    }
+    ctx->frameOffset = offset;
+    ctx->frameBytes = len;
+    ctx->frameSkip = 0U;
+    if (ctx->core.unordered) {
+        if (fw_rx_map_covered(&ctx->rxMap, offset, len)) {
+            ctx->frameSkip = len;
+        }
+        return true;
+    }
+    uint32_t frontier = ctx->core.receivedBytes;
+    if (offset <= frontier) {
+        /* A resend after a lost acknowledge or an aborted chunk: only the part past the frontier is new. */
+        ctx->frameSkip = frontier - offset < len ? frontier - offset : len;
+        return true;
+    }
+    return fw_go_unordered(ctx, offset);
+}
 
-    ctx->crcMatched = true;
-    ctx->stage = FW_STAGE_READY_TO_BOOT;
-    ESP_LOGI(TAG, "Firmware image validated (crc=0x%04X). Next boot will use partition %s", ctx->runningCrc,
-             ctx->targetPartition->label);
+/* One server buffer of a framed chunk; pos counts data bytes from the start of the frame. */
+static bool fw_receive_framed(fw_update_context_t *ctx, const uint8_t *data, uint32_t len, uint32_t pos) {
+    if (pos < ctx->frameSkip) {
+        uint32_t drop = ctx->frameSkip - pos < len ? ctx->frameSkip - pos : len;
+        data += drop;
+        len -= drop;
+        pos += drop;
+    }
+    if (len == 0U) {
+        return true;
+    }
+    uint32_t offset = ctx->frameOffset + pos;
+    if (!ctx->core.unordered) {
+        return fw_receive_chunk(ctx, data, len, offset);
+    }
+    FW_TRACE(FW_EV_CHUNK_RX, offset, len);
+    return fw_store_at(ctx, data, len, offset);
+}
+
+/* Blocks count as received only once their whole chunk is in, so an aborted chunk leaves a hole. */
+static void fw_end_frame(fw_update_context_t *ctx) {
+    if (ctx->core.unordered) {
+        fw_rx_map_mark(&ctx->rxMap, ctx->frameOffset, ctx->frameBytes);
+        ctx->core.receivedBytes = fw_rx_map_frontier(&ctx->rxMap);
+    }
+}
+
+/* One reboot per session, also for a bundle that only carries configuration. */
+static bool fw_activate_image(fw_update_context_t *ctx) {
+    if (!fw_core_activate(&ctx->core)) {
+        return false;
+    }
+    const esp_partition_t *target = fw_target_partition(ctx);
+    FW_LOGI(TAG, "Firmware image validated (crc=0x%04X). Next boot will use partition %s", ctx->core.runningCrc,
+             target != NULL ? target->label : "(unchanged)");
     fw_schedule_reboot();
     return true;
 }
 
+/*
+ * Hash what actually landed in flash. The partition is mapped into the data address space
+ * so the digest reads straight through the flash cache, with no bounce buffer or
+ * esp_partition_read copies. Without a digest the CRC16 is checked instead.
+ */
+static bool fw_verify_region(fw_update_context_t *ctx, const esp_partition_t *part, uint32_t size,
+                             fw_digest_type_t type, const uint8_t *expectedDigest) {
+    const void *mapped = NULL;
+    esp_partition_mmap_handle_t mapHandle;
+    esp_err_t err = esp_partition_mmap(part, 0, size, ESP_PARTITION_MMAP_DATA, &mapped, &mapHandle);
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "esp_partition_mmap failed for %s (err=0x%X)", part->label, (unsigned)err);
+        return false;
+    }
+
+    bool matched;
+    if (type != FW_DIGEST_NONE) {
+        uint8_t computed[FW_DIGEST_MAX_LEN];
+        size_t digestLen = 0U;
+        if (fw_digest_begin(&ctx->core.digest, type)) {
+            fw_digest_update(&ctx->core.digest, mapped, size);
+            digestLen = fw_digest_finish(&ctx->core.digest, computed);
+        }
+        matched = digestLen > 0U && memcmp(computed, expectedDigest, digestLen) == 0;
+    } else {
+        matched = fw_crc16_update(0xFFFFU, mapped, size) == ctx->core.expectedCrc;
+    }
+    esp_partition_munmap(mapHandle);
+    if (!matched) {
+        FW_LOGE(TAG, "Readback of %s does not match the received image", part->label);
+    }
+    return matched;
+}
+
+static bool fw_verify_flash(fw_update_context_t *ctx) {
+    int64_t start = esp_timer_get_time();
+    bool matched = true;
+    if (ctx->bundle) {
+        for (uint8_t i = 0; i < ctx->toc.count && matched; i++) {
+            const fw_bundle_section_t *section = &ctx->toc.sections[i];
+            const esp_partition_t *part =
+                section->type == FW_SECTION_MAIN ? fw_target_partition(ctx) : ctx->configPartition;
+            matched = fw_verify_region(ctx, part, section->size, section->digestType, section->digest);
+        }
+    } else {
+        matched = fw_verify_region(ctx, fw_target_partition(ctx), ctx->core.expectedSize, ctx->core.digestType,
+                                   ctx->core.expectedDigest);
+    }
+
+    ctx->perf.verifyUs = (uint32_t)(esp_timer_get_time() - start);
+    FW_TRACE(FW_EV_VERIFY_DONE, matched, ctx->perf.verifyUs);
+    if (matched) {
+        FW_LOGI(TAG, "Readback of %u bytes verified in %u us", (unsigned)ctx->core.expectedSize,
+                 (unsigned)ctx->perf.verifyUs);
+    }
+    return matched;
+}
+
+static bool fw_verify_and_activate(fw_update_context_t *ctx) {
+    bool ok = fw_verify_flash(ctx) && fw_activate_image(ctx);
+    if (!ok) {
+        /* The bank holds a complete but untrusted image; the master has to start over. */
+        fw_set_stage(ctx, FW_STAGE_IDLE);
+        ctx->core.metadataReceived = false;
+    }
+    OD_RAM.x1F5A_programStatus.verifyState = ok ? FW_VERIFY_PASSED : FW_VERIFY_FAILED;
+    ctx->verifyRunning = false;
+    return ok;
+}
+
+static void fw_verify_task(void *arg) {
+    if (!fw_verify_and_activate((fw_update_context_t *)arg)) {
+        fw_trace_dump("slave session");
+    }
+    vTaskDelete(NULL);
+}
+
+/* Finalize is acknowledged right away; the master polls 0x1F5A:02 for the outcome. */
+static bool fw_start_verify(fw_update_context_t *ctx) {
+    ctx->verifyRunning = true;
+    OD_RAM.x1F5A_programStatus.verifyState = FW_VERIFY_RUNNING;
+    if (xTaskCreate(fw_verify_task, "fw_verify", FW_VERIFY_STACK, ctx, FW_VERIFY_PRIO, NULL) == pdPASS) {
+        return true;
+    }
+    FW_LOGW(TAG, "Unable to create verify task; verifying inline");
+    return fw_verify_and_activate(ctx);
+}
+
+static bool fw_finalize(fw_update_context_t *ctx, uint16_t crc) {
+    if (!fw_core_check_complete(&ctx->core)) {
+        return false;
+    }
+    if (ctx->bundle ? !ctx->tocReady : !ctx->core.storageOpen) {
+        FW_LOGE(TAG, "Finalize refused: OTA session not active");
+        return false;
+    }
+    fw_set_stage(ctx, FW_STAGE_VERIFYING);
+    if (fw_pipeline_active() && !fw_pipeline_finish()) {
+        FW_LOGE(TAG, "Finalize refused: writing the last blocks failed");
+        fw_perf_log(ctx);
+        return false;
+    }
+    fw_drop_digest(ctx);
+    fw_perf_log(ctx);
+    if (ctx->bundle && ctx->sectionIndex != ctx->toc.count) {
+        FW_LOGE(TAG, "Finalize refused: only %u of %u bundle sections verified", (unsigned)ctx->sectionIndex,
+                 (unsigned)ctx->toc.count);
+        return false;
+    }
+    /* Checks the CRC16 or digest and closes the OTA slot; the config partition needs no close. */
+    if (!fw_core_finish(&ctx->core, crc)) {
+        return false;
+    }
+    if (ctx->configPartition != NULL) {
+        (void)fw_storage_end(&ctx->configStorage);
+    }
+
+    /* Out-of-order data was never hashed in sequence, so readback is the only check it gets. */
+    if (CONFIG_DEMO_SLAVE_VERIFY_AFTER_WRITE || ctx->core.unordered) {
+        return fw_start_verify(ctx);
+    }
+    return fw_activate_image(ctx);
+}
+
 static fw_server_state_t *fw_get_server(OD_stream_t *stream) {
     (void)stream;
     return &s_server;
 }
 
+/* The SDO server whose transfer this stream belongs to. */
+static uint8_t fw_sdo_channel(const fw_server_state_t *server, const OD_stream_t *stream) {
+    for (uint8_t i = 0; i < OD_CNT_SDO_SRV; i++) {
+        if (stream == &server->co->SDOserver[i].OD_IO.stream) {
+            return i;
+        }
+    }
+    return FW_CHANNEL_LOCAL;
+}
+
+/*
+ * Gate for the session objects 0x1F57, 0x1F51, 0x1F50 and 0x1F5A. While a session runs, only
+ * its owner gets through; a metadata write (claim) from another channel starts a new session
+ * only once the owner has gone quiet. Diagnostic objects are not gated.
+ */
+static bool fw_session_access(fw_server_state_t *server, const OD_stream_t *stream, bool claim) {
+    uint8_t channel = fw_sdo_channel(server, stream);
+    int64_t now = esp_timer_get_time();
+    bool held = server->ctx.core.stage != FW_STAGE_IDLE || server->ctx.verifyRunning;
+    if (held && channel != server->owner && !(claim && (now - server->ownerUs) >= FW_SESSION_STALE_US)) {
+        if (stream->dataOffset == 0U) {
+            FW_LOGW(TAG, "SDO channel %u refused: session belongs to channel %u", (unsigned)channel,
+                    (unsigned)server->owner);
+        }
+        return false;
+    }
+    if (claim || !held) {
+        server->owner = channel;
+    }
+    server->ownerUs = now;
+    return true;
+}
+
+/* Snapshots in OD_RAM are only refreshed while no other channel is partway through reading them. */
+static bool fw_object_read_elsewhere(const fw_server_state_t *server, const OD_stream_t *stream, uint16_t index) {
+    for (uint8_t i = 0; i < OD_CNT_SDO_SRV; i++) {
+        const CO_SDOserver_t *sdo = &server->co->SDOserver[i];
+        if (stream != &sdo->OD_IO.stream && sdo->state != CO_SDO_ST_IDLE && sdo->index == index) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static ODR_t fw_write_metadata(OD_stream_t *stream, const void *buf, OD_size_t count, OD_size_t *countWritten) {
     if (stream->subIndex == 0U) {
         return OD_writeOriginal(stream, buf, count, countWritten);
     }
-    if (stream->subIndex != 1U) {
+    if (stream->subIndex != 1U && stream->subIndex != 2U) {
         return ODR_SUB_NOT_EXIST;
     }
     if (buf == NULL || count == 0U) {
         return ODR_NO_DATA;
     }
-    if ((stream->dataOffset + count) > sizeof(fw_metadata_record_t)) {
+    size_t recordBytes = stream->subIndex == 1U ? sizeof(fw_metadata_record_t) : sizeof(fw_digest_record_t);
+    if ((stream->dataOffset + count) > recordBytes) {
         return ODR_DATA_LONG;
     }
+    if (!fw_session_access(fw_get_server(stream), stream, stream->subIndex == 1U)) {
+        return ODR_DATA_DEV_STATE;
+    }
 
     ODR_t ret = OD_writeOriginal(stream, buf, count, countWritten);
     if (ret == ODR_PARTIAL || ret != ODR_OK) {
         return ret;
     }
-
-    const fw_metadata_record_t *meta = (const fw_metadata_record_t *)stream->dataOrig;
-    if (meta == NULL) {
+    if (stream->dataOrig == NULL) {
         return ODR_DEV_INCOMPAT;
     }
 
     fw_server_state_t *server = fw_get_server(stream);
+    if (stream->subIndex == 2U) {
+        return fw_store_digest(&server->ctx, (const fw_digest_record_t *)stream->dataOrig) ? ODR_OK
+                                                                                           : ODR_INVALID_VALUE;
+    }
+    const fw_metadata_record_t *meta = (const fw_metadata_record_t *)stream->dataOrig;
     if (!fw_store_metadata(&server->ctx, meta)) {
         return ODR_INVALID_VALUE;
     }
@@ -304,12 +1131,15 @@ static ODR_t fw_write_control(OD_stream_t *stream, const void *buf, OD_size_t co
     }
     const uint8_t *payload = (const uint8_t *)buf;
     fw_server_state_t *server = fw_get_server(stream);
+    if (!fw_session_access(server, stream, false)) {
+        return ODR_DATA_DEV_STATE;
+    }
     if (payload[0] != FW_CTRL_CMD_START) {
-        ESP_LOGE(TAG, "Unsupported control command 0x%02X", payload[0]);
+        FW_LOGE(TAG, "Unsupported control command 0x%02X", payload[0]);
         return ODR_INVALID_VALUE;
     }
-    if (!server->ctx.metadataReceived) {
-        ESP_LOGE(TAG, "Start command received before metadata");
+    if (!server->ctx.core.metadataReceived) {
+        FW_LOGE(TAG, "Start command received before metadata");
         return ODR_INVALID_VALUE;
     }
     if (!fw_prepare_storage(&server->ctx)) {
@@ -322,28 +1152,73 @@ static ODR_t fw_write_control(OD_stream_t *stream, const void *buf, OD_size_t co
     return ret;
 }
 
+/* 0x1F50:02 payload: u32 offset (little endian), then the data; see fw_rx_map.h. */
+static bool fw_receive_framed_part(fw_update_context_t *ctx, const OD_stream_t *stream, const uint8_t *buf,
+                                   uint32_t count) {
+    if (stream->dataOffset != 0U) {
+        return fw_receive_framed(ctx, buf, count, (uint32_t)stream->dataOffset - FW_RX_FRAME_HEADER_BYTES);
+    }
+    if (count <= FW_RX_FRAME_HEADER_BYTES || stream->dataLength <= FW_RX_FRAME_HEADER_BYTES) {
+        FW_LOGE(TAG, "Framed chunk rejected: needs a size-indicated transfer with data after the offset");
+        return false;
+    }
+    uint32_t offset = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    if (!fw_begin_frame(ctx, offset, (uint32_t)stream->dataLength - FW_RX_FRAME_HEADER_BYTES)) {
+        return false;
+    }
+    return fw_receive_framed(ctx, buf + FW_RX_FRAME_HEADER_BYTES, count - FW_RX_FRAME_HEADER_BYTES, 0U);
+}
+
 static ODR_t fw_write_data(OD_stream_t *stream, const void *buf, OD_size_t count, OD_size_t *countWritten) {
     if (stream->subIndex == 0U) {
         return ODR_READONLY;
     }
-    if (stream->subIndex != 1U) {
+    if (stream->subIndex != FW_DATA_SUB_STREAM && stream->subIndex != FW_DATA_SUB_FRAMED) {
         return ODR_SUB_NOT_EXIST;
     }
     if (count == 0U || buf == NULL) {
         return ODR_NO_DATA;
     }
-    if (count > CONFIG_DEMO_SLAVE_MAX_CHUNK_BYTES) {
-        ESP_LOGE(TAG, "Chunk too large (%u > %u)", (unsigned)count, CONFIG_DEMO_SLAVE_MAX_CHUNK_BYTES);
+    bool framed = stream->subIndex == FW_DATA_SUB_FRAMED;
+    uint32_t limit = CONFIG_DEMO_SLAVE_MAX_CHUNK_BYTES + (framed ? FW_RX_FRAME_HEADER_BYTES : 0U);
+    if (count > limit) {
+        FW_LOGE(TAG, "Chunk too large (%u > %u)", (unsigned)count, (unsigned)limit);
         return ODR_DATA_LONG;
     }
     fw_server_state_t *server = fw_get_server(stream);
+    if (!fw_session_access(server, stream, false)) {
+        return ODR_DATA_DEV_STATE;
+    }
     fw_update_context_t *ctx = &server->ctx;
-    if (stream->dataOffset == 0U) {
-        ctx->currentChunkBase = ctx->receivedBytes;
-        ctx->chunkInProgress = true;
+    /*
+     * With the writer behind, refuse the whole chunk before anything is taken from it rather
+     * than hold the CANopen task; the master sends it again. A chunk larger than the SDO
+     * server's buffer arrives in several calls, so room is checked once for all of it (the
+     * announced size, or the limit when none was given). Held header bytes go out with it.
+     */
+    if (fw_pipeline_active() && stream->dataOffset == 0U) {
+        uint32_t chunkBytes = stream->dataLength != 0U ? (uint32_t)stream->dataLength : limit;
+        if (framed) {
+            chunkBytes = chunkBytes > FW_RX_FRAME_HEADER_BYTES ? chunkBytes - FW_RX_FRAME_HEADER_BYTES : 0U;
+        }
+        uint32_t storeBytes = chunkBytes + (ctx->headPending ? FW_APP_HEAD_BYTES : 0U);
+        if (!fw_pipeline_has_room(storeBytes, framed)) {
+            return ODR_OUT_OF_MEM;
+        }
+    }
+    ctx->perf.sdoWrites++;
+    bool accepted;
+    if (framed) {
+        accepted = fw_receive_framed_part(ctx, stream, (const uint8_t *)buf, (uint32_t)count);
+    } else {
+        if (stream->dataOffset == 0U) {
+            ctx->currentChunkBase = ctx->core.receivedBytes;
+            ctx->chunkInProgress = true;
+        }
+        uint32_t absoluteOffset = ctx->currentChunkBase + (uint32_t)stream->dataOffset;
+        accepted = fw_receive_chunk(ctx, (const uint8_t *)buf, (uint32_t)count, absoluteOffset);
     }
-    uint32_t absoluteOffset = ctx->currentChunkBase + (uint32_t)stream->dataOffset;
-    if (!fw_receive_chunk(ctx, (const uint8_t *)buf, (uint32_t)count, absoluteOffset)) {
+    if (!accepted) {
         return ODR_INVALID_VALUE;
     }
     OD_size_t nextOffset = stream->dataOffset + count;
@@ -353,8 +1228,12 @@ static ODR_t fw_write_data(OD_stream_t *stream, const void *buf, OD_size_t count
     }
     bool finalChunk = (stream->dataLength != 0U) && (nextOffset >= stream->dataLength);
     if (finalChunk) {
+        ctx->perf.chunks++;
+        if (framed) {
+            fw_end_frame(ctx);
+        }
         ctx->chunkInProgress = false;
-        ctx->currentChunkBase = ctx->receivedBytes;
+        ctx->currentChunkBase = ctx->core.receivedBytes;
     }
     return finalChunk ? ODR_OK : ODR_PARTIAL;
 }
@@ -370,9 +1249,15 @@ static ODR_t fw_write_status(OD_stream_t *stream, const void *buf, OD_size_t cou
         return ODR_DATA_LONG;
     }
     fw_server_state_t *server = fw_get_server(stream);
+    if (!fw_session_access(server, stream, false)) {
+        return ODR_DATA_DEV_STATE;
+    }
     const uint8_t *payload = (const uint8_t *)buf;
     uint16_t crc = (uint16_t)payload[0] | ((uint16_t)payload[1] << 8);
-    if (!fw_finalize(&server->ctx, crc)) {
+    bool finalized = fw_finalize(&server->ctx, crc);
+    FW_TRACE(FW_EV_FINALIZE_RX, crc, finalized);
+    if (!finalized) {
+        fw_trace_dump("slave session");
         return ODR_INVALID_VALUE;
     }
     ODR_t ret = OD_writeOriginal(stream, buf, count, countWritten);
@@ -382,12 +1267,226 @@ static ODR_t fw_write_status(OD_stream_t *stream, const void *buf, OD_size_t cou
     return ret;
 }
 
+static ODR_t fw_read_perf(OD_stream_t *stream, void *buf, OD_size_t count, OD_size_t *countRead) {
+    /* Refresh once per SDO upload; later segments of the histogram read the same snapshot. */
+    fw_server_state_t *server = fw_get_server(stream);
+    if (stream->subIndex != 0U && stream->dataOffset == 0U && !fw_object_read_elsewhere(server, stream, 0x2101U)) {
+        fw_perf_publish(&server->ctx);
+    }
+    return OD_readOriginal(stream, buf, count, countRead);
+}
+
+/* Fill 0x2102 from the bitmap, or from the frontier while the session is still in order. */
+static void fw_holes_publish(const fw_update_context_t *ctx) {
+    const fw_core_t *core = &ctx->core;
+    fw_rx_range_t ranges[FW_RX_MAX_RANGES];
+    uint32_t holes = 0U;
+    uint32_t missing = 0U;
+    if (core->unordered) {
+        holes = fw_rx_map_holes(&ctx->rxMap, ranges, FW_RX_MAX_RANGES);
+        missing = fw_rx_map_missing_bytes(&ctx->rxMap);
+    } else if (core->flashPrepared && core->receivedBytes < core->expectedSize) {
+        /* Framed resends have to start on a block, so the hole does too. */
+        ranges[0].offset = core->receivedBytes - core->receivedBytes % FW_RX_BLOCK_BYTES;
+        ranges[0].length = core->expectedSize - ranges[0].offset;
+        holes = 1U;
+        missing = core->expectedSize - core->receivedBytes;
+    }
+    OD_RAM.x2102_fwMissingRanges.missingBytes = missing;
+    OD_RAM.x2102_fwMissingRanges.holeCount = holes;
+    fw_rx_ranges_encode(ranges, holes < FW_RX_MAX_RANGES ? holes : FW_RX_MAX_RANGES,
+                        OD_RAM.x2102_fwMissingRanges.ranges);
+}
+
+static ODR_t fw_read_holes(OD_stream_t *stream, void *buf, OD_size_t count, OD_size_t *countRead) {
+    fw_server_state_t *server = fw_get_server(stream);
+    if (stream->subIndex != 0U && stream->dataOffset == 0U && !fw_object_read_elsewhere(server, stream, 0x2102U)) {
+        fw_holes_publish(&server->ctx);
+    }
+    return OD_readOriginal(stream, buf, count, countRead);
+}
+
+static void fw_readback_unmap(fw_readback_t *rb) {
+    if (rb->mapped != NULL) {
+        esp_partition_munmap(rb->mapHandle);
+        rb->mapped = NULL;
+    }
+}
+
+/*
+ * Resolve the channel's 0x2103:01..03 at the start of an upload. A transfer aborted on the same channel
+ * leaves its window mapped; it is released here. The update slot is not served while a
+ * session is erasing or writing it.
+ */
+static ODR_t fw_readback_open(fw_server_state_t *server, fw_readback_t *rb) {
+    fw_readback_unmap(rb);
+    rb->partition = NULL;
+
+    const esp_partition_t *part;
+    if (rb->region == FW_READBACK_RUNNING) {
+        part = esp_ota_get_running_partition();
+    } else {
+        fw_stage_t stage = server->ctx.core.stage;
+        if (stage == FW_STAGE_ERASING_FLASH || stage == FW_STAGE_RECEIVING_BLOCKS) {
+            FW_LOGW(TAG, "Readback of the update slot refused while a session writes it");
+            return ODR_DATA_DEV_STATE;
+        }
+        part = esp_ota_get_next_update_partition(NULL);
+    }
+    if (part == NULL) {
+        return ODR_DATA_DEV_STATE;
+    }
+
+    uint32_t offset = rb->offset;
+    uint32_t length = rb->size;
+    if (offset >= part->size || length > part->size - offset) {
+        FW_LOGE(TAG, "Readback range %u+%u outside %s (%u bytes)", (unsigned)offset, (unsigned)length, part->label,
+                (unsigned)part->size);
+        return ODR_DATA_DEV_STATE;
+    }
+    rb->partition = part;
+    rb->start = offset;
+    rb->length = length == 0U ? part->size - offset : length;
+    rb->windowStart = 0U;
+    rb->windowBytes = 0U;
+    FW_LOGI(TAG, "Readback of %s: %u bytes at 0x%X", part->label, (unsigned)rb->length, (unsigned)offset);
+    return ODR_OK;
+}
+
+static bool fw_readback_map(fw_readback_t *rb, uint32_t pos) {
+    fw_readback_unmap(rb);
+    uint32_t bytes = rb->length - pos;
+    if (bytes > FW_READBACK_WINDOW_BYTES) {
+        bytes = FW_READBACK_WINDOW_BYTES;
+    }
+    const void *mapped = NULL;
+    esp_err_t err =
+        esp_partition_mmap(rb->partition, rb->start + pos, bytes, ESP_PARTITION_MMAP_DATA, &mapped, &rb->mapHandle);
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "esp_partition_mmap failed for %s (err=0x%X)", rb->partition->label, (unsigned)err);
+        return false;
+    }
+    rb->mapped = (const uint8_t *)mapped;
+    rb->windowStart = pos;
+    rb->windowBytes = bytes;
+    return true;
+}
+
+/* Size of the 0x2103 parameter sub-indices, 0 for the others. */
+static OD_size_t fw_readback_param_size(uint8_t subIndex) {
+    switch (subIndex) {
+    case FW_READBACK_SUB_REGION:
+        return sizeof(uint8_t);
+    case FW_READBACK_SUB_OFFSET:
+    case FW_READBACK_SUB_LENGTH:
+        return sizeof(uint32_t);
+    default:
+        return 0U;
+    }
+}
+
+/* 0x2103:01..03 go to the writing channel only; a tool on 0x1201 cannot move the master's range. */
+static ODR_t fw_write_readback(OD_stream_t *stream, const void *buf, OD_size_t count, OD_size_t *countWritten) {
+    OD_size_t size = fw_readback_param_size(stream->subIndex);
+    if (size == 0U) {
+        return OD_writeOriginal(stream, buf, count, countWritten);
+    }
+    if (buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (count != size) {
+        return count > size ? ODR_DATA_LONG : ODR_DATA_SHORT;
+    }
+    fw_server_state_t *server = fw_get_server(stream);
+    fw_readback_t *rb = &server->readback[fw_sdo_channel(server, stream)];
+    switch (stream->subIndex) {
+    case FW_READBACK_SUB_REGION:
+        if (CO_getUint8(buf) > FW_READBACK_INACTIVE) {
+            return ODR_VALUE_HIGH;
+        }
+        rb->region = CO_getUint8(buf);
+        break;
+    case FW_READBACK_SUB_OFFSET:
+        rb->offset = CO_getUint32(buf);
+        break;
+    default:
+        rb->size = CO_getUint32(buf);
+        break;
+    }
+    *countWritten = count;
+    return ODR_OK;
+}
+
+/* Fills as much of buf as the range allows, crossing windows, so the SDO server never runs short mid-range. */
+static ODR_t fw_read_readback(OD_stream_t *stream, void *buf, OD_size_t count, OD_size_t *countRead) {
+    OD_size_t size = fw_readback_param_size(stream->subIndex);
+    if (size == 0U && stream->subIndex != FW_READBACK_SUB_DATA) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    fw_server_state_t *server = fw_get_server(stream);
+    fw_readback_t *rb = &server->readback[fw_sdo_channel(server, stream)];
+    if (size != 0U) {
+        if (count < size) {
+            return ODR_DEV_INCOMPAT;
+        }
+        if (stream->subIndex == FW_READBACK_SUB_REGION) {
+            (void)CO_setUint8(buf, rb->region);
+        } else {
+            (void)CO_setUint32(buf, stream->subIndex == FW_READBACK_SUB_OFFSET ? rb->offset : rb->size);
+        }
+        *countRead = size;
+        return ODR_OK;
+    }
+    if (stream->dataOffset == 0U) {
+        ODR_t ret = fw_readback_open(server, rb);
+        if (ret != ODR_OK) {
+            return ret;
+        }
+        /* Known up front, so the initiate response indicates the size. */
+        stream->dataLength = rb->length;
+    }
+    if (rb->partition == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    uint32_t pos = (uint32_t)stream->dataOffset;
+    OD_size_t done = 0U;
+    while (done < count && pos < rb->length) {
+        if (rb->mapped == NULL || pos < rb->windowStart || pos >= rb->windowStart + rb->windowBytes) {
+            if (!fw_readback_map(rb, pos)) {
+                rb->partition = NULL;
+                return ODR_GENERAL;
+            }
+        }
+        uint32_t take = rb->windowStart + rb->windowBytes - pos;
+        if (take > count - done) {
+            take = (uint32_t)(count - done);
+        }
+        memcpy((uint8_t *)buf + done, rb->mapped + (pos - rb->windowStart), take);
+        done += take;
+        pos += take;
+    }
+    *countRead = done;
+    if (pos < rb->length) {
+        stream->dataOffset = pos;
+        return ODR_PARTIAL;
+    }
+    stream->dataOffset = 0U;
+    fw_readback_unmap(rb);
+    rb->partition = NULL;
+    return ODR_OK;
+}
+
 bool fw_server_init(CO_t *co) {
     if (co == NULL || OD == NULL) {
         return false;
     }
     s_server.co = co;
     fw_reset_context(&s_server.ctx);
+    fw_publish_running_identity();
 
     s_server.metaExt.object = &s_server;
     s_server.metaExt.read = OD_readOriginal;
@@ -417,6 +1516,32 @@ bool fw_server_init(CO_t *co) {
         return false;
     }
 
-    ESP_LOGI(TAG, "Firmware download objects registered");
+    s_server.perfExt.object = &s_server;
+    s_server.perfExt.read = fw_read_perf;
+    s_server.perfExt.write = OD_writeOriginal;
+    if (OD_extension_init(OD_ENTRY_H2101_fwPerfCounters, &s_server.perfExt) != ODR_OK) {
+        return false;
+    }
+
+    s_server.holesExt.object = &s_server;
+    s_server.holesExt.read = fw_read_holes;
+    s_server.holesExt.write = OD_writeOriginal;
+    if (OD_extension_init(OD_ENTRY_H2102_fwMissingRanges, &s_server.holesExt) != ODR_OK) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i <= FW_CHANNEL_LOCAL; i++) {
+        s_server.readback[i].region = OD_RAM.x2103_fwReadback.region;
+        s_server.readback[i].offset = OD_RAM.x2103_fwReadback.offset;
+        s_server.readback[i].size = OD_RAM.x2103_fwReadback.length;
+    }
+    s_server.readbackExt.object = &s_server;
+    s_server.readbackExt.read = fw_read_readback;
+    s_server.readbackExt.write = fw_write_readback;
+    if (OD_extension_init(OD_ENTRY_H2103_fwReadback, &s_server.readbackExt) != ODR_OK) {
+        return false;
+    }
+
+    FW_LOGI(TAG, "Firmware download objects registered");
     return true;
 }
@@ -0,0 +1,281 @@
+#include "fw_write_pipeline.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+#ifndef CONFIG_DEMO_SLAVE_PIPELINE_BLOCK_BYTES
+#define CONFIG_DEMO_SLAVE_PIPELINE_BLOCK_BYTES 4096
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_PIPELINE_SLOTS
+#define CONFIG_DEMO_SLAVE_PIPELINE_SLOTS 4
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_PIPELINE_CORE
+#define CONFIG_DEMO_SLAVE_PIPELINE_CORE 1
+#endif
+
+#define FW_PIPE_BLOCK   CONFIG_DEMO_SLAVE_PIPELINE_BLOCK_BYTES
+#define FW_PIPE_SLOTS   CONFIG_DEMO_SLAVE_PIPELINE_SLOTS
+#define FW_PIPE_MASK    (FW_PIPE_SLOTS - 1U)
+#define FW_PIPE_STACK   4096U
+#define FW_PIPE_PRIO    6U
+#define FW_PIPE_IDLE_MS 50U
+#define FW_PIPE_STOP_WAIT_MS 10000U
+
+#if (FW_PIPE_SLOTS & (FW_PIPE_SLOTS - 1)) != 0
+#error "CONFIG_DEMO_SLAVE_PIPELINE_SLOTS must be a power of two"
+#endif
+
+#if CONFIG_FREERTOS_UNICORE
+#define FW_PIPE_AFFINITY tskNO_AFFINITY
+#else
+#define FW_PIPE_AFFINITY CONFIG_DEMO_SLAVE_PIPELINE_CORE
+#endif
+
+typedef struct {
+    uint8_t *data;
+    uint32_t len;
+    uint32_t offset;
+} fw_pipe_slot_t;
+
+/*
+ * Single-producer/single-consumer ring. head is written only by the SDO task and tail only
+ * by the writer task, each published with release ordering, so slot contents are visible
+ * to the other core before the index that hands them over. The writer is woken by a task
+ * notification; the SDO side never waits, it checks fw_pipeline_has_room() and refuses the chunk.
+ * The pool and the exit semaphore are allocated on the first start and kept.
+ */
+typedef struct {
+    fw_pipe_slot_t slots[FW_PIPE_SLOTS];
+    uint8_t *pool;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t fillLen;
+    uint32_t nextOffset;
+    TaskHandle_t consumer;
+    SemaphoreHandle_t exited;
+    fw_pipeline_sink_t sink;
+    void *sinkArg;
+    volatile bool stop;
+    volatile bool discard;
+    volatile bool failed;
+    bool active;
+    bool writerRunning; /* a writer that did not stop in time still owns the pool */
+    int64_t startedUs;
+    int64_t endedUs;
+    uint64_t producerBusyUs;
+    uint64_t consumerBusyUs;
+    uint32_t blocks;
+    uint32_t stalls;
+    uint32_t peakDepth;
+} fw_pipeline_t;
+
+static const char *TAG = "fw_pipeline";
+static fw_pipeline_t s_pipe;
+
+static void fw_pipeline_writer_task(void *arg) {
+    (void)arg;
+    for (;;) {
+        uint32_t tail = s_pipe.tail;
+        uint32_t head = __atomic_load_n(&s_pipe.head, __ATOMIC_ACQUIRE);
+        if (tail == head) {
+            if (s_pipe.stop) {
+                break;
+            }
+            (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FW_PIPE_IDLE_MS));
+            continue;
+        }
+
+        fw_pipe_slot_t *slot = &s_pipe.slots[tail & FW_PIPE_MASK];
+        if (!s_pipe.failed && !s_pipe.discard) {
+            int64_t start = esp_timer_get_time();
+            if (!s_pipe.sink(s_pipe.sinkArg, slot->data, slot->len, slot->offset)) {
+                s_pipe.failed = true;
+            }
+            s_pipe.consumerBusyUs += (uint64_t)(esp_timer_get_time() - start);
+            s_pipe.blocks++;
+        }
+        __atomic_store_n(&s_pipe.tail, tail + 1U, __ATOMIC_RELEASE);
+    }
+
+    xSemaphoreGive(s_pipe.exited);
+    vTaskDelete(NULL);
+}
+
+static void fw_pipeline_publish(void) {
+    uint32_t head = s_pipe.head;
+    fw_pipe_slot_t *slot = &s_pipe.slots[head & FW_PIPE_MASK];
+    slot->len = s_pipe.fillLen;
+    s_pipe.fillLen = 0U;
+    __atomic_store_n(&s_pipe.head, head + 1U, __ATOMIC_RELEASE);
+
+    uint32_t depth = head + 1U - __atomic_load_n(&s_pipe.tail, __ATOMIC_ACQUIRE);
+    if (depth > s_pipe.peakDepth) {
+        s_pipe.peakDepth = depth;
+    }
+    (void)xTaskNotifyGive(s_pipe.consumer);
+}
+
+bool fw_pipeline_begin(fw_pipeline_sink_t sink, void *arg) {
+    if (s_pipe.active || sink == NULL) {
+        return false;
+    }
+    if (s_pipe.writerRunning && xSemaphoreTake(s_pipe.exited, 0) != pdTRUE) {
+        ESP_LOGE(TAG, "Previous writer still running");
+        return false;
+    }
+    uint8_t *pool = s_pipe.pool;
+    SemaphoreHandle_t exited = s_pipe.exited;
+    memset(&s_pipe, 0, sizeof(s_pipe));
+    s_pipe.pool = pool != NULL ? pool : (uint8_t *)malloc((size_t)FW_PIPE_BLOCK * FW_PIPE_SLOTS);
+    s_pipe.exited = exited != NULL ? exited : xSemaphoreCreateBinary();
+    if (s_pipe.pool == NULL || s_pipe.exited == NULL) {
+        ESP_LOGE(TAG, "Out of memory for %u x %u byte write blocks", (unsigned)FW_PIPE_SLOTS, (unsigned)FW_PIPE_BLOCK);
+        return false;
+    }
+    for (uint32_t i = 0; i < FW_PIPE_SLOTS; i++) {
+        s_pipe.slots[i].data = s_pipe.pool + ((size_t)i * FW_PIPE_BLOCK);
+    }
+    s_pipe.sink = sink;
+    s_pipe.sinkArg = arg;
+    s_pipe.startedUs = esp_timer_get_time();
+
+    if (xTaskCreatePinnedToCore(fw_pipeline_writer_task, "fw_writer", FW_PIPE_STACK, NULL, FW_PIPE_PRIO,
+                                &s_pipe.consumer, FW_PIPE_AFFINITY) != pdPASS) {
+        ESP_LOGE(TAG, "Unable to create writer task");
+        return false;
+    }
+    s_pipe.active = true;
+    ESP_LOGI(TAG, "Writer running on core %d with %u x %u byte blocks", (int)FW_PIPE_AFFINITY,
+             (unsigned)FW_PIPE_SLOTS, (unsigned)FW_PIPE_BLOCK);
+    return true;
+}
+
+bool fw_pipeline_has_room(size_t len, bool positioned) {
+    if (!s_pipe.active) {
+        return false;
+    }
+    uint32_t queued = s_pipe.head - __atomic_load_n(&s_pipe.tail, __ATOMIC_ACQUIRE);
+    /*
+     * The slot at head is the one being filled, so it counts as free minus what it holds;
+     * positioned data may not continue it, and then it goes out part-filled.
+     */
+    size_t room = (size_t)(FW_PIPE_SLOTS - queued) * FW_PIPE_BLOCK - s_pipe.fillLen;
+    if (positioned && s_pipe.fillLen > 0U) {
+        room = (size_t)(FW_PIPE_SLOTS - queued - 1U) * FW_PIPE_BLOCK;
+    }
+    if (len > room) {
+        /* Every slot is queued: the flash side is the bottleneck right now. */
+        s_pipe.stalls++;
+        return false;
+    }
+    return true;
+}
+
+bool fw_pipeline_push(const uint8_t *data, size_t len) {
+    return fw_pipeline_push_at(data, len, s_pipe.nextOffset);
+}
+
+bool fw_pipeline_push_at(const uint8_t *data, size_t len, uint32_t offset) {
+    if (!s_pipe.active) {
+        return false;
+    }
+    int64_t start = esp_timer_get_time();
+    if (offset != s_pipe.nextOffset) {
+        /* The slot at head is free (push checked it), so the part-filled block can always go. */
+        if (s_pipe.fillLen > 0U) {
+            fw_pipeline_publish();
+        }
+        s_pipe.nextOffset = offset;
+    }
+
+    while (len > 0U) {
+        if (s_pipe.failed) {
+            return false;
+        }
+        uint32_t head = s_pipe.head;
+        if (head - __atomic_load_n(&s_pipe.tail, __ATOMIC_ACQUIRE) >= FW_PIPE_SLOTS) {
+            /* The caller did not check fw_pipeline_has_room(); the CANopen task must not wait here. */
+            s_pipe.stalls++;
+            ESP_LOGE(TAG, "No free block for %u bytes", (unsigned)len);
+            return false;
+        }
+
+        fw_pipe_slot_t *slot = &s_pipe.slots[head & FW_PIPE_MASK];
+        if (s_pipe.fillLen == 0U) {
+            slot->offset = s_pipe.nextOffset;
+        }
+        size_t room = FW_PIPE_BLOCK - s_pipe.fillLen;
+        size_t take = len < room ? len : room;
+        memcpy(slot->data + s_pipe.fillLen, data, take);
+        s_pipe.fillLen += (uint32_t)take;
+        s_pipe.nextOffset += (uint32_t)take;
+        data += take;
+        len -= take;
+        if (s_pipe.fillLen == FW_PIPE_BLOCK) {
+            fw_pipeline_publish();
+        }
+    }
+
+    s_pipe.producerBusyUs += (uint64_t)(esp_timer_get_time() - start);
+    return true;
+}
+
+static bool fw_pipeline_stop(bool discard) {
+    if (!s_pipe.active) {
+        return false;
+    }
+    if (discard) {
+        s_pipe.discard = true;
+    } else if (s_pipe.fillLen > 0U && !s_pipe.failed) {
+        /* The slot is free: publish() only ever fills the slot at head, which push() checked. */
+        fw_pipeline_publish();
+    }
+    s_pipe.stop = true;
+    (void)xTaskNotifyGive(s_pipe.consumer);
+    if (xSemaphoreTake(s_pipe.exited, pdMS_TO_TICKS(FW_PIPE_STOP_WAIT_MS)) != pdTRUE) {
+        /* Still inside the sink; it drops the rest, and the next begin waits for it to exit. */
+        ESP_LOGE(TAG, "Writer did not stop");
+        s_pipe.discard = true;
+        s_pipe.writerRunning = true;
+        s_pipe.active = false;
+        return false;
+    }
+    s_pipe.endedUs = esp_timer_get_time();
+    s_pipe.active = false;
+    return !s_pipe.failed && !discard;
+}
+
+bool fw_pipeline_finish(void) {
+    return fw_pipeline_stop(false);
+}
+
+void fw_pipeline_abort(void) {
+    (void)fw_pipeline_stop(true);
+}
+
+bool fw_pipeline_active(void) {
+    return s_pipe.active;
+}
+
+void fw_pipeline_get_stats(fw_pipeline_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    int64_t end = s_pipe.active || s_pipe.endedUs == 0 ? esp_timer_get_time() : s_pipe.endedUs;
+    uint64_t wallUs = end > s_pipe.startedUs ? (uint64_t)(end - s_pipe.startedUs) : 0U;
+
+    out->blocks = s_pipe.blocks;
+    out->stalls = s_pipe.stalls;
+    out->peakDepth = s_pipe.peakDepth;
+    out->producerBusyPermille = wallUs > 0U ? (uint32_t)((s_pipe.producerBusyUs * 1000U) / wallUs) : 0U;
+    out->consumerBusyPermille = wallUs > 0U ? (uint32_t)((s_pipe.consumerBusyUs * 1000U) / wallUs) : 0U;
+}
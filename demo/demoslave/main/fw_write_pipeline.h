@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Runs on the writer task for every combined block; return false to fail the session. */
+typedef bool (*fw_pipeline_sink_t)(void *arg, const uint8_t *data, size_t len, uint32_t offset);
+
+typedef struct {
+    uint32_t blocks;
+    uint32_t stalls;            /* chunks refused because every slot was taken */
+    uint32_t peakDepth;         /* most slots queued at once */
+    uint32_t producerBusyPermille;
+    uint32_t consumerBusyPermille;
+} fw_pipeline_stats_t;
+
+/** Start the writer task. The block pool is allocated on the first call and kept for later sessions. */
+bool fw_pipeline_begin(fw_pipeline_sink_t sink, void *arg);
+
+/**
+ * True when a push of len bytes fits right now; false counts as a stall. positioned: the data
+ * goes through fw_pipeline_push_at() and may not continue the current block.
+ */
+bool fw_pipeline_has_room(size_t len, bool positioned);
+
+/** Copy data into the current block; full blocks are handed to the writer. Never waits. */
+bool fw_pipeline_push(const uint8_t *data, size_t len);
+
+/** Same for data that belongs at offset; a block that it does not continue is handed on part-filled. */
+bool fw_pipeline_push_at(const uint8_t *data, size_t len, uint32_t offset);
+
+/** Hand over the partial block, wait until the writer is idle and stop it; false if any block failed. */
+bool fw_pipeline_finish(void);
+
+/** Stop the writer and drop whatever is still queued. */
+void fw_pipeline_abort(void);
+
+bool fw_pipeline_active(void);
+
+/** Utilization is relative to the time since fw_pipeline_begin (or until finish/abort). */
+void fw_pipeline_get_stats(fw_pipeline_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -23,6 +24,17 @@
 
 extern void CO_CANinterrupt(CO_CANmodule_t *CANmodule);
 
+/* Keep the SDO side off the core the firmware writer task is pinned to. */
+#if CONFIG_DEMO_SLAVE_WRITE_PIPELINE && !CONFIG_FREERTOS_UNICORE
+#define CANOPEN_TASK_CORE (1 - CONFIG_DEMO_SLAVE_PIPELINE_CORE)
+#else
+#define CANOPEN_TASK_CORE tskNO_AFFINITY
+#endif
+
+#ifndef CONFIG_DEMO_SLAVE_EXTRA_SDO_COB_ID
+#define CONFIG_DEMO_SLAVE_EXTRA_SDO_COB_ID 0x0
+#endif
+
 #ifndef SLAVE_GREETING
 #define SLAVE_GREETING "Hello from slave"
 #endif
@@ -87,15 +99,43 @@ static void greeting_task(void *arg) {
     }
 }
 
+#if (((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_STATS) != 0) && (CONFIG_DEMO_SLAVE_PROCESS_STATS_S > 0)
+static const char *const s_processNames[CO_PROCESS_COUNT] = {"CAN", "LSS", "LEDs", "EM",   "NMT",
+                                                             "SDO", "HB",  "NG",   "TIME", "GTWA"};
+
+/* Log and clear the per-module CO_process() counters; called from the process task only. */
+static void log_process_stats(CO_t *co) {
+    for (int i = 0; i < CO_PROCESS_COUNT; i++) {
+        const CO_processStat_t *st = &co->processStats[i];
+        if (st->calls == 0U && st->skips == 0U) {
+            continue;
+        }
+        ESP_LOGI(CANOPEN_TAG, "%-4s run %" PRIu32 " skip %" PRIu32 " total %" PRIu32 " us max %" PRIu32 " us",
+                 s_processNames[i], st->calls, st->skips, st->time_us, st->timeMax_us);
+    }
+    memset(co->processStats, 0, sizeof(co->processStats));
+}
+#define PROCESS_STATS_US ((int64_t)CONFIG_DEMO_SLAVE_PROCESS_STATS_S * 1000000)
+#endif
+
 static void canopen_process_task(void *arg) {
     canopen_slave_t *ctx = (canopen_slave_t *)arg;
     int64_t last = esp_timer_get_time();
+#ifdef PROCESS_STATS_US
+    int64_t lastStats = last;
+#endif
     while (true) {
         if (ctx->co != NULL) {
             int64_t now = esp_timer_get_time();
             uint32_t diffUs = (uint32_t)(now - last);
             last = now;
             CO_process(ctx->co, false, diffUs, NULL);
+#ifdef PROCESS_STATS_US
+            if (now - lastStats >= PROCESS_STATS_US) {
+                lastStats = now;
+                log_process_stats(ctx->co);
+            }
+#endif
         }
         vTaskDelay(wait_ticks(1));
     }
@@ -112,6 +152,20 @@ static void canopen_rx_task(void *arg) {
     }
 }
 
+/* COB-IDs of SDO servers 0x1201/0x1202, read by CO_CANopenInit(); see DEMO_SLAVE_EXTRA_SDO_COB_ID. */
+static void configure_extra_sdo_servers(void) {
+    uint32_t base = CONFIG_DEMO_SLAVE_EXTRA_SDO_COB_ID;
+    if (base == 0U) {
+        return;
+    }
+    OD_RAM.x1201_SDOServer2Parameter.COB_IDClientToServerRx = base;
+    OD_RAM.x1201_SDOServer2Parameter.COB_IDServerToClientTx = base + 1U;
+    OD_RAM.x1202_SDOServer3Parameter.COB_IDClientToServerRx = base + 2U;
+    OD_RAM.x1202_SDOServer3Parameter.COB_IDServerToClientTx = base + 3U;
+    ESP_LOGI(CANOPEN_TAG, "Extra SDO servers on 0x%03lX/0x%03lX and 0x%03lX/0x%03lX", (unsigned long)base,
+             (unsigned long)(base + 1U), (unsigned long)(base + 2U), (unsigned long)(base + 3U));
+}
+
 static bool canopen_slave_init(void) {
     if (g_canopen.started) {
         return true;
@@ -136,6 +190,7 @@ static bool canopen_slave_init(void) {
         goto fail;
     }
 
+    configure_extra_sdo_servers();
     uint32_t errInfo = 0U;
     err = CO_CANopenInit(g_canopen.co, NULL, NULL, OD, NULL, NMT_CONTROL, FIRST_HB_TIME, SDO_SRV_TIMEOUT_TIME,
                          SDO_CLI_TIMEOUT_TIME, true, CONFIG_DEMO_SLAVE_NODE_ID, &errInfo);
@@ -160,11 +215,13 @@ static bool canopen_slave_init(void) {
     CO_CANsetNormalMode(g_canopen.co->CANmodule);
     log_twai_status(CANOPEN_TAG);
 
-    if (xTaskCreate(canopen_process_task, "co_slave_proc", 4096, &g_canopen, 5, &g_canopen.processTask) != pdPASS) {
+    if (xTaskCreatePinnedToCore(canopen_process_task, "co_slave_proc", 4096, &g_canopen, 5, &g_canopen.processTask,
+                                CANOPEN_TASK_CORE) != pdPASS) {
         ESP_LOGE(CANOPEN_TAG, "Unable to create CANopen process task");
         goto fail;
     }
-    if (xTaskCreate(canopen_rx_task, "co_slave_rx", 4096, &g_canopen, 6, &g_canopen.rxTask) != pdPASS) {
+    if (xTaskCreatePinnedToCore(canopen_rx_task, "co_slave_rx", 4096, &g_canopen, 6, &g_canopen.rxTask,
+                                CANOPEN_TASK_CORE) != pdPASS) {
         ESP_LOGE(CANOPEN_TAG, "Unable to create CANopen RX task");
         goto fail;
     }
@@ -0,0 +1,671 @@
+#!/usr/bin/env python3
+"""Generate the CANopenNode V4 Object Dictionary (OD.c/OD.h) from an EDS file.
+
+The output has the layout CANopenEditor produces, so application code keeps using OD_RAM.x1F5A_...,
+OD_ENTRY_H1F57_... and OD_CNT_... unchanged. On top of that:
+
+- Members of each storage group, and of every record inside it, are sorted so that nothing needs
+  padding: 8/4-byte values first, then 2-byte and 1-byte ones, byte strings by the alignment their
+  length allows. Byte strings whose length is a multiple of four stay 4-byte aligned, so records
+  such as the 0x1F57 metadata can be read in place.
+- Values with AccessType=const are placed in an OD_ROM group declared CO_PROGMEM, i.e. in flash
+  on targets where CO_PROGMEM is const, instead of in one of the RAM groups.
+- A perfect hash of the indexes is emitted with the list (OD_hash_t), so OD_find() needs no search.
+
+CANopenNode specific keys are read from EDS comments, as CANopenEditor writes them:
+;StorageLocation=RAM|PERSIST_COMM|... on the object and ;StringLengthMin=N on strings.
+
+Usage:
+  eds2od.py demoslave/canopennode/demo_slave.eds -o demoslave/canopennode
+  eds2od.py --check demoslave/canopennode/demo_slave.eds -o demoslave/canopennode
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+
+# DataType: (C type, size in bytes, kind); size 0 for strings, whose length comes from the value.
+DATA_TYPES = {
+    0x01: ("bool_t", 1, "bool"),
+    0x02: ("int8_t", 1, "int"),
+    0x03: ("int16_t", 2, "int"),
+    0x04: ("int32_t", 4, "int"),
+    0x05: ("uint8_t", 1, "uint"),
+    0x06: ("uint16_t", 2, "uint"),
+    0x07: ("uint32_t", 4, "uint"),
+    0x08: ("float32_t", 4, "float"),
+    0x09: ("char", 0, "vstring"),
+    0x0A: ("uint8_t", 0, "ostring"),
+    0x0F: ("uint8_t", 0, "domain"),
+    0x11: ("float64_t", 8, "float"),
+    0x15: ("int64_t", 8, "int"),
+    0x1B: ("uint64_t", 8, "uint"),
+}
+
+ACCESS_SDO = {"ro": "ODA_SDO_R", "const": "ODA_SDO_R", "wo": "ODA_SDO_W", "rw": "ODA_SDO_RW",
+              "rwr": "ODA_SDO_RW", "rww": "ODA_SDO_RW"}
+ACCESS_PDO = {"ro": "ODA_TPDO", "const": "ODA_TPDO", "wo": "ODA_RPDO", "rw": "ODA_TRPDO",
+              "rwr": "ODA_TPDO", "rww": "ODA_RPDO"}
+
+OBJ_VAR, OBJ_ARRAY, OBJ_RECORD = 0x7, 0x8, 0x9
+ROM_GROUP = "ROM"
+# Alignment a value is placed at, at most; 8 only for 64-bit values.
+MAX_WANT = 4
+
+
+class EdsError(Exception):
+    pass
+
+
+def make_cname(name: str) -> str:
+    """Parameter name to C identifier, the same way CANopenEditor does it."""
+
+    tokens = re.split(r"\W+", name.replace("-", "_"))
+    out = ""
+    prev = " "
+    for tok in tokens:
+        if not tok:
+            continue
+        if prev.isupper() and tok[0].isupper():
+            out += "_"
+        out += tok[0].upper() + tok[1:]
+        prev = tok[-1]
+    if len(out) > 1 and not out[1].isupper():
+        out = out[0].lower() + out[1:]
+    elif len(out) == 1:
+        out = out.lower()
+    return out
+
+
+def read_eds(path: Path) -> dict[str, dict[str, str]]:
+    sections: dict[str, dict[str, str]] = {}
+    current = None
+    for lineno, raw in enumerate(path.read_text(encoding="utf-8", errors="replace").splitlines(), 1):
+        line = raw.strip()
+        if not line:
+            continue
+        if line.startswith("["):
+            if not line.endswith("]"):
+                raise EdsError(f"{path}:{lineno}: malformed section header")
+            current = sections.setdefault(line[1:-1].strip().lower(), {})
+            continue
+        if line.startswith(";"):
+            line = line[1:]
+            if "=" not in line:
+                continue
+        if current is None or "=" not in line:
+            raise EdsError(f"{path}:{lineno}: expected key=value inside a section")
+        key, value = line.split("=", 1)
+        current[key.strip().lower()] = value.strip()
+    return sections
+
+
+def parse_int(text: str) -> int:
+    text = text.strip().replace("$NODEID", "").replace("$nodeid", "").lstrip("+ ").strip()
+    if not text:
+        return 0
+    if text.lower().startswith("0x"):
+        return int(text, 16)
+    return int(text, 10)
+
+
+@dataclass
+class Value:
+    """One sub-index: the whole VAR, a record member or an array element."""
+
+    subIndex: int
+    name: str
+    dataType: int
+    access: str
+    pdo: bool
+    default: str
+    stringLength: int
+
+    @property
+    def kind(self) -> str:
+        return DATA_TYPES[self.dataType][2]
+
+    @property
+    def ctype(self) -> str:
+        return DATA_TYPES[self.dataType][0]
+
+    def length(self) -> int:
+        """Bytes of data; 0 when the value has no storage in the OD."""
+
+        kind = self.kind
+        if kind == "domain":
+            return 0
+        if kind == "vstring":
+            return max(self.stringLength, len(self.default.encode("utf-8")))
+        if kind == "ostring":
+            return max(self.stringLength, len(self.default.split()))
+        if not self.default:
+            return 0
+        return DATA_TYPES[self.dataType][1]
+
+    def storage(self) -> int:
+        """Bytes the value takes in its group, with the terminating zero of visible strings."""
+
+        return self.length() + 1 if self.kind == "vstring" and self.length() > 0 else self.length()
+
+    def is_string(self) -> bool:
+        return self.kind in ("vstring", "ostring")
+
+    def decl_suffix(self) -> str:
+        if self.kind == "vstring":
+            return f"[{self.length() + 1}]"
+        if self.kind == "ostring":
+            return f"[{self.length()}]"
+        return ""
+
+    def initializer(self) -> str:
+        kind = self.kind
+        if kind == "vstring":
+            return '"' + self.default.replace("\\", "\\\\").replace('"', '\\"') + '"'
+        if kind == "ostring":
+            data = [int(b, 16) for b in self.default.split()]
+            data += [0] * (self.length() - len(data))
+            if not any(data):
+                return "{0}"
+            return "{" + ", ".join(f"0x{b:02X}" for b in data) + "}"
+        return format_scalar(self.dataType, self.default)
+
+    def attribute(self) -> str:
+        if self.access not in ACCESS_SDO:
+            raise EdsError(f"{self.name}: unknown AccessType '{self.access}'")
+        parts = [ACCESS_SDO[self.access]]
+        if self.pdo:
+            parts.append(ACCESS_PDO[self.access])
+        if self.kind in ("int", "uint", "float") and DATA_TYPES[self.dataType][1] > 1:
+            parts.append("ODA_MB")
+        if self.kind == "vstring":
+            parts.append("ODA_STR")
+        return " | ".join(parts)
+
+    def want(self) -> int:
+        """Alignment the value would like to have; see module docstring."""
+
+        size = self.storage()
+        if not self.is_string():
+            return size
+        want = 1
+        while want < MAX_WANT and size % (want * 2) == 0:
+            want *= 2
+        return want
+
+
+def format_scalar(dataType: int, text: str) -> str:
+    _, size, kind = DATA_TYPES[dataType]
+    if kind == "float":
+        return str(float(text))
+    if kind == "bool":
+        return "true" if parse_int(text) != 0 else "false"
+    value = parse_int(text)
+    if kind == "int":
+        return str(value)
+    if value < 0 or value >= 1 << (8 * size):
+        raise EdsError(f"default value {text} does not fit {DATA_TYPES[dataType][0]}")
+    return f"0x{value:0{size * 2}X}"
+
+
+@dataclass
+class Entry:
+    index: int
+    name: str
+    objectType: int
+    group: str
+    subNumber: int
+    values: list[Value] = field(default_factory=list)
+
+    @property
+    def cname(self) -> str:
+        return f"x{self.index:04X}_{self.name}"
+
+    @property
+    def oname(self) -> str:
+        return f"o_{self.index:04X}_{self.name}"
+
+    def group_of(self, value: Value) -> str:
+        return ROM_GROUP if value.access == "const" else self.group
+
+
+def value_from_section(sec: dict[str, str], where: str, subIndex: int) -> Value:
+    try:
+        dataType = int(sec["datatype"], 0)
+    except (KeyError, ValueError) as exc:
+        raise EdsError(f"[{where}]: missing or bad DataType") from exc
+    if dataType not in DATA_TYPES:
+        raise EdsError(f"[{where}]: DataType 0x{dataType:04X} is not supported")
+    return Value(subIndex=subIndex,
+                 name=make_cname(sec.get("parametername", "")),
+                 dataType=dataType,
+                 access=sec.get("accesstype", "ro").lower(),
+                 pdo=sec.get("pdomapping", "0").strip() not in ("", "0"),
+                 default=sec.get("defaultvalue", ""),
+                 stringLength=int(sec.get("stringlengthmin", "0"), 0))
+
+
+def load_entries(sections: dict[str, dict[str, str]]) -> list[Entry]:
+    entries = []
+    for key in sorted((k for k in sections if re.fullmatch(r"[0-9a-f]{4}", k)), key=lambda k: int(k, 16)):
+        sec = sections[key]
+        index = int(key, 16)
+        objectType = int(sec.get("objecttype", "0x7"), 0)
+        entry = Entry(index=index, name=make_cname(sec.get("parametername", "")), objectType=objectType,
+                      group=sec.get("storagelocation", "RAM").strip() or "RAM", subNumber=0)
+        if entry.group == ROM_GROUP:
+            raise EdsError(f"[{key}]: {ROM_GROUP} is chosen by AccessType=const, not by StorageLocation")
+        if objectType == OBJ_VAR:
+            entry.values.append(value_from_section(sec, key, 0))
+            entry.subNumber = 1
+        elif objectType in (OBJ_ARRAY, OBJ_RECORD):
+            subs = []
+            for subKey, subSec in sections.items():
+                m = re.fullmatch(key + r"sub([0-9a-f]+)", subKey)
+                if m:
+                    subs.append(value_from_section(subSec, subKey, int(m.group(1), 16)))
+            subs.sort(key=lambda v: v.subIndex)
+            if not subs or subs[0].subIndex != 0:
+                raise EdsError(f"[{key}]: sub-index 0 is missing")
+            names = [v.name for v in subs]
+            if objectType == OBJ_RECORD and len(set(names)) != len(names):
+                raise EdsError(f"[{key}]: sub-entries of a record need distinct ParameterNames")
+            entry.values = subs
+            entry.subNumber = len(subs)
+            if objectType == OBJ_ARRAY:
+                if [v.subIndex for v in subs] != list(range(len(subs))) or len(subs) < 2:
+                    raise EdsError(f"[{key}]: array sub-indexes must run from 0 without gaps")
+                elements = subs[1:]
+                if any(v.dataType != elements[0].dataType or v.is_string() for v in elements):
+                    raise EdsError(f"[{key}]: array elements must share one numeric DataType")
+                if len({entry.group_of(v) for v in elements}) != 1:
+                    raise EdsError(f"[{key}]: array elements must share one AccessType class")
+        else:
+            raise EdsError(f"[{key}]: ObjectType 0x{objectType:X} is not supported")
+        if not entry.name:
+            raise EdsError(f"[{key}]: ParameterName is empty")
+        entries.append(entry)
+    if not entries:
+        raise EdsError("no objects found")
+    return entries
+
+
+# --- layout -----------------------------------------------------------------------------------
+
+
+@dataclass
+class Member:
+    """Member of a group struct or of a record struct inside it."""
+
+    name: str
+    decl: str             # C declaration, without the trailing ';' for structs
+    init: str             # initializer
+    size: int
+    align: int
+    want: int
+    order: int            # index * 256 + sub-index, keeps equal members in OD order
+    children: list[Member] = field(default_factory=list)
+
+
+def size_key(size: int) -> int:
+    key = 1
+    while key < 8 and size % (key * 2) == 0:
+        key *= 2
+    return key
+
+
+def pack(members: list[Member]) -> list[Member]:
+    """Largest wanted alignment first; among equal ones, sizes that keep the next member aligned."""
+
+    return sorted(members, key=lambda m: (-m.want, -min(size_key(m.size), m.want), m.order))
+
+
+def struct_member(name: str, children: list[Member], order: int) -> Member:
+    children = pack(children)
+    align = max(c.align for c in children)
+    offset = 0
+    for c in children:
+        offset = (offset + c.align - 1) // c.align * c.align + c.size
+    size = (offset + align - 1) // align * align
+    return Member(name=name, decl="", init="", size=size, align=align, want=children[0].want,
+                  order=order, children=children)
+
+
+def value_member(entry: Entry, value: Value, name: str) -> Member:
+    natural = 1 if value.is_string() else DATA_TYPES[value.dataType][1]
+    return Member(name=name, decl=f"{value.ctype} {name}{value.decl_suffix()}", init=value.initializer(),
+                  size=value.storage(), align=natural,
+                  want=max(natural, value.want()), order=entry.index * 256 + value.subIndex)
+
+
+def group_members(entries: list[Entry]) -> dict[str, list[Member]]:
+    groups: dict[str, list[Member]] = {}
+
+    def add(group: str, member: Member) -> None:
+        groups.setdefault(group, []).append(member)
+
+    for entry in entries:
+        if entry.objectType == OBJ_VAR:
+            value = entry.values[0]
+            if value.length() > 0:
+                add(entry.group_of(value), value_member(entry, value, entry.cname))
+        elif entry.objectType == OBJ_ARRAY:
+            sub0, elements = entry.values[0], entry.values[1:]
+            if sub0.length() > 0:
+                add(entry.group_of(sub0), value_member(entry, sub0, entry.cname + "_sub0"))
+            if elements[0].length() > 0:
+                size = DATA_TYPES[elements[0].dataType][1]
+                inits = ", ".join(format_scalar(v.dataType, v.default or "0") for v in elements)
+                add(entry.group_of(elements[0]),
+                    Member(name=entry.cname, decl=f"{elements[0].ctype} {entry.cname}[OD_CNT_ARR_{entry.index:04X}]",
+                           init="{" + inits + "}", size=size * len(elements), align=size, want=size,
+                           order=entry.index * 256 + 1))
+        else:
+            byGroup: dict[str, list[Member]] = {}
+            for value in entry.values:
+                if value.length() > 0:
+                    byGroup.setdefault(entry.group_of(value), []).append(value_member(entry, value, value.name))
+            for group, children in byGroup.items():
+                add(group, struct_member(entry.cname, children, entry.index * 256))
+    return {group: pack(members) for group, members in groups.items()}
+
+
+def find_member(groups: dict[str, list[Member]], entry: Entry, value: Value, array: bool) -> str:
+    """C expression of the address of value, or NULL."""
+
+    if value.length() == 0:
+        return "NULL"
+    group = entry.group_of(value)
+    prefix = "(void *)" if group == ROM_GROUP else ""
+    if entry.objectType == OBJ_VAR:
+        path = entry.cname
+    elif entry.objectType == OBJ_ARRAY:
+        path = entry.cname + ("[0]" if array else "_sub0")
+        return f"{prefix}&OD_{group}.{path}"
+    else:
+        path = f"{entry.cname}.{value.name}"
+    if value.is_string():
+        path += "[0]"
+    return f"{prefix}&OD_{group}.{path}"
+
+
+# --- output -----------------------------------------------------------------------------------
+
+RULE = "*" * 79
+
+
+def banner(info: dict[str, str], device: dict[str, str], edsName: str, warning: str, details: bool) -> list[str]:
+    lines = [
+        "/" + RULE,
+        "    CANopen Object Dictionary definition for CANopenNode V4",
+        "",
+        f"    This file was automatically generated by eds2od.py from {edsName}",
+        "",
+        "    https://github.com/CANopenNode/CANopenNode",
+        "",
+        f"    {warning}",
+    ]
+    if not details:
+        return lines + [RULE + "/"]
+    return lines + [
+        "*" * 80,
+        "",
+        "    File info:",
+        "        File Names:   OD.h; OD.c",
+        f"        Project File: {edsName}",
+        f"        File Version: {info.get('fileversion', '')}",
+        "",
+        f"        Created:      {info.get('creationdate', '')} {info.get('creationtime', '')}".rstrip(),
+        f"        Created By:   {info.get('createdby', '')}",
+        f"        Modified:     {info.get('modificationdate', '')} {info.get('modificationtime', '')}".rstrip(),
+        f"        Modified By:  {info.get('modifiedby', '')}",
+        "",
+        "    Device Info:",
+        f"        Vendor Name:  {device.get('vendorname', '')}",
+        f"        Vendor ID:    {device.get('vendornumber', '')}",
+        f"        Product Name: {device.get('productname', '')}",
+        f"        Product ID:   {device.get('productnumber', '')}",
+        "",
+        f"        Description:  {info.get('description', '')}",
+        RULE + "/",
+    ]
+
+
+def section(title: str) -> list[str]:
+    return ["/" + RULE, f"    {title}", RULE + "/"]
+
+
+def counters(entries: list[Entry]) -> list[tuple[str, int]]:
+    present = {e.index for e in entries}
+
+    def count(lo: int, hi: int) -> int:
+        return sum(1 for i in present if lo <= i <= hi)
+
+    table = [
+        ("NMT", int(0x1017 in present)),
+        ("EM", int(0x1001 in present)),
+        ("SYNC", int(0x1005 in present)),
+        ("SYNC_PROD", int(0x1006 in present)),
+        ("STORAGE", int(0x1010 in present)),
+        ("TIME", int(0x1012 in present)),
+        ("EM_PROD", int(0x1014 in present)),
+        ("HB_CONS", int(0x1016 in present)),
+        ("HB_PROD", int(0x1017 in present)),
+        ("SDO_SRV", count(0x1200, 0x127F)),
+        ("SDO_CLI", count(0x1280, 0x12FF)),
+        ("RPDO", count(0x1400, 0x15FF)),
+        ("TPDO", count(0x1800, 0x19FF)),
+    ]
+    return [(name, n) for name, n in table if n > 0]
+
+
+# OD_INIT_CONFIG, in the order CO_config_t lists the fields.
+INIT_CONFIG = [
+    ("CNT_NMT", "CNT", "NMT"), ("ENTRY_H1017", "ENTRY", 0x1017),
+    ("CNT_HB_CONS", "CNT", "HB_CONS"), ("CNT_ARR_1016", "ARR", 0x1016), ("ENTRY_H1016", "ENTRY", 0x1016),
+    ("CNT_EM", "CNT", "EM"), ("ENTRY_H1001", "ENTRY", 0x1001), ("ENTRY_H1014", "ENTRY", 0x1014),
+    ("ENTRY_H1015", "ENTRY", 0x1015), ("CNT_ARR_1003", "ARR", 0x1003), ("ENTRY_H1003", "ENTRY", 0x1003),
+    ("CNT_SDO_SRV", "CNT", "SDO_SRV"), ("ENTRY_H1200", "ENTRY", 0x1200),
+    ("CNT_SDO_CLI", "CNT", "SDO_CLI"), ("ENTRY_H1280", "ENTRY", 0x1280),
+    ("CNT_TIME", "CNT", "TIME"), ("ENTRY_H1012", "ENTRY", 0x1012),
+    ("CNT_SYNC", "CNT", "SYNC"), ("ENTRY_H1005", "ENTRY", 0x1005), ("ENTRY_H1006", "ENTRY", 0x1006),
+    ("ENTRY_H1007", "ENTRY", 0x1007), ("ENTRY_H1019", "ENTRY", 0x1019),
+    ("CNT_RPDO", "CNT", "RPDO"), ("ENTRY_H1400", "ENTRY", 0x1400), ("ENTRY_H1600", "ENTRY", 0x1600),
+    ("CNT_TPDO", "CNT", "TPDO"), ("ENTRY_H1800", "ENTRY", 0x1800), ("ENTRY_H1A00", "ENTRY", 0x1A00),
+    ("CNT_LEDS", "CNT", "LEDS"), ("CNT_GFC", "CNT", "GFC"), ("ENTRY_H1300", "ENTRY", 0x1300),
+    ("CNT_SRDO", "CNT", "SRDO"), ("ENTRY_H1301", "ENTRY", 0x1301), ("ENTRY_H1381", "ENTRY", 0x1381),
+    ("ENTRY_H13FE", "ENTRY", 0x13FE), ("ENTRY_H13FF", "ENTRY", 0x13FF),
+    ("CNT_LSS_SLV", "CNT", "LSS_SLV"), ("CNT_LSS_MST", "CNT", "LSS_MST"),
+    ("CNT_GTWA", "CNT", "GTWA"), ("CNT_TRACE", "CNT", "TRACE"),
+]
+
+
+def emit_struct_body(members: list[Member], indent: str) -> list[str]:
+    lines = []
+    for m in members:
+        if m.children:
+            lines.append(f"{indent}struct {{")
+            lines += emit_struct_body(m.children, indent + "    ")
+            lines.append(f"{indent}}} {m.name};")
+        else:
+            lines.append(f"{indent}{m.decl};")
+    return lines
+
+
+def emit_init_body(members: list[Member], indent: str) -> list[str]:
+    lines = []
+    for i, m in enumerate(members):
+        comma = "," if i + 1 < len(members) else ""
+        if m.children:
+            lines.append(f"{indent}.{m.name} = {{")
+            lines += emit_init_body(m.children, indent + "    ")
+            lines.append(f"{indent}}}{comma}")
+        else:
+            lines.append(f"{indent}.{m.name} = {m.init}{comma}")
+    return lines
+
+
+def build_hash(entries: list[Entry]) -> tuple[int, int, list[int]]:
+    """Smallest table of at least twice the entries, then the first odd multiplier without collisions."""
+
+    bits = max(1, (len(entries) - 1).bit_length()) + 1
+    while bits <= 16:
+        for mult in range(1, 0x10000, 2):
+            slots = [0] * (1 << bits)
+            for pos, entry in enumerate(entries):
+                slot = ((entry.index * mult) & 0xFFFF) >> (16 - bits)
+                if slots[slot]:
+                    break
+                slots[slot] = pos + 1
+            else:
+                return mult, 16 - bits, slots
+        bits += 1
+    raise EdsError("no perfect hash found for the indexes")
+
+
+def generate(edsPath: Path) -> tuple[str, str]:
+    sections = read_eds(edsPath)
+    entries = load_entries(sections)
+    groups = group_members(entries)
+    info = sections.get("fileinfo", {})
+    device = sections.get("deviceinfo", {})
+    edsName = edsPath.name
+    cnts = counters(entries)
+    arrays = [e for e in entries if e.objectType == OBJ_ARRAY]
+    present = {e.index for e in entries}
+
+    # ---- OD.h
+    h = banner(info, device, edsName, "DON'T EDIT THIS FILE MANUALLY !!!!", True)
+    h += ["", "#ifndef OD_H", "#define OD_H"]
+    h += section("Counters of OD objects")
+    h += [f"#define OD_CNT_{name} {n}" for name, n in cnts]
+    h += ["", ""]
+    h += section("Sizes of OD arrays")
+    h += [f"#define OD_CNT_ARR_{e.index:04X} {e.subNumber - 1}" for e in arrays]
+    h += ["", ""]
+    h += section("OD data declaration of all groups")
+    for group, members in groups.items():
+        h.append("typedef struct {")
+        h += emit_struct_body(members, "    ")
+        h += [f"}} OD_{group}_t;", ""]
+    for group in groups:
+        qualifier = " CO_PROGMEM" if group == ROM_GROUP else ""
+        h += [f"#ifndef OD_ATTR_{group}", f"#define OD_ATTR_{group}", "#endif",
+              f"extern OD_ATTR_{group}{qualifier} OD_{group}_t OD_{group};", ""]
+    h += ["#ifndef OD_ATTR_OD", "#define OD_ATTR_OD", "#endif", "extern OD_ATTR_OD OD_t *OD;", "", ""]
+    h += section("Object dictionary entries - shortcuts")
+    h += [f"#define OD_ENTRY_H{e.index:04X} &OD->list[{i}]" for i, e in enumerate(entries)]
+    h += ["", ""]
+    h += section("Object dictionary entries - shortcuts with names")
+    h += [f"#define OD_ENTRY_H{e.index:04X}_{e.name} &OD->list[{i}]" for i, e in enumerate(entries)]
+    h += ["", ""]
+    h += section("OD config structure")
+    h += ["#ifdef CO_MULTIPLE_OD", "#define OD_INIT_CONFIG(config) {\\"]
+    cntNames = {name for name, _ in cnts}
+    for fieldName, kind, ref in INIT_CONFIG:
+        if kind == "CNT":
+            value = f"OD_CNT_{ref}" if ref in cntNames else "0"
+        elif kind == "ARR":
+            value = f"OD_CNT_ARR_{ref:04X}" if any(e.index == ref for e in arrays) else "0"
+        else:
+            value = f"OD_ENTRY_H{ref:04X}" if ref in present else "NULL"
+        h.append(f"    (config).{fieldName} = {value};\\")
+    h += ["}", "#endif", "", "#endif /* OD_H */", ""]
+
+    # ---- OD.c
+    c = banner(info, device, edsName, "DON'T EDIT THIS FILE MANUALLY, UNLESS YOU KNOW WHAT YOU ARE DOING !!!!",
+               False)
+    c += ["", "#define OD_DEFINITION", '#include "301/CO_ODinterface.h"', '#include "OD.h"', "",
+          "#if CO_VERSION_MAJOR < 4", "#error This Object dictionary is compatible with CANopenNode V4.0 and above!",
+          "#endif", ""]
+    c += section("OD data initialization of all groups")
+    for group, members in groups.items():
+        qualifier = " CO_PROGMEM" if group == ROM_GROUP else ""
+        c.append(f"OD_ATTR_{group}{qualifier} OD_{group}_t OD_{group} = {{")
+        c += emit_init_body(members, "    ")
+        c += ["};", ""]
+    c += ["", ""]
+    c += section("All OD objects (constant definitions)")
+    c.append("typedef struct {")
+    for e in entries:
+        if e.objectType == OBJ_VAR:
+            c.append(f"    OD_obj_var_t {e.oname};")
+        elif e.objectType == OBJ_ARRAY:
+            c.append(f"    OD_obj_array_t {e.oname};")
+        else:
+            c.append(f"    OD_obj_record_t {e.oname}[{len(e.values)}];")
+    c += ["} ODObjs_t;", "", "static CO_PROGMEM ODObjs_t ODObjs = {"]
+    for i, e in enumerate(entries):
+        comma = "," if i + 1 < len(entries) else ""
+        c.append(f"    .{e.oname} = {{")
+        if e.objectType == OBJ_VAR:
+            v = e.values[0]
+            c += [f"        .dataOrig = {find_member(groups, e, v, False)},",
+                  f"        .attribute = {v.attribute()},",
+                  f"        .dataLength = {v.length()}"]
+        elif e.objectType == OBJ_ARRAY:
+            sub0, el = e.values[0], e.values[1]
+            c += [f"        .dataOrig0 = {find_member(groups, e, sub0, False)},",
+                  f"        .dataOrig = {find_member(groups, e, el, True)},",
+                  f"        .attribute0 = {sub0.attribute()},",
+                  f"        .attribute = {el.attribute()},",
+                  f"        .dataElementLength = {DATA_TYPES[el.dataType][1]},",
+                  f"        .dataElementSizeof = sizeof({el.ctype})"]
+        else:
+            for j, v in enumerate(e.values):
+                c += ["        {",
+                      f"            .dataOrig = {find_member(groups, e, v, False)},",
+                      f"            .subIndex = {v.subIndex},",
+                      f"            .attribute = {v.attribute()},",
+                      f"            .dataLength = {v.length()}",
+                      "        }" + ("," if j + 1 < len(e.values) else "")]
+        c.append(f"    }}{comma}")
+    c += ["};", "", ""]
+    c += section("Object dictionary")
+    c.append("static OD_ATTR_OD OD_entry_t ODList[] = {")
+    for e in entries:
+        odt = {OBJ_VAR: "ODT_VAR", OBJ_ARRAY: "ODT_ARR", OBJ_RECORD: "ODT_REC"}[e.objectType]
+        c.append(f"    {{0x{e.index:04X}, 0x{e.subNumber:02X}, {odt}, &ODObjs.{e.oname}, NULL}},")
+    c += ["    {0x0000, 0x00, 0, NULL, NULL}", "};", ""]
+    mult, shift, slots = build_hash(entries)
+    rows = [", ".join(str(s) for s in slots[r:r + 16]) for r in range(0, len(slots), 16)]
+    c += ["/* Perfect hash of the indexes in ODList, see OD_hash_t. */",
+          f"static const uint16_t ODHashSlots[{len(slots)}] = {{"]
+    c += [f"    {row}," for row in rows[:-1]] + [f"    {rows[-1]}", "};", ""]
+    c += [f"static const OD_hash_t ODHash = {{0x{mult:04X}, {shift}, &ODHashSlots[0]}};", ""]
+    c += ["static OD_t _OD = {", "    (sizeof(ODList) / sizeof(ODList[0])) - 1,", "    &ODList[0],", "    &ODHash",
+          "};", "", "OD_t *OD = &_OD;", ""]
+    return "\n".join(h), "\n".join(c)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("eds", type=Path, help="EDS file describing the Object Dictionary")
+    parser.add_argument("-o", "--out-dir", type=Path, default=Path("."), help="where OD.c and OD.h go")
+    parser.add_argument("--check", action="store_true",
+                        help="write nothing, fail if OD.c/OD.h in the output directory differ from the EDS")
+    args = parser.parse_args()
+
+    try:
+        header, source = generate(args.eds)
+    except (EdsError, OSError, ValueError) as exc:
+        print(f"eds2od: {exc}", file=sys.stderr)
+        return 2
+
+    outputs = {args.out_dir / "OD.h": header, args.out_dir / "OD.c": source}
+    if args.check:
+        stale = [p for p, text in outputs.items() if not p.is_file() or p.read_text(encoding="utf-8") != text]
+        for path in stale:
+            print(f"eds2od: {path} is out of date with {args.eds}", file=sys.stderr)
+        return 1 if stale else 0
+    for path, text in outputs.items():
+        path.write_text(text, encoding="utf-8", newline="\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,61 @@
+#include "fw_bundle.h"
+
+#include <string.h>
+
+static uint32_t fw_bundle_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint32_t fw_bundle_toc_bytes(const uint8_t *header, size_t len) {
+    if (header == NULL || len < FW_BUNDLE_HEADER_BYTES) {
+        return 0U;
+    }
+    uint8_t count = header[5];
+    if (fw_bundle_le32(header) != FW_BUNDLE_MAGIC || header[4] != FW_BUNDLE_VERSION || count == 0U ||
+        count > FW_BUNDLE_MAX_SECTIONS) {
+        return 0U;
+    }
+    return FW_BUNDLE_HEADER_BYTES + (uint32_t)count * FW_BUNDLE_ENTRY_BYTES;
+}
+
+bool fw_bundle_parse(const uint8_t *buf, size_t len, fw_bundle_toc_t *toc) {
+    uint32_t tocBytes = fw_bundle_toc_bytes(buf, len);
+    if (tocBytes == 0U || len < tocBytes || toc == NULL) {
+        return false;
+    }
+
+    memset(toc, 0, sizeof(*toc));
+    toc->count = buf[5];
+    toc->tocBytes = tocBytes;
+    uint32_t offset = tocBytes;
+    for (uint8_t i = 0; i < toc->count; i++) {
+        const uint8_t *entry = buf + FW_BUNDLE_HEADER_BYTES + (size_t)i * FW_BUNDLE_ENTRY_BYTES;
+        fw_bundle_section_t *section = &toc->sections[i];
+        section->type = entry[0];
+        section->bank = entry[1];
+        section->digestType = (fw_digest_type_t)entry[2];
+        section->size = fw_bundle_le32(entry + 4);
+        section->offset = offset;
+        memcpy(section->digest, entry + 8, FW_DIGEST_MAX_LEN);
+        if (section->size == 0U || section->digestType == FW_DIGEST_NONE ||
+            fw_digest_length(section->digestType) == 0U || section->size > UINT32_MAX - offset) {
+            return false;
+        }
+        offset += section->size;
+    }
+    toc->totalBytes = offset;
+    return true;
+}
+
+const char *fw_bundle_section_name(uint8_t type) {
+    switch (type) {
+    case FW_SECTION_MAIN:
+        return "main";
+    case FW_SECTION_BOOTLOADER:
+        return "bootloader";
+    case FW_SECTION_CONFIG:
+        return "config";
+    default:
+        return "?";
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef FW_BUNDLE_H
+#define FW_BUNDLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fw_digest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bundle layout, all fields little endian:
+ *
+ *   header   u32 magic "FWBN", u8 version, u8 section count, u16 reserved
+ *   entry[n] u8 type, u8 bank, u8 digest type, u8 reserved, u32 size, u8 digest[32]
+ *   data     the sections back to back, in table order
+ *
+ * The whole file travels as one image whose 0x1F57:01 imageType is FW_BUNDLE_IMAGE_TYPE.
+ * build_fw_bundle.py writes this format.
+ */
+#define FW_BUNDLE_MAGIC        0x4E425746UL
+#define FW_BUNDLE_VERSION      1U
+#define FW_BUNDLE_IMAGE_TYPE   3U
+#define FW_BUNDLE_MAX_SECTIONS 4U
+#define FW_BUNDLE_HEADER_BYTES 8U
+#define FW_BUNDLE_ENTRY_BYTES  40U
+#define FW_BUNDLE_MAX_TOC_BYTES (FW_BUNDLE_HEADER_BYTES + FW_BUNDLE_MAX_SECTIONS * FW_BUNDLE_ENTRY_BYTES)
+
+/* Section types; same values as the imageType byte of a single-image session. */
+enum {
+    FW_SECTION_MAIN = 0,
+    FW_SECTION_BOOTLOADER = 1,
+    FW_SECTION_CONFIG = 2
+};
+
+typedef struct {
+    uint8_t type;
+    uint8_t bank;
+    fw_digest_type_t digestType;
+    uint32_t offset; /* from the start of the bundle */
+    uint32_t size;
+    uint8_t digest[FW_DIGEST_MAX_LEN];
+} fw_bundle_section_t;
+
+typedef struct {
+    uint8_t count;
+    uint32_t tocBytes;
+    uint32_t totalBytes;
+    fw_bundle_section_t sections[FW_BUNDLE_MAX_SECTIONS];
+} fw_bundle_toc_t;
+
+/** Size of the whole table from its first FW_BUNDLE_HEADER_BYTES; 0 when they are not a bundle header. */
+uint32_t fw_bundle_toc_bytes(const uint8_t *header, size_t len);
+
+/**
+ * Parse a complete table. Every section must carry a CRC32 or SHA-256 digest and a non-zero
+ * size; offsets are derived from the sizes.
+ */
+bool fw_bundle_parse(const uint8_t *buf, size_t len, fw_bundle_toc_t *toc);
+
+const char *fw_bundle_section_name(uint8_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_BUNDLE_H */
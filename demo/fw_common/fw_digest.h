@@ -0,0 +1,61 @@
+#ifndef FW_DIGEST_H
+#define FW_DIGEST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+/* SHA-256 needs mbedtls; without CONFIG_FW_DIGEST_SHA256 only CRC32 is available. */
+#if defined(CONFIG_FW_DIGEST_SHA256) && CONFIG_FW_DIGEST_SHA256
+#define FW_DIGEST_SHA256_ENABLED 1
+#include "mbedtls/sha256.h"
+#else
+#define FW_DIGEST_SHA256_ENABLED 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Values travel in byte 0 of object 0x1F57:02; keep them stable. */
+typedef enum {
+    FW_DIGEST_NONE = 0,
+    FW_DIGEST_CRC32 = 1,
+    FW_DIGEST_SHA256 = 2
+} fw_digest_type_t;
+
+#define FW_DIGEST_MAX_LEN 32U
+
+typedef struct {
+    fw_digest_type_t type;
+    uint32_t crc32;
+#if FW_DIGEST_SHA256_ENABLED
+    mbedtls_sha256_context sha;
+#endif
+} fw_digest_t;
+
+/** CRC16/CCITT (poly 0x1021, seed 0xFFFF), table driven; same result as the bitwise loops it replaces. */
+uint16_t fw_crc16_update(uint16_t crc, const void *data, size_t len);
+
+/** Digest size in bytes: 0, 4 (CRC32, little endian) or 32 (SHA-256); 0 for types this build lacks. */
+size_t fw_digest_length(fw_digest_type_t type);
+
+/** CRC32 uses the ROM routine, SHA-256 the hardware engine through mbedtls. */
+bool fw_digest_begin(fw_digest_t *digest, fw_digest_type_t type);
+void fw_digest_update(fw_digest_t *digest, const void *data, size_t len);
+
+/** Write the digest to out and release the context; returns the digest length. */
+size_t fw_digest_finish(fw_digest_t *digest, uint8_t out[FW_DIGEST_MAX_LEN]);
+
+/** Release the context without producing a digest. */
+void fw_digest_abort(fw_digest_t *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_DIGEST_H */
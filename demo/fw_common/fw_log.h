@@ -0,0 +1,51 @@
+#ifndef FW_LOG_H
+#define FW_LOG_H
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#define FW_LOG_LEVEL_NONE  0
+#define FW_LOG_LEVEL_ERROR 1
+#define FW_LOG_LEVEL_WARN  2
+#define FW_LOG_LEVEL_INFO  3
+#define FW_LOG_LEVEL_DEBUG 4
+
+#ifndef CONFIG_FW_LOG_LEVEL
+#define CONFIG_FW_LOG_LEVEL FW_LOG_LEVEL_INFO
+#endif
+
+#define FW_LOG_ENABLED(level) (CONFIG_FW_LOG_LEVEL >= (level))
+
+/*
+ * Call any printf-style logger only when level is compiled in. The condition is a constant,
+ * so disabled calls vanish while their arguments are still type-checked.
+ */
+#define FW_LOG_AT(level, logger, ...)                                                                                  \
+    do {                                                                                                               \
+        if (FW_LOG_ENABLED(level)) {                                                                                   \
+            logger(__VA_ARGS__);                                                                                       \
+        }                                                                                                              \
+    } while (0)
+
+#ifdef ESP_PLATFORM
+/* ESP_LOGx front-ends. Debug goes out through ESP_LOGI so it shows without raising the IDF log level. */
+#define FW_LOGE(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_ERROR, ESP_LOGE, tag, __VA_ARGS__)
+#define FW_LOGW(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_WARN, ESP_LOGW, tag, __VA_ARGS__)
+#define FW_LOGI(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_INFO, ESP_LOGI, tag, __VA_ARGS__)
+#define FW_LOGD(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_DEBUG, ESP_LOGI, tag, __VA_ARGS__)
+#else
+#include <stdio.h>
+
+/* Host builds (storage emulator, benchmarks) print in the same shape as ESP_LOGx. */
+#define FW_HOST_LOG(letter, tag, fmt, ...) printf(letter " (%s) " fmt "\n", tag, ##__VA_ARGS__)
+#define FW_HOST_LOGE(tag, ...) FW_HOST_LOG("E", tag, __VA_ARGS__)
+#define FW_HOST_LOGW(tag, ...) FW_HOST_LOG("W", tag, __VA_ARGS__)
+#define FW_HOST_LOGI(tag, ...) FW_HOST_LOG("I", tag, __VA_ARGS__)
+#define FW_LOGE(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_ERROR, FW_HOST_LOGE, tag, __VA_ARGS__)
+#define FW_LOGW(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_WARN, FW_HOST_LOGW, tag, __VA_ARGS__)
+#define FW_LOGI(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_INFO, FW_HOST_LOGI, tag, __VA_ARGS__)
+#define FW_LOGD(tag, ...) FW_LOG_AT(FW_LOG_LEVEL_DEBUG, FW_HOST_LOGI, tag, __VA_ARGS__)
+#endif
+
+#endif /* FW_LOG_H */
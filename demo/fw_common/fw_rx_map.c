@@ -0,0 +1,144 @@
+#include "fw_rx_map.h"
+
+#include <string.h>
+
+static bool fw_rx_map_test(const fw_rx_map_t *map, uint32_t block) {
+    return (map->bits[block >> 3] & (uint8_t)(1U << (block & 7U))) != 0U;
+}
+
+static uint32_t fw_rx_map_block_end(const fw_rx_map_t *map, uint32_t block) {
+    uint32_t end = (block + 1U) * FW_RX_BLOCK_BYTES;
+    return end < map->imageBytes ? end : map->imageBytes;
+}
+
+void fw_rx_map_init(fw_rx_map_t *map, uint8_t *bits, size_t capacity) {
+    memset(map, 0, sizeof(*map));
+    map->bits = bits;
+    map->capacity = capacity;
+}
+
+bool fw_rx_map_reset(fw_rx_map_t *map, uint32_t imageBytes) {
+    map->imageBytes = 0U;
+    map->blocks = 0U;
+    map->receivedBlocks = 0U;
+    if (map->bits == NULL || FW_RX_MAP_BYTES(imageBytes) > map->capacity) {
+        return false;
+    }
+    map->imageBytes = imageBytes;
+    map->blocks = (imageBytes + FW_RX_BLOCK_BYTES - 1U) / FW_RX_BLOCK_BYTES;
+    memset(map->bits, 0, FW_RX_MAP_BYTES(imageBytes));
+    return true;
+}
+
+bool fw_rx_map_aligned(const fw_rx_map_t *map, uint32_t offset, uint32_t len) {
+    if (len == 0U || offset >= map->imageBytes || len > map->imageBytes - offset) {
+        return false;
+    }
+    return (offset % FW_RX_BLOCK_BYTES) == 0U &&
+           ((len % FW_RX_BLOCK_BYTES) == 0U || offset + len == map->imageBytes);
+}
+
+void fw_rx_map_mark(fw_rx_map_t *map, uint32_t offset, uint32_t len) {
+    if (len == 0U || offset >= map->imageBytes) {
+        return;
+    }
+    uint32_t end = len > map->imageBytes - offset ? map->imageBytes : offset + len;
+    uint32_t block = (offset + FW_RX_BLOCK_BYTES - 1U) / FW_RX_BLOCK_BYTES;
+    for (; block < map->blocks && fw_rx_map_block_end(map, block) <= end; block++) {
+        if (!fw_rx_map_test(map, block)) {
+            map->bits[block >> 3] |= (uint8_t)(1U << (block & 7U));
+            map->receivedBlocks++;
+        }
+    }
+}
+
+bool fw_rx_map_covered(const fw_rx_map_t *map, uint32_t offset, uint32_t len) {
+    if (len == 0U || offset >= map->imageBytes) {
+        return len == 0U;
+    }
+    uint32_t end = len > map->imageBytes - offset ? map->imageBytes : offset + len;
+    for (uint32_t block = offset / FW_RX_BLOCK_BYTES; block * FW_RX_BLOCK_BYTES < end; block++) {
+        if (!fw_rx_map_test(map, block)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t fw_rx_map_frontier(const fw_rx_map_t *map) {
+    if (map->receivedBlocks == map->blocks) {
+        return map->imageBytes;
+    }
+    uint32_t block = 0U;
+    /* Whole bytes of the bitmap first; transfers mostly arrive in order. */
+    while (block + 8U <= map->blocks && map->bits[block >> 3] == 0xFFU) {
+        block += 8U;
+    }
+    while (block < map->blocks && fw_rx_map_test(map, block)) {
+        block++;
+    }
+    return block * FW_RX_BLOCK_BYTES;
+}
+
+uint32_t fw_rx_map_missing_bytes(const fw_rx_map_t *map) {
+    uint32_t missing = (map->blocks - map->receivedBlocks) * FW_RX_BLOCK_BYTES;
+    if (map->blocks > 0U && !fw_rx_map_test(map, map->blocks - 1U)) {
+        /* The last block is short unless the image size is a multiple of the block size. */
+        missing -= map->blocks * FW_RX_BLOCK_BYTES - map->imageBytes;
+    }
+    return missing;
+}
+
+uint32_t fw_rx_map_holes(const fw_rx_map_t *map, fw_rx_range_t *out, size_t maxRanges) {
+    uint32_t holes = 0U;
+    uint32_t block = 0U;
+    while (block < map->blocks) {
+        if (fw_rx_map_test(map, block)) {
+            block++;
+            continue;
+        }
+        uint32_t first = block;
+        while (block < map->blocks && !fw_rx_map_test(map, block)) {
+            block++;
+        }
+        if (holes < maxRanges) {
+            out[holes].offset = first * FW_RX_BLOCK_BYTES;
+            out[holes].length = fw_rx_map_block_end(map, block - 1U) - out[holes].offset;
+        }
+        holes++;
+    }
+    return holes;
+}
+
+static void fw_rx_put_le32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t fw_rx_get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void fw_rx_ranges_encode(const fw_rx_range_t *ranges, size_t count, uint8_t *buf) {
+    memset(buf, 0, FW_RX_RANGES_BYTES);
+    for (size_t i = 0; i < count && i < FW_RX_MAX_RANGES; i++) {
+        fw_rx_put_le32(buf + i * FW_RX_RANGE_BYTES, ranges[i].offset);
+        fw_rx_put_le32(buf + i * FW_RX_RANGE_BYTES + 4U, ranges[i].length);
+    }
+}
+
+size_t fw_rx_ranges_decode(const uint8_t *buf, size_t len, fw_rx_range_t *out, size_t maxRanges) {
+    size_t count = 0U;
+    for (size_t pos = 0U; pos + FW_RX_RANGE_BYTES <= len && count < maxRanges; pos += FW_RX_RANGE_BYTES) {
+        uint32_t length = fw_rx_get_le32(buf + pos + 4U);
+        if (length == 0U) {
+            continue;
+        }
+        out[count].offset = fw_rx_get_le32(buf + pos);
+        out[count].length = length;
+        count++;
+    }
+    return count;
+}
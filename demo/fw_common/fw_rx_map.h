@@ -0,0 +1,82 @@
+#ifndef FW_RX_MAP_H
+#define FW_RX_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Which parts of an image have arrived, one bit per FW_RX_BLOCK_BYTES.
+ *
+ * Framed chunks (0x1F50:02) carry their own offset: u32 offset (little endian), then the
+ * data. Their offset has to be a multiple of FW_RX_BLOCK_BYTES and their length too, except
+ * for the chunk that ends the image, so every chunk covers whole blocks and resending a
+ * hole sets exactly the bits that were missing.
+ *
+ * Holes are reported in the slave's 0x2102:03 as up to FW_RX_MAX_RANGES pairs of
+ * {u32 offset, u32 length}, little endian, lowest offset first; unused pairs are zero.
+ */
+#define FW_RX_BLOCK_BYTES        64U
+#define FW_RX_FRAME_HEADER_BYTES 4U
+#define FW_RX_MAX_RANGES         16U
+#define FW_RX_RANGE_BYTES        8U
+#define FW_RX_RANGES_BYTES       (FW_RX_MAX_RANGES * FW_RX_RANGE_BYTES)
+
+/* Bitmap bytes needed for an image of the given size. */
+#define FW_RX_MAP_BYTES(imageBytes) ((((imageBytes) + FW_RX_BLOCK_BYTES - 1U) / FW_RX_BLOCK_BYTES + 7U) / 8U)
+
+typedef struct {
+    uint8_t *bits;
+    size_t capacity; /* bytes behind bits */
+    uint32_t imageBytes;
+    uint32_t blocks;
+    uint32_t receivedBlocks;
+} fw_rx_map_t;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} fw_rx_range_t;
+
+/** Attach caller-owned storage; the map is empty until reset. */
+void fw_rx_map_init(fw_rx_map_t *map, uint8_t *bits, size_t capacity);
+
+/** Clear every bit for a new image; false when the image needs more bits than there are. */
+bool fw_rx_map_reset(fw_rx_map_t *map, uint32_t imageBytes);
+
+/** Whether [offset, offset + len) is block aligned the way framed chunks must be. */
+bool fw_rx_map_aligned(const fw_rx_map_t *map, uint32_t offset, uint32_t len);
+
+/** Mark the blocks that [offset, offset + len) covers completely. */
+void fw_rx_map_mark(fw_rx_map_t *map, uint32_t offset, uint32_t len);
+
+/** True when every block that [offset, offset + len) touches has been marked. */
+bool fw_rx_map_covered(const fw_rx_map_t *map, uint32_t offset, uint32_t len);
+
+/** Bytes from the start of the image that have arrived without a gap. */
+uint32_t fw_rx_map_frontier(const fw_rx_map_t *map);
+
+/** Bytes still missing; the last block only counts up to imageBytes. */
+uint32_t fw_rx_map_missing_bytes(const fw_rx_map_t *map);
+
+/**
+ * Collect the holes, lowest first. At most maxRanges are stored in out; the return value is
+ * the total number of holes, which may be larger.
+ */
+uint32_t fw_rx_map_holes(const fw_rx_map_t *map, fw_rx_range_t *out, size_t maxRanges);
+
+/** Encode ranges in the 0x2102:03 wire format; buf must hold FW_RX_RANGES_BYTES. */
+void fw_rx_ranges_encode(const fw_rx_range_t *ranges, size_t count, uint8_t *buf);
+
+/** Decode the 0x2102:03 wire format; returns the number of non-empty ranges stored. */
+size_t fw_rx_ranges_decode(const uint8_t *buf, size_t len, fw_rx_range_t *out, size_t maxRanges);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_RX_MAP_H */
@@ -0,0 +1,160 @@
+#ifndef FW_STORAGE_H
+#define FW_STORAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Where a firmware update ends up. The update core only talks to this table, so the same
+ * session logic runs against an OTA slot on the ESP32, a flash emulator file on a Linux
+ * host or a plain RAM buffer.
+ *
+ *   begin    erase room for imageBytes in the given bank; nothing is written yet
+ *   write    program len bytes at offset (relative to the start of the region)
+ *   end      flush and close; the region holds a complete image afterwards
+ *   abort    drop a session started with begin; safe to call when none is open
+ *   set_boot make the closed region the one used on the next boot
+ *   read     copy back len bytes at offset, for readback verification
+ */
+typedef struct {
+    const char *name;
+    bool (*begin)(void *ctx, uint8_t bank, uint32_t imageBytes);
+    bool (*write)(void *ctx, uint32_t offset, const uint8_t *data, size_t len);
+    bool (*end)(void *ctx);
+    void (*abort)(void *ctx);
+    bool (*set_boot)(void *ctx);
+    bool (*read)(void *ctx, uint32_t offset, uint8_t *buf, size_t len);
+} fw_storage_ops_t;
+
+typedef struct {
+    const fw_storage_ops_t *ops;
+    void *ctx;
+} fw_storage_t;
+
+static inline bool fw_storage_begin(const fw_storage_t *storage, uint8_t bank, uint32_t imageBytes) {
+    return storage->ops->begin(storage->ctx, bank, imageBytes);
+}
+
+static inline bool fw_storage_write(const fw_storage_t *storage, uint32_t offset, const uint8_t *data, size_t len) {
+    return storage->ops->write(storage->ctx, offset, data, len);
+}
+
+static inline bool fw_storage_end(const fw_storage_t *storage) {
+    return storage->ops->end(storage->ctx);
+}
+
+static inline void fw_storage_abort(const fw_storage_t *storage) {
+    storage->ops->abort(storage->ctx);
+}
+
+static inline bool fw_storage_set_boot(const fw_storage_t *storage) {
+    return storage->ops->set_boot(storage->ctx);
+}
+
+static inline bool fw_storage_read(const fw_storage_t *storage, uint32_t offset, uint8_t *buf, size_t len) {
+    return storage->ops->read(storage->ctx, offset, buf, len);
+}
+
+/* RAM backend: a caller-owned buffer stands in for one bank; builds everywhere. */
+typedef struct {
+    uint8_t *buf;
+    uint32_t capacity;
+    uint32_t imageBytes;
+    uint8_t bank;
+    uint8_t bootBank;
+    bool open;
+    bool closed;
+} fw_storage_ram_t;
+
+void fw_storage_ram_init(fw_storage_t *storage, fw_storage_ram_t *ram, uint8_t *buf, uint32_t capacity);
+
+#ifdef ESP_PLATFORM
+
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+
+/*
+ * ESP backend. With no label it targets the next OTA slot through esp_ota_*; with a label it
+ * erases and programs that data partition directly and set_boot is a no-op. OTA writes are
+ * appended while they arrive in order; the first one at another offset switches the session
+ * to esp_ota_write_with_offset for the rest of it.
+ *
+ * skipIdentical (set after init, before begin) trades the up-front erase for a per-sector
+ * diff: each incoming sector is compared with what the partition already holds through a
+ * flash mapping, and only sectors that differ are erased and programmed. Pays off on retried
+ * sessions and releases sharing large regions; a completely new image costs one 4 KiB erase
+ * per sector instead of the faster block erases of esp_ota_begin.
+ */
+typedef struct {
+    const char *label;
+    bool skipIdentical;
+    const esp_partition_t *partition;
+    esp_ota_handle_t handle;
+    uint32_t written;
+    bool open;
+    bool seeking;
+    /* skipIdentical sessions only */
+    uint8_t *sector;
+    uint32_t sectorFill;
+    const uint8_t *mapped;
+    esp_partition_mmap_handle_t mapHandle;
+    uint32_t sectorsSkipped;
+    uint32_t sectorsProgrammed;
+} fw_storage_esp_t;
+
+void fw_storage_esp_ota_init(fw_storage_t *storage, fw_storage_esp_t *esp);
+void fw_storage_esp_partition_init(fw_storage_t *storage, fw_storage_esp_t *esp, const char *label);
+
+/** Partition chosen by the last begin, NULL before that. */
+const esp_partition_t *fw_storage_esp_partition(const fw_storage_t *storage);
+
+#else
+
+#include <stdio.h>
+
+/*
+ * Linux flash emulator. The image lives in a file that behaves like NOR flash: begin erases
+ * whole sectors to 0xFF, programming can only clear bits, and both sleep for the configured
+ * time per sector or page so host runs see realistic erase and write costs. Zero latencies
+ * turn it into a plain file backend for profiling the core alone.
+ */
+typedef struct {
+    const char *path;
+    uint32_t capacity;
+    uint32_t sectorBytes;
+    uint32_t pageBytes;
+    uint32_t eraseUsPerSector;
+    uint32_t writeUsPerPage;
+    /* Filled in by the backend. */
+    FILE *fp;
+    uint32_t imageBytes;
+    uint8_t bank;
+    uint8_t bootBank;
+    bool open;
+    bool closed;
+    uint64_t eraseUs;
+    uint64_t writeUs;
+} fw_storage_file_t;
+
+/* Typical 4 KiB-sector SPI NOR part: 45 ms sector erase, 0.7 ms per 256-byte page. */
+#define FW_STORAGE_FILE_DEFAULTS(filePath, bytes)                                                                      \
+    {                                                                                                                  \
+        .path = (filePath), .capacity = (bytes), .sectorBytes = 4096U, .pageBytes = 256U,                              \
+        .eraseUsPerSector = 45000U, .writeUsPerPage = 700U                                                             \
+    }
+
+bool fw_storage_file_init(fw_storage_t *storage, fw_storage_file_t *file);
+void fw_storage_file_close(fw_storage_file_t *file);
+
+#endif /* ESP_PLATFORM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_STORAGE_H */
@@ -0,0 +1,244 @@
+#include "fw_storage.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "fw_log.h"
+
+static const char *TAG = "fw_storage";
+
+static void fw_esp_release_diff(fw_storage_esp_t *esp) {
+    if (esp->mapped != NULL) {
+        esp_partition_munmap(esp->mapHandle);
+        esp->mapped = NULL;
+    }
+    free(esp->sector);
+    esp->sector = NULL;
+    esp->sectorFill = 0U;
+}
+
+/*
+ * Diff mode needs no erase up front: the current content is mapped once and every full
+ * sector is compared before anything is touched. Without a mapping (no free MMU pages) the
+ * session still works, it just programs every sector.
+ */
+static bool fw_esp_begin_diff(fw_storage_esp_t *esp, const esp_partition_t *part, uint32_t imageBytes) {
+    esp->sector = malloc(part->erase_size);
+    if (esp->sector == NULL) {
+        FW_LOGE(TAG, "No memory for a %u byte sector buffer", (unsigned)part->erase_size);
+        return false;
+    }
+    uint32_t mapBytes = ((imageBytes + part->erase_size - 1U) / part->erase_size) * part->erase_size;
+    const void *mapped = NULL;
+    esp_err_t err =
+        esp_partition_mmap(part, 0, mapBytes, ESP_PARTITION_MMAP_DATA, &mapped, &esp->mapHandle);
+    if (err != ESP_OK) {
+        FW_LOGW(TAG, "Cannot map %s for comparison (err=0x%X); programming every sector", part->label,
+                (unsigned)err);
+        mapped = NULL;
+    }
+    esp->mapped = (const uint8_t *)mapped;
+    esp->sectorFill = 0U;
+    esp->sectorsSkipped = 0U;
+    esp->sectorsProgrammed = 0U;
+    return true;
+}
+
+/* Compare the buffered sector with flash and erase/program it only when it differs. */
+static bool fw_esp_flush_sector(fw_storage_esp_t *esp) {
+    if (esp->sectorFill == 0U) {
+        return true;
+    }
+    const esp_partition_t *part = esp->partition;
+    uint32_t base = esp->written - esp->sectorFill;
+    if (esp->mapped != NULL && memcmp(esp->mapped + base, esp->sector, esp->sectorFill) == 0) {
+        esp->sectorsSkipped++;
+        esp->sectorFill = 0U;
+        return true;
+    }
+    esp_err_t err = esp_partition_erase_range(part, base, part->erase_size);
+    if (err == ESP_OK) {
+        err = esp_partition_write(part, base, esp->sector, esp->sectorFill);
+    }
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "Programming %s sector at %u failed (err=0x%X)", part->label, (unsigned)base, (unsigned)err);
+        return false;
+    }
+    esp->sectorsProgrammed++;
+    esp->sectorFill = 0U;
+    return true;
+}
+
+static bool fw_esp_write_diff(fw_storage_esp_t *esp, const uint8_t *data, size_t len) {
+    uint32_t sectorBytes = esp->partition->erase_size;
+    while (len > 0U) {
+        size_t take = sectorBytes - esp->sectorFill;
+        if (take > len) {
+            take = len;
+        }
+        memcpy(esp->sector + esp->sectorFill, data, take);
+        esp->sectorFill += (uint32_t)take;
+        esp->written += (uint32_t)take;
+        data += take;
+        len -= take;
+        if (esp->sectorFill == sectorBytes && !fw_esp_flush_sector(esp)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool fw_esp_begin(void *ctx, uint8_t bank, uint32_t imageBytes) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    (void)bank;
+    if (esp->open) {
+        return false;
+    }
+
+    const esp_partition_t *part =
+        esp->label == NULL ? esp_ota_get_next_update_partition(NULL)
+                           : esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, esp->label);
+    if (part == NULL) {
+        FW_LOGE(TAG, "No %s partition available for update", esp->label != NULL ? esp->label : "OTA");
+        return false;
+    }
+    if (imageBytes > part->size) {
+        FW_LOGE(TAG, "Image size %u exceeds partition %s size %u", (unsigned)imageBytes, part->label,
+                 (unsigned)part->size);
+        return false;
+    }
+
+    esp_err_t err;
+    if (esp->skipIdentical) {
+        if (!fw_esp_begin_diff(esp, part, imageBytes)) {
+            return false;
+        }
+        err = ESP_OK;
+    } else if (esp->label == NULL) {
+        err = esp_ota_begin(part, imageBytes, &esp->handle);
+    } else {
+        uint32_t sector = part->erase_size;
+        err = esp_partition_erase_range(part, 0, ((imageBytes + sector - 1U) / sector) * sector);
+    }
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "Erasing %s failed (err=0x%X)", part->label, (unsigned)err);
+        return false;
+    }
+    esp->partition = part;
+    esp->written = 0U;
+    esp->seeking = false;
+    esp->open = true;
+    return true;
+}
+
+static bool fw_esp_write(void *ctx, uint32_t offset, const uint8_t *data, size_t len) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    if (!esp->open) {
+        return false;
+    }
+    if (esp->skipIdentical) {
+        /* Sectors are diffed as they fill up, so blocks have to arrive in order. */
+        if (offset != esp->written) {
+            FW_LOGE(TAG, "Out of order write at %u (expected %u)", (unsigned)offset, (unsigned)esp->written);
+            return false;
+        }
+        return fw_esp_write_diff(esp, data, len);
+    }
+    esp_err_t err;
+    if (esp->label == NULL) {
+        /* esp_ota_write appends and does the image magic check on the first block. */
+        esp->seeking = esp->seeking || offset != esp->written;
+        err = esp->seeking ? esp_ota_write_with_offset(esp->handle, data, len, offset)
+                           : esp_ota_write(esp->handle, data, len);
+    } else {
+        err = esp_partition_write(esp->partition, offset, data, len);
+    }
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "Writing %s failed at offset %u (err=0x%X)", esp->partition->label, (unsigned)offset,
+                 (unsigned)err);
+        return false;
+    }
+    esp->written = offset + (uint32_t)len;
+    return true;
+}
+
+static bool fw_esp_end(void *ctx) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    if (!esp->open) {
+        return false;
+    }
+    esp->open = false;
+    if (esp->skipIdentical) {
+        /* The partial last sector; esp_ota_set_boot_partition still verifies the image. */
+        bool ok = fw_esp_flush_sector(esp);
+        FW_LOGI(TAG, "%s: %u sectors unchanged, %u programmed", esp->partition->label,
+                 (unsigned)esp->sectorsSkipped, (unsigned)esp->sectorsProgrammed);
+        fw_esp_release_diff(esp);
+        return ok;
+    }
+    if (esp->label != NULL) {
+        return true;
+    }
+    esp_err_t err = esp_ota_end(esp->handle);
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "esp_ota_end failed (err=0x%X)", (unsigned)err);
+        return false;
+    }
+    return true;
+}
+
+static void fw_esp_abort(void *ctx) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    if (esp->open && esp->label == NULL && !esp->skipIdentical) {
+        (void)esp_ota_abort(esp->handle);
+    }
+    fw_esp_release_diff(esp);
+    esp->open = false;
+}
+
+static bool fw_esp_set_boot(void *ctx) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    if (esp->partition == NULL || esp->open) {
+        return false;
+    }
+    if (esp->label != NULL) {
+        return true;
+    }
+    esp_err_t err = esp_ota_set_boot_partition(esp->partition);
+    if (err != ESP_OK) {
+        FW_LOGE(TAG, "Failed to set boot partition to %s (err=0x%X)", esp->partition->label, (unsigned)err);
+        return false;
+    }
+    return true;
+}
+
+static bool fw_esp_read(void *ctx, uint32_t offset, uint8_t *buf, size_t len) {
+    fw_storage_esp_t *esp = (fw_storage_esp_t *)ctx;
+    return esp->partition != NULL && esp_partition_read(esp->partition, offset, buf, len) == ESP_OK;
+}
+
+static const fw_storage_ops_t s_esp_ops = {
+    .name = "esp",
+    .begin = fw_esp_begin,
+    .write = fw_esp_write,
+    .end = fw_esp_end,
+    .abort = fw_esp_abort,
+    .set_boot = fw_esp_set_boot,
+    .read = fw_esp_read,
+};
+
+void fw_storage_esp_ota_init(fw_storage_t *storage, fw_storage_esp_t *esp) {
+    fw_storage_esp_partition_init(storage, esp, NULL);
+}
+
+void fw_storage_esp_partition_init(fw_storage_t *storage, fw_storage_esp_t *esp, const char *label) {
+    memset(esp, 0, sizeof(*esp));
+    esp->label = label;
+    storage->ops = &s_esp_ops;
+    storage->ctx = esp;
+}
+
+const esp_partition_t *fw_storage_esp_partition(const fw_storage_t *storage) {
+    return ((const fw_storage_esp_t *)storage->ctx)->partition;
+}
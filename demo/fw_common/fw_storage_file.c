@@ -0,0 +1,155 @@
+#include "fw_storage.h"
+
+#ifndef ESP_PLATFORM
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#define FW_FILE_CHUNK 4096U
+
+static void fw_file_delay(uint64_t us) {
+    if (us == 0U) {
+        return;
+    }
+    struct timespec ts = {.tv_sec = (time_t)(us / 1000000U), .tv_nsec = (long)((us % 1000000U) * 1000U)};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+static bool fw_file_pread(fw_storage_file_t *file, uint32_t offset, uint8_t *buf, size_t len) {
+    return fseek(file->fp, (long)offset, SEEK_SET) == 0 && fread(buf, 1, len, file->fp) == len;
+}
+
+static bool fw_file_pwrite(fw_storage_file_t *file, uint32_t offset, const uint8_t *data, size_t len) {
+    return fseek(file->fp, (long)offset, SEEK_SET) == 0 && fwrite(data, 1, len, file->fp) == len;
+}
+
+static bool fw_file_begin(void *ctx, uint8_t bank, uint32_t imageBytes) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    if (file->open || imageBytes > file->capacity) {
+        return false;
+    }
+
+    uint8_t blank[FW_FILE_CHUNK];
+    memset(blank, 0xFF, sizeof(blank));
+    uint32_t sectors = (imageBytes + file->sectorBytes - 1U) / file->sectorBytes;
+    uint32_t eraseBytes = sectors * file->sectorBytes;
+    if (eraseBytes > file->capacity) {
+        eraseBytes = file->capacity;
+    }
+    for (uint32_t pos = 0; pos < eraseBytes; pos += FW_FILE_CHUNK) {
+        uint32_t take = eraseBytes - pos < FW_FILE_CHUNK ? eraseBytes - pos : FW_FILE_CHUNK;
+        if (!fw_file_pwrite(file, pos, blank, take)) {
+            return false;
+        }
+    }
+    uint64_t eraseUs = (uint64_t)sectors * file->eraseUsPerSector;
+    fw_file_delay(eraseUs);
+    file->eraseUs += eraseUs;
+
+    file->imageBytes = imageBytes;
+    file->bank = bank;
+    file->open = true;
+    file->closed = false;
+    return true;
+}
+
+/* NOR semantics: the stored byte becomes old & new, so writing twice without an erase shows up on readback. */
+static bool fw_file_write(void *ctx, uint32_t offset, const uint8_t *data, size_t len) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    if (!file->open || offset > file->imageBytes || len > file->imageBytes - offset) {
+        return false;
+    }
+
+    uint8_t old[FW_FILE_CHUNK];
+    for (size_t pos = 0; pos < len; pos += FW_FILE_CHUNK) {
+        size_t take = len - pos < FW_FILE_CHUNK ? len - pos : FW_FILE_CHUNK;
+        if (!fw_file_pread(file, offset + (uint32_t)pos, old, take)) {
+            return false;
+        }
+        for (size_t i = 0; i < take; i++) {
+            old[i] &= data[pos + i];
+        }
+        if (!fw_file_pwrite(file, offset + (uint32_t)pos, old, take)) {
+            return false;
+        }
+    }
+
+    uint32_t firstPage = offset / file->pageBytes;
+    uint32_t lastPage = (offset + (uint32_t)len - 1U) / file->pageBytes;
+    uint64_t writeUs = (uint64_t)(lastPage - firstPage + 1U) * file->writeUsPerPage;
+    fw_file_delay(writeUs);
+    file->writeUs += writeUs;
+    return true;
+}
+
+static bool fw_file_end(void *ctx) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    if (!file->open || fflush(file->fp) != 0) {
+        return false;
+    }
+    file->open = false;
+    file->closed = true;
+    return true;
+}
+
+static void fw_file_abort(void *ctx) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    file->open = false;
+    file->closed = false;
+}
+
+static bool fw_file_set_boot(void *ctx) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    if (!file->closed) {
+        return false;
+    }
+    file->bootBank = file->bank;
+    return true;
+}
+
+static bool fw_file_read(void *ctx, uint32_t offset, uint8_t *buf, size_t len) {
+    fw_storage_file_t *file = (fw_storage_file_t *)ctx;
+    if (offset > file->imageBytes || len > file->imageBytes - offset) {
+        return false;
+    }
+    return fw_file_pread(file, offset, buf, len);
+}
+
+static const fw_storage_ops_t s_file_ops = {
+    .name = "file",
+    .begin = fw_file_begin,
+    .write = fw_file_write,
+    .end = fw_file_end,
+    .abort = fw_file_abort,
+    .set_boot = fw_file_set_boot,
+    .read = fw_file_read,
+};
+
+bool fw_storage_file_init(fw_storage_t *storage, fw_storage_file_t *file) {
+    if (file->path == NULL || file->capacity == 0U || file->sectorBytes == 0U || file->pageBytes == 0U) {
+        return false;
+    }
+    file->fp = fopen(file->path, "w+b");
+    if (file->fp == NULL) {
+        return false;
+    }
+    file->imageBytes = 0U;
+    file->open = false;
+    file->closed = false;
+    file->eraseUs = 0U;
+    file->writeUs = 0U;
+    storage->ops = &s_file_ops;
+    storage->ctx = file;
+    return true;
+}
+
+void fw_storage_file_close(fw_storage_file_t *file) {
+    if (file->fp != NULL) {
+        fclose(file->fp);
+        file->fp = NULL;
+    }
+}
+
+#endif /* ESP_PLATFORM */
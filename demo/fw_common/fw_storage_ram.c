@@ -0,0 +1,77 @@
+#include "fw_storage.h"
+
+#include <string.h>
+
+static bool fw_ram_begin(void *ctx, uint8_t bank, uint32_t imageBytes) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    if (ram->open || imageBytes > ram->capacity) {
+        return false;
+    }
+    memset(ram->buf, 0xFF, imageBytes);
+    ram->imageBytes = imageBytes;
+    ram->bank = bank;
+    ram->open = true;
+    ram->closed = false;
+    return true;
+}
+
+static bool fw_ram_write(void *ctx, uint32_t offset, const uint8_t *data, size_t len) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    if (!ram->open || offset > ram->imageBytes || len > ram->imageBytes - offset) {
+        return false;
+    }
+    memcpy(ram->buf + offset, data, len);
+    return true;
+}
+
+static bool fw_ram_end(void *ctx) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    if (!ram->open) {
+        return false;
+    }
+    ram->open = false;
+    ram->closed = true;
+    return true;
+}
+
+static void fw_ram_abort(void *ctx) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    ram->open = false;
+    ram->closed = false;
+}
+
+static bool fw_ram_set_boot(void *ctx) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    if (!ram->closed) {
+        return false;
+    }
+    ram->bootBank = ram->bank;
+    return true;
+}
+
+static bool fw_ram_read(void *ctx, uint32_t offset, uint8_t *buf, size_t len) {
+    fw_storage_ram_t *ram = (fw_storage_ram_t *)ctx;
+    if (offset > ram->imageBytes || len > ram->imageBytes - offset) {
+        return false;
+    }
+    memcpy(buf, ram->buf + offset, len);
+    return true;
+}
+
+static const fw_storage_ops_t s_ram_ops = {
+    .name = "ram",
+    .begin = fw_ram_begin,
+    .write = fw_ram_write,
+    .end = fw_ram_end,
+    .abort = fw_ram_abort,
+    .set_boot = fw_ram_set_boot,
+    .read = fw_ram_read,
+};
+
+void fw_storage_ram_init(fw_storage_t *storage, fw_storage_ram_t *ram, uint8_t *buf, uint32_t capacity) {
+    memset(ram, 0, sizeof(*ram));
+    ram->buf = buf;
+    ram->capacity = capacity;
+    storage->ops = &s_ram_ops;
+    storage->ctx = ram;
+}
@@ -0,0 +1,105 @@
+#include "fw_trace.h"
+
+#if CONFIG_FW_TRACE_ENABLE
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "esp_timer.h"
+
+#ifndef CONFIG_FW_TRACE_ENTRIES
+#define CONFIG_FW_TRACE_ENTRIES 512
+#endif
+
+/* Largest power of two not above the configured size, so the index wraps with a mask. */
+#define FW_TRACE_POW2(n)                                                                                               \
+    ((n) >= 8192 ? 8192 : (n) >= 4096 ? 4096 : (n) >= 2048 ? 2048 : (n) >= 1024 ? 1024 : (n) >= 512 ? 512        \
+     : (n) >= 256 ? 256 : (n) >= 128 ? 128 : (n) >= 64 ? 64 : (n) >= 32 ? 32 : 16)
+#define FW_TRACE_SIZE FW_TRACE_POW2(CONFIG_FW_TRACE_ENTRIES)
+#define FW_TRACE_MASK (FW_TRACE_SIZE - 1U)
+
+static fw_trace_entry_t s_ring[FW_TRACE_SIZE];
+static uint32_t s_head;
+static int64_t s_epochUs;
+
+static const char *fw_trace_event_name(uint16_t event) {
+    switch (event) {
+    case FW_EV_SESSION_BEGIN:
+        return "session";
+    case FW_EV_META_TX:
+        return "meta-tx";
+    case FW_EV_START_TX:
+        return "start-tx";
+    case FW_EV_CHUNK_TX:
+        return "chunk-tx";
+    case FW_EV_CHUNK_DONE:
+        return "chunk-done";
+    case FW_EV_SDO_ABORT:
+        return "sdo-abort";
+    case FW_EV_SDO_RETRY:
+        return "sdo-retry";
+    case FW_EV_FINALIZE_TX:
+        return "final-tx";
+    case FW_EV_SESSION_END:
+        return "session-end";
+    case FW_EV_META_RX:
+        return "meta-rx";
+    case FW_EV_ERASE_DONE:
+        return "erase";
+    case FW_EV_CHUNK_RX:
+        return "chunk-rx";
+    case FW_EV_OTA_WRITE:
+        return "ota-write";
+    case FW_EV_CHUNK_REJECT:
+        return "chunk-reject";
+    case FW_EV_FINALIZE_RX:
+        return "final-rx";
+    case FW_EV_STAGE:
+        return "stage";
+    case FW_EV_VERIFY_DONE:
+        return "verify";
+    case FW_EV_IMAGE_HEADER:
+        return "header";
+    case FW_EV_UNORDERED:
+        return "unordered";
+    case FW_EV_VERIFY_POLL:
+        return "verify-poll";
+    case FW_EV_HOLES:
+        return "holes";
+    case FW_EV_PACE:
+        return "pace";
+    default:
+        return "?";
+    }
+}
+
+void fw_trace_reset(void) {
+    __atomic_store_n(&s_head, 0U, __ATOMIC_RELAXED);
+    s_epochUs = esp_timer_get_time();
+}
+
+void fw_trace_record(uint16_t event, uint32_t a, uint32_t b) {
+    uint32_t slot = __atomic_fetch_add(&s_head, 1U, __ATOMIC_RELAXED) & FW_TRACE_MASK;
+    fw_trace_entry_t *entry = &s_ring[slot];
+    entry->timeUs = (uint32_t)(esp_timer_get_time() - s_epochUs);
+    entry->event = event;
+    entry->a = a;
+    entry->b = b;
+}
+
+void fw_trace_dump(const char *title) {
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+    uint32_t count = head < FW_TRACE_SIZE ? head : FW_TRACE_SIZE;
+    uint32_t first = head - count;
+
+    printf("---- trace %s: %" PRIu32 " records, %" PRIu32 " overwritten ----\n", title != NULL ? title : "",
+           count, first);
+    for (uint32_t i = first; i != head; i++) {
+        const fw_trace_entry_t *entry = &s_ring[i & FW_TRACE_MASK];
+        printf("%10" PRIu32 " %-12s 0x%08" PRIX32 " %" PRIu32 "\n", entry->timeUs, fw_trace_event_name(entry->event),
+               entry->a, entry->b);
+    }
+    printf("---- end of trace ----\n");
+}
+
+#endif /* CONFIG_FW_TRACE_ENABLE */
@@ -0,0 +1,81 @@
+#ifndef FW_TRACE_H
+#define FW_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    /* master */
+    FW_EV_SESSION_BEGIN = 1, /* a = image bytes, b = crc */
+    FW_EV_META_TX,           /* a = image bytes, b = crc */
+    FW_EV_START_TX,          /* a = type, b = bank */
+    FW_EV_CHUNK_TX,          /* a = offset, b = length */
+    FW_EV_CHUNK_DONE,        /* a = offset, b = SDO round trip in us */
+    FW_EV_SDO_ABORT,         /* a = index << 8 | sub, b = abort code */
+    FW_EV_SDO_RETRY,         /* a = abort code being retried, b = attempt */
+    FW_EV_FINALIZE_TX,       /* a = crc */
+    FW_EV_SESSION_END,       /* a = ok, b = bytes sent */
+    /* slave */
+    FW_EV_META_RX = 32,      /* a = image bytes, b = crc */
+    FW_EV_ERASE_DONE,        /* a = partition address, b = esp_ota_begin time in us */
+    FW_EV_CHUNK_RX,          /* a = offset, b = length */
+    FW_EV_OTA_WRITE,         /* a = offset, b = esp_ota_write time in us */
+    FW_EV_CHUNK_REJECT,      /* a = offset, b = expected offset */
+    FW_EV_FINALIZE_RX,       /* a = crc, b = 1 when it matched */
+    FW_EV_STAGE,             /* a = old stage, b = new stage */
+    FW_EV_VERIFY_DONE,       /* a = 1 when flash matched, b = readback time in us */
+    FW_EV_IMAGE_HEADER,      /* a = 1 when accepted, b = chip id in the image header */
+    FW_EV_UNORDERED,         /* a = chunk offset, b = contiguous bytes when the session went out of order */
+    /* master */
+    FW_EV_VERIFY_POLL = 64,  /* a = slave verify state, b = ms waited so far */
+    FW_EV_HOLES,             /* a = holes the slave reported, b = missing bytes */
+    FW_EV_PACE               /* a = us a chunk waited for bus budget, b = budget in kbit/s */
+} fw_trace_event_t;
+
+/* One record; 16 bytes so a ring of 512 costs 8 KB. */
+typedef struct {
+    uint32_t timeUs;
+    uint16_t event;
+    uint16_t reserved;
+    uint32_t a;
+    uint32_t b;
+} fw_trace_entry_t;
+
+#if CONFIG_FW_TRACE_ENABLE
+
+/** Drop all records and restart timestamps at zero. */
+void fw_trace_reset(void);
+
+/** Append a record; lock-free and safe from any task on either core. */
+void fw_trace_record(uint16_t event, uint32_t a, uint32_t b);
+
+/** Print every record still in the ring, oldest first. */
+void fw_trace_dump(const char *title);
+
+#define FW_TRACE(event, a, b) fw_trace_record((uint16_t)(event), (uint32_t)(a), (uint32_t)(b))
+
+#else
+
+static inline void fw_trace_reset(void) {}
+static inline void fw_trace_dump(const char *title) { (void)title; }
+#define FW_TRACE(event, a, b)                                                                                          \
+    do {                                                                                                               \
+        (void)(a);                                                                                                     \
+        (void)(b);                                                                                                     \
+    } while (0)
+
+#endif /* CONFIG_FW_TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_TRACE_H */
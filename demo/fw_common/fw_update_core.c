@@ -0,0 +1,283 @@
+#include "fw_update_core.h"
+
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#endif
+#include "fw_log.h"
+#include "fw_trace.h"
+
+#define FW_CORE_READBACK_BYTES 1024U
+
+static const char *TAG = "fw_core";
+
+void fw_core_init(fw_core_t *core, const fw_storage_t *storage, uint32_t maxImageBytes) {
+    memset(core, 0, sizeof(*core));
+    core->stage = FW_STAGE_IDLE;
+    core->runningCrc = 0xFFFFU;
+    core->maxImageBytes = maxImageBytes;
+    core->storage = *storage;
+}
+
+void fw_core_set_stage(fw_core_t *core, fw_stage_t stage) {
+    if (core->stageHook != NULL) {
+        core->stageHook(core->stageArg, core->stage, stage);
+    }
+    core->stage = stage;
+}
+
+bool fw_core_metadata_valid(const fw_core_t *core, const fw_metadata_record_t *meta) {
+    if (meta->imageBytes == 0U) {
+        FW_LOGE(TAG, "Metadata rejected: size is zero");
+        return false;
+    }
+    if (meta->imageBytes > core->maxImageBytes) {
+        FW_LOGE(TAG, "Metadata rejected: size %u exceeds limit", (unsigned)meta->imageBytes);
+        return false;
+    }
+    if (meta->crc == 0U) {
+        FW_LOGE(TAG, "Metadata rejected: CRC cannot be zero");
+        return false;
+    }
+    return true;
+}
+
+void fw_core_accept_metadata(fw_core_t *core, const fw_metadata_record_t *meta) {
+    fw_core_close_storage(core);
+    fw_digest_abort(&core->digest);
+    core->expectedSize = meta->imageBytes;
+    core->expectedCrc = meta->crc;
+    core->imageType = meta->imageType;
+    core->currentBank = meta->bank;
+    core->receivedBytes = 0U;
+    core->runningCrc = 0xFFFFU;
+    core->digestType = FW_DIGEST_NONE;
+    core->unordered = false;
+    core->storageClosed = false;
+    core->flashPrepared = false;
+    core->crcMatched = false;
+    core->stage = FW_STAGE_IDLE;
+    fw_core_set_stage(core, FW_STAGE_METADATA_READY);
+    core->metadataReceived = true;
+}
+
+bool fw_core_store_metadata(fw_core_t *core, const fw_metadata_record_t *meta) {
+    if (!fw_core_metadata_valid(core, meta)) {
+        return false;
+    }
+    fw_core_accept_metadata(core, meta);
+    return true;
+}
+
+bool fw_core_store_digest(fw_core_t *core, fw_digest_type_t type, const uint8_t digest[FW_DIGEST_MAX_LEN]) {
+    if (!core->metadataReceived || core->stage != FW_STAGE_METADATA_READY) {
+        FW_LOGE(TAG, "Digest rejected: send metadata first and before the start command");
+        return false;
+    }
+    if (type != FW_DIGEST_NONE && fw_digest_length(type) == 0U) {
+        FW_LOGE(TAG, "Digest rejected: unknown type %u", (unsigned)type);
+        return false;
+    }
+    core->digestType = type;
+    memcpy(core->expectedDigest, digest, sizeof(core->expectedDigest));
+    return true;
+}
+
+bool fw_core_open_storage(fw_core_t *core, uint32_t imageBytes) {
+    if (!fw_storage_begin(&core->storage, core->currentBank, imageBytes)) {
+        FW_LOGE(TAG, "Storage '%s' could not be prepared for %u bytes", core->storage.ops->name,
+                 (unsigned)imageBytes);
+        return false;
+    }
+    core->storageOpen = true;
+    return true;
+}
+
+void fw_core_close_storage(fw_core_t *core) {
+    if (core->storageOpen) {
+        fw_storage_abort(&core->storage);
+        core->storageOpen = false;
+    }
+}
+
+bool fw_core_begin_receiving(fw_core_t *core) {
+    if (!fw_digest_begin(&core->digest, core->digestType)) {
+        FW_LOGE(TAG, "Cannot start digest type %u", (unsigned)core->digestType);
+        return false;
+    }
+    core->flashPrepared = true;
+    fw_core_set_stage(core, FW_STAGE_RECEIVING_BLOCKS);
+    return true;
+}
+
+void fw_core_cancel(fw_core_t *core) {
+    fw_digest_abort(&core->digest);
+    fw_core_close_storage(core);
+    core->flashPrepared = false;
+    fw_core_set_stage(core, FW_STAGE_METADATA_READY);
+}
+
+bool fw_core_prepare(fw_core_t *core) {
+    if (!core->metadataReceived || core->stage != FW_STAGE_METADATA_READY) {
+        FW_LOGE(TAG, "Cannot prepare storage before valid metadata");
+        return false;
+    }
+    fw_core_set_stage(core, FW_STAGE_ERASING_FLASH);
+    if (!fw_core_open_storage(core, core->expectedSize) || !fw_core_begin_receiving(core)) {
+        fw_core_cancel(core);
+        return false;
+    }
+    return true;
+}
+
+bool fw_core_check_chunk(const fw_core_t *core, uint32_t offset, uint32_t len) {
+    if (!core->flashPrepared || core->stage != FW_STAGE_RECEIVING_BLOCKS) {
+        FW_LOGE(TAG, "Chunk rejected: flash not prepared or wrong stage (%d)", (int)core->stage);
+        return false;
+    }
+    if (offset != core->receivedBytes) {
+        FW_TRACE(FW_EV_CHUNK_REJECT, offset, core->receivedBytes);
+        FW_LOGE(TAG, "Chunk rejected: expected offset %u got %u", (unsigned)core->receivedBytes, (unsigned)offset);
+        return false;
+    }
+    if (len > core->expectedSize - core->receivedBytes) {
+        FW_LOGE(TAG, "Chunk rejected: would overflow image size (%u)", (unsigned)core->expectedSize);
+        return false;
+    }
+    return true;
+}
+
+void fw_core_absorb(fw_core_t *core, const uint8_t *data, size_t len) {
+    if (core->digestType != FW_DIGEST_NONE) {
+        fw_digest_update(&core->digest, data, len);
+    } else {
+        core->runningCrc = fw_crc16_update(core->runningCrc, data, len);
+    }
+}
+
+bool fw_core_write_block(fw_core_t *core, const uint8_t *data, size_t len, uint32_t offset) {
+    if (!fw_storage_write(&core->storage, offset, data, len)) {
+        FW_LOGE(TAG, "Storage write of %u bytes at offset %u failed", (unsigned)len, (unsigned)offset);
+        return false;
+    }
+    fw_core_absorb(core, data, len);
+    return true;
+}
+
+void fw_core_mark_unordered(fw_core_t *core) {
+    if (!core->unordered) {
+        fw_digest_abort(&core->digest);
+        core->unordered = true;
+    }
+}
+
+bool fw_core_receive_chunk(fw_core_t *core, const uint8_t *data, uint32_t len, uint32_t offset) {
+    if (!fw_core_check_chunk(core, offset, len) || !fw_core_write_block(core, data, len, offset)) {
+        return false;
+    }
+    core->receivedBytes += len;
+    return true;
+}
+
+bool fw_core_check_complete(const fw_core_t *core) {
+    if (core->stage != FW_STAGE_RECEIVING_BLOCKS) {
+        FW_LOGE(TAG, "Finalize refused: wrong stage %d", (int)core->stage);
+        return false;
+    }
+    if (core->receivedBytes != core->expectedSize) {
+        FW_LOGE(TAG, "Finalize refused: received %u bytes but expected %u", (unsigned)core->receivedBytes,
+                 (unsigned)core->expectedSize);
+        return false;
+    }
+    return true;
+}
+
+bool fw_core_finish(fw_core_t *core, uint16_t crc) {
+    if (core->unordered) {
+        if (crc != core->expectedCrc) {
+            FW_LOGE(TAG, "Finalize crc 0x%04X does not match declared 0x%04X", crc, core->expectedCrc);
+            return false;
+        }
+        /* Stands in until readback has checked what is in storage. */
+        core->runningCrc = core->expectedCrc;
+    } else if (core->digestType != FW_DIGEST_NONE) {
+        uint8_t computed[FW_DIGEST_MAX_LEN];
+        size_t digestLen = fw_digest_finish(&core->digest, computed);
+        if (crc != core->expectedCrc || digestLen == 0U ||
+            memcmp(computed, core->expectedDigest, digestLen) != 0) {
+            FW_LOGE(TAG, "Digest mismatch (type %u, finalize crc 0x%04X declared 0x%04X)", (unsigned)core->digestType,
+                     crc, core->expectedCrc);
+            return false;
+        }
+        /* The stronger digest stands in for the CRC16 that was not computed. */
+        core->runningCrc = core->expectedCrc;
+    } else if (core->runningCrc != crc || core->runningCrc != core->expectedCrc) {
+        FW_LOGE(TAG, "CRC mismatch: computed 0x%04X expected 0x%04X (declared 0x%04X)", core->runningCrc, crc,
+                 core->expectedCrc);
+        return false;
+    }
+
+    if (core->storageOpen) {
+        core->storageOpen = false;
+        if (!fw_storage_end(&core->storage)) {
+            FW_LOGE(TAG, "Storage '%s' could not be closed", core->storage.ops->name);
+            return false;
+        }
+        core->storageClosed = true;
+    }
+    return true;
+}
+
+bool fw_core_finalize(fw_core_t *core, uint16_t crc) {
+    if (!fw_core_check_complete(core)) {
+        return false;
+    }
+    fw_core_set_stage(core, FW_STAGE_VERIFYING);
+    return fw_core_finish(core, crc);
+}
+
+bool fw_core_verify_readback(fw_core_t *core, uint32_t size, fw_digest_type_t type,
+                             const uint8_t expected[FW_DIGEST_MAX_LEN]) {
+    if (type != FW_DIGEST_NONE && !fw_digest_begin(&core->digest, type)) {
+        return false;
+    }
+    uint8_t block[FW_CORE_READBACK_BYTES];
+    uint16_t crc = 0xFFFFU;
+    for (uint32_t offset = 0; offset < size; offset += FW_CORE_READBACK_BYTES) {
+        uint32_t take = size - offset < FW_CORE_READBACK_BYTES ? size - offset : FW_CORE_READBACK_BYTES;
+        if (!fw_storage_read(&core->storage, offset, block, take)) {
+            FW_LOGE(TAG, "Readback failed at offset %u", (unsigned)offset);
+            fw_digest_abort(&core->digest);
+            return false;
+        }
+        if (type != FW_DIGEST_NONE) {
+            fw_digest_update(&core->digest, block, take);
+        } else {
+            crc = fw_crc16_update(crc, block, take);
+        }
+    }
+
+    bool matched;
+    if (type != FW_DIGEST_NONE) {
+        uint8_t computed[FW_DIGEST_MAX_LEN];
+        size_t digestLen = fw_digest_finish(&core->digest, computed);
+        matched = digestLen > 0U && memcmp(computed, expected, digestLen) == 0;
+    } else {
+        matched = crc == core->expectedCrc;
+    }
+    if (!matched) {
+        FW_LOGE(TAG, "Readback of %u bytes does not match the received image", (unsigned)size);
+    }
+    return matched;
+}
+
+bool fw_core_activate(fw_core_t *core) {
+    if (core->storageClosed && !fw_storage_set_boot(&core->storage)) {
+        FW_LOGE(TAG, "Storage '%s' refused the new boot image", core->storage.ops->name);
+        return false;
+    }
+    core->crcMatched = true;
+    fw_core_set_stage(core, FW_STAGE_READY_TO_BOOT);
+    return true;
+}
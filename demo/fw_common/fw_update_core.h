@@ -0,0 +1,143 @@
+#ifndef FW_UPDATE_CORE_H
+#define FW_UPDATE_CORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fw_digest.h"
+#include "fw_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Platform-neutral part of a firmware download: metadata checks, chunk sequencing, CRC16 or
+ * digest over the data, and the storage calls for erase, program, close and boot. Transport
+ * (SDO objects), threading and timing stay with the caller, which drives the stages either
+ * through fw_core_prepare/fw_core_receive_chunk/fw_core_finalize or through the smaller steps
+ * when it needs to do work between them.
+ */
+
+typedef enum {
+    FW_STAGE_IDLE = 0,
+    FW_STAGE_METADATA_READY,
+    FW_STAGE_ERASING_FLASH,
+    FW_STAGE_RECEIVING_BLOCKS,
+    FW_STAGE_VERIFYING,
+    FW_STAGE_READY_TO_BOOT,
+    FW_STAGE_COUNT
+} fw_stage_t;
+
+/* Payload of 0x1F57:01 as the master sends it. */
+typedef struct {
+    uint32_t imageBytes;
+    uint16_t crc;
+    uint8_t imageType;
+    uint8_t bank;
+} fw_metadata_record_t;
+
+/* Called on every stage change before the new stage is stored. */
+typedef void (*fw_core_stage_hook_t)(void *arg, fw_stage_t from, fw_stage_t to);
+
+typedef struct {
+    fw_stage_t stage;
+    uint32_t maxImageBytes;
+    uint32_t expectedSize;
+    uint32_t receivedBytes;
+    uint16_t expectedCrc;
+    uint16_t runningCrc;
+    uint8_t currentBank;
+    uint8_t imageType;
+    bool metadataReceived;
+    bool flashPrepared;
+    bool crcMatched;
+    /* storageOpen between begin and end/abort; storageClosed once end succeeded this session. */
+    bool storageOpen;
+    bool storageClosed;
+    /*
+     * Set once data was stored out of order: the CRC16/digest over the stream no longer
+     * describes the image, so finish only checks the declared CRC and the caller has to
+     * verify the image by reading it back.
+     */
+    bool unordered;
+    /* With a digest announced, it replaces the per-byte CRC16 on the data path. */
+    fw_digest_type_t digestType;
+    uint8_t expectedDigest[FW_DIGEST_MAX_LEN];
+    fw_digest_t digest;
+    fw_storage_t storage;
+    fw_core_stage_hook_t stageHook;
+    void *stageArg;
+} fw_core_t;
+
+void fw_core_init(fw_core_t *core, const fw_storage_t *storage, uint32_t maxImageBytes);
+void fw_core_set_stage(fw_core_t *core, fw_stage_t stage);
+
+/** Size, CRC and limit checks only; logs the reason when the record is refused. */
+bool fw_core_metadata_valid(const fw_core_t *core, const fw_metadata_record_t *meta);
+
+/** Drop any session in progress and arm a new one for meta, which must be valid. */
+void fw_core_accept_metadata(fw_core_t *core, const fw_metadata_record_t *meta);
+
+bool fw_core_store_metadata(fw_core_t *core, const fw_metadata_record_t *meta);
+bool fw_core_store_digest(fw_core_t *core, fw_digest_type_t type, const uint8_t digest[FW_DIGEST_MAX_LEN]);
+
+/** Erase room for imageBytes through the storage backend. */
+bool fw_core_open_storage(fw_core_t *core, uint32_t imageBytes);
+void fw_core_close_storage(fw_core_t *core);
+
+/** Start the digest and move to RECEIVING_BLOCKS; storage has to be open already. */
+bool fw_core_begin_receiving(fw_core_t *core);
+
+/** Undo a failed prepare: digest and storage are released, the metadata stays. */
+void fw_core_cancel(fw_core_t *core);
+
+/** Metadata check, erase and begin_receiving in one step. */
+bool fw_core_prepare(fw_core_t *core);
+
+/** Whether a chunk of len bytes at offset may be taken now. */
+bool fw_core_check_chunk(const fw_core_t *core, uint32_t offset, uint32_t len);
+
+/** Fold data into the CRC16 or the announced digest. */
+void fw_core_absorb(fw_core_t *core, const uint8_t *data, size_t len);
+
+/** Program one block at offset and absorb it. */
+bool fw_core_write_block(fw_core_t *core, const uint8_t *data, size_t len, uint32_t offset);
+
+/**
+ * Switch the session to out-of-order storage: the running CRC/digest is dropped and the
+ * image will be checked by readback instead.
+ */
+void fw_core_mark_unordered(fw_core_t *core);
+
+/** check_chunk and write_block, then account the bytes as received. */
+bool fw_core_receive_chunk(fw_core_t *core, const uint8_t *data, uint32_t len, uint32_t offset);
+
+/** Stage and size checks before finalize. */
+bool fw_core_check_complete(const fw_core_t *core);
+
+/**
+ * Compare crc (the master's finalize value) and the digest, then close storage. For an
+ * unordered session only crc against the metadata is checked; verify_readback has to follow.
+ */
+bool fw_core_finish(fw_core_t *core, uint16_t crc);
+
+/** check_complete, VERIFYING, finish. */
+bool fw_core_finalize(fw_core_t *core, uint16_t crc);
+
+/**
+ * Read size bytes back through the backend and check them against the digest, or the
+ * expected CRC16 when type is FW_DIGEST_NONE. Uses core->digest, so only after finish.
+ */
+bool fw_core_verify_readback(fw_core_t *core, uint32_t size, fw_digest_type_t type,
+                             const uint8_t expected[FW_DIGEST_MAX_LEN]);
+
+/** Point the next boot at the closed image (when storage was used) and move to READY_TO_BOOT. */
+bool fw_core_activate(fw_core_t *core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FW_UPDATE_CORE_H */
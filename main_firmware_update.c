@@ -15,6 +15,8 @@
 #include "CANopen.h"
 #include "OD.h"
 #include "CO_storageBlank.h"
+#include "fw_storage.h"
+#include "fw_update_core.h"
 
 #define log_printf(fmt, ...) printf("[FW-DEMO] " fmt, ##__VA_ARGS__)
 #define log_error(fmt, ...)  printf("[FW-ERR ] " fmt, ##__VA_ARGS__)
@@ -46,138 +48,168 @@
 #define FW_MAX_IMAGE_SIZE_BYTES (1024U * 512U)
 #define FW_CHUNK_SIZE_BYTES     64U
 
-typedef enum {
-    FW_STAGE_IDLE = 0,
-    FW_STAGE_METADATA_READY,
-    FW_STAGE_ERASING_FLASH,
-    FW_STAGE_RECEIVING_BLOCKS,
-    FW_STAGE_VERIFYING,
-    FW_STAGE_READY_TO_BOOT
-} fw_stage_t;
-
+/*
+ * Streaming stand-in for the flash bank: it tracks the session but keeps no image, so images
+ * up to FW_MAX_IMAGE_SIZE_BYTES need no RAM. Program your flash driver in fw_bank_write; the
+ * CRC16 (or digest) over the received stream is the check, since there is nothing to read back.
+ */
 typedef struct {
-    fw_stage_t stage;
-    uint32_t expectedSize;
-    uint32_t receivedBytes;
-    uint16_t expectedCrc;
-    uint16_t runningCrc;
-    uint8_t currentBank;
-    bool metadataReceived;
-    bool flashPrepared;
-    bool crcMatched;
-} fw_update_context_t;
+    uint32_t imageBytes;
+    uint32_t written;
+    uint8_t bank;
+    uint8_t bootBank;
+    bool open;
+    bool closed;
+} fw_bank_t;
 
 static CO_t* CO = NULL;
-static fw_update_context_t fwCtx;
+static fw_core_t fwCore;
+static fw_bank_t fwBank;
 static uint8_t LED_red, LED_green;
 
-/* Reset the firmware state machine before a new download attempt. */
+static bool
+fw_bank_begin(void* ctx, uint8_t bank, uint32_t imageBytes) {
+    fw_bank_t* b = (fw_bank_t*)ctx;
+    if (b->open) {
+        return false;
+    }
+    b->imageBytes = imageBytes;
+    b->written = 0U;
+    b->bank = bank;
+    b->open = true;
+    b->closed = false;
+    return true;
+}
+
+static bool
+fw_bank_write(void* ctx, uint32_t offset, const uint8_t* data, size_t len) {
+    fw_bank_t* b = (fw_bank_t*)ctx;
+    (void)data;
+    if (!b->open || offset > b->imageBytes || len > b->imageBytes - offset) {
+        return false;
+    }
+    if (offset + len > b->written) {
+        b->written = offset + (uint32_t)len;
+    }
+    return true;
+}
+
+static bool
+fw_bank_end(void* ctx) {
+    fw_bank_t* b = (fw_bank_t*)ctx;
+    if (!b->open) {
+        return false;
+    }
+    b->open = false;
+    b->closed = true;
+    return true;
+}
+
 static void
-fw_reset_context(fw_update_context_t* ctx) {
-    memset(ctx, 0, sizeof(*ctx));
-    ctx->stage = FW_STAGE_IDLE;
-    ctx->currentBank = 0U;
+fw_bank_abort(void* ctx) {
+    fw_bank_t* b = (fw_bank_t*)ctx;
+    b->open = false;
+    b->closed = false;
 }
 
-/* Run one step of the CRC-16 calculation for inbound data bytes. */
-static uint16_t
-fw_crc16_step(uint16_t seed, uint8_t data) {
-    seed ^= (uint16_t)data << 8;
-    for (int i = 0; i < 8; i++) {
-        if (seed & 0x8000U) {
-            seed = (uint16_t)((seed << 1) ^ 0x1021U);
-        } else {
-            seed <<= 1;
-        }
+static bool
+fw_bank_set_boot(void* ctx) {
+    fw_bank_t* b = (fw_bank_t*)ctx;
+    if (!b->closed) {
+        return false;
     }
-    return seed;
+    b->bootBank = b->bank;
+    return true;
+}
+
+static bool
+fw_bank_read(void* ctx, uint32_t offset, uint8_t* buf, size_t len) {
+    (void)ctx;
+    (void)offset;
+    (void)buf;
+    (void)len;
+    return false;
+}
+
+static const fw_storage_ops_t fwBankOps = {
+    .name = "stream",
+    .begin = fw_bank_begin,
+    .write = fw_bank_write,
+    .end = fw_bank_end,
+    .abort = fw_bank_abort,
+    .set_boot = fw_bank_set_boot,
+    .read = fw_bank_read,
+};
+
+/* Reset the firmware state machine before a new download attempt. */
+static void
+fw_reset_context(fw_core_t* core) {
+    const fw_storage_t storage = {.ops = &fwBankOps, .ctx = &fwBank};
+    memset(&fwBank, 0, sizeof(fwBank));
+    fw_core_init(core, &storage, FW_MAX_IMAGE_SIZE_BYTES);
 }
 
-/* Simulate flash erase and mark the state machine as ready for chunk reception. */
+/* Erase the simulated bank and mark the state machine as ready for chunk reception. */
 static bool
-fw_prepare_storage(fw_update_context_t* ctx) {
-    log_printf("Preparing flash bank %u for new image...\n", ctx->currentBank);
-    RETURN_IF_FALSE(ctx->stage == FW_STAGE_METADATA_READY, "Cannot erase flash before metadata step");
-
-    ctx->flashPrepared = true;
-    ctx->stage = FW_STAGE_ERASING_FLASH;
-    log_printf("Flash bank %u erased successfully (simulated).\n", ctx->currentBank);
-    ctx->stage = FW_STAGE_RECEIVING_BLOCKS;
+fw_prepare_storage(fw_core_t* core) {
+    log_printf("Preparing flash bank %u for new image...\n", core->currentBank);
+    RETURN_IF_FALSE(core->stage == FW_STAGE_METADATA_READY, "Cannot erase flash before metadata step");
+    RETURN_IF_FALSE(fw_core_prepare(core), "Flash bank %u could not be erased", core->currentBank);
+
+    log_printf("Flash bank %u erased successfully (simulated).\n", core->currentBank);
     return true;
 }
 
 /* Validate and store incoming metadata record issued by the master. */
 static bool
-fw_store_metadata(fw_update_context_t* ctx, uint32_t size, uint16_t crc, uint8_t bank) {
+fw_store_metadata(fw_core_t* core, uint32_t size, uint16_t crc, uint8_t bank) {
     log_printf("Received metadata: size=%lu crc=0x%04X bank=%u\n", (unsigned long)size, crc, bank);
 
-    RETURN_IF_FALSE(size > 0U, "Metadata rejected: size is zero");
-    RETURN_IF_FALSE(size <= FW_MAX_IMAGE_SIZE_BYTES, "Metadata rejected: size %lu exceeds limit", (unsigned long)size);
-    RETURN_IF_FALSE(crc != 0x0000U, "Metadata rejected: CRC cannot be zero");
-
-    ctx->expectedSize = size;
-    ctx->expectedCrc = crc;
-    ctx->currentBank = bank;
-    ctx->stage = FW_STAGE_METADATA_READY;
-    ctx->metadataReceived = true;
-    ctx->runningCrc = 0xFFFFU;
-    log_printf("Metadata accepted; expecting %lu bytes.\n", (unsigned long)ctx->expectedSize);
+    const fw_metadata_record_t meta = {.imageBytes = size, .crc = crc, .imageType = 0U, .bank = bank};
+    RETURN_IF_FALSE(fw_core_store_metadata(core, &meta), "Metadata rejected");
+
+    log_printf("Metadata accepted; expecting %lu bytes.\n", (unsigned long)core->expectedSize);
     return true;
 }
 
 /* Accept one data chunk from the master while maintaining running CRC and offsets. */
 static bool
-fw_receive_chunk(fw_update_context_t* ctx, const uint8_t* data, uint32_t len, uint32_t offset) {
-    RETURN_IF_FALSE(ctx->stage == FW_STAGE_RECEIVING_BLOCKS, "Chunk rejected: wrong stage %d", ctx->stage);
-    RETURN_IF_FALSE(ctx->flashPrepared, "Chunk rejected: flash not prepared");
+fw_receive_chunk(fw_core_t* core, const uint8_t* data, uint32_t len, uint32_t offset) {
     RETURN_IF_FALSE(data != NULL, "Chunk rejected: NULL pointer");
     RETURN_IF_FALSE(len > 0U, "Chunk rejected: length zero");
-    RETURN_IF_FALSE(offset == ctx->receivedBytes, "Chunk rejected: expected offset %lu got %lu",
-                    (unsigned long)ctx->receivedBytes, (unsigned long)offset);
-
-    ctx->receivedBytes += len;
-
-    for (uint32_t i = 0; i < len; i++) {
-        ctx->runningCrc = fw_crc16_step(ctx->runningCrc, data[i]);
-    }
+    RETURN_IF_FALSE(fw_core_receive_chunk(core, data, len, offset), "Chunk @%lu rejected", (unsigned long)offset);
 
     log_printf("Chunk @%lu (%u bytes) accepted; total=%lu/%lu\n", (unsigned long)offset, (unsigned)len,
-               (unsigned long)ctx->receivedBytes, (unsigned long)ctx->expectedSize);
-
-    RETURN_IF_FALSE(ctx->receivedBytes <= ctx->expectedSize, "Overflow: received %lu > expected %lu",
-                    (unsigned long)ctx->receivedBytes, (unsigned long)ctx->expectedSize);
+               (unsigned long)core->receivedBytes, (unsigned long)core->expectedSize);
     return true;
 }
 
-/* Verify total size and CRC, then mark the image as ready to boot. */
+/*
+ * Verify total size and CRC, then mark the image as ready to boot. A backend that can read
+ * the bank back should also run fw_core_verify_readback() before activating.
+ */
 static bool
-fw_finalize(fw_update_context_t* ctx) {
-    RETURN_IF_FALSE(ctx->receivedBytes == ctx->expectedSize, "Finalize refused: size mismatch");
-    ctx->stage = FW_STAGE_VERIFYING;
-
-    ctx->crcMatched = (ctx->runningCrc == ctx->expectedCrc);
-    if (!ctx->crcMatched) {
-        log_error("CRC mismatch: computed 0x%04X expected 0x%04X\n", ctx->runningCrc, ctx->expectedCrc);
-        return false;
-    }
+fw_finalize(fw_core_t* core) {
+    RETURN_IF_FALSE(fw_core_finalize(core, core->expectedCrc), "Finalize refused");
+    RETURN_IF_FALSE(fw_core_activate(core), "Bank %u could not be activated", core->currentBank);
 
-    ctx->stage = FW_STAGE_READY_TO_BOOT;
-    log_printf("CRC validated (0x%04X). Image ready in bank %u\n", ctx->runningCrc, ctx->currentBank);
+    log_printf("CRC validated (0x%04X). Image ready in bank %u\n", core->runningCrc, fwBank.bootBank);
     return true;
 }
 
 /* Print every key field so the operator can inspect current progress. */
 static void
-fw_dump_context(const fw_update_context_t* ctx) {
+fw_dump_context(const fw_core_t* core) {
     log_printf("--- Firmware context snapshot ---\n");
-    log_printf(" stage          : %d\n", ctx->stage);
-    log_printf(" metadata ready : %s\n", ctx->metadataReceived ? "yes" : "no");
-    log_printf(" flash prepared : %s\n", ctx->flashPrepared ? "yes" : "no");
-    log_printf(" expected size  : %lu bytes\n", (unsigned long)ctx->expectedSize);
-    log_printf(" received bytes : %lu bytes\n", (unsigned long)ctx->receivedBytes);
-    log_printf(" expected crc   : 0x%04X\n", ctx->expectedCrc);
-    log_printf(" running crc    : 0x%04X\n", ctx->runningCrc);
-    log_printf(" crc matched    : %s\n", ctx->crcMatched ? "yes" : "no");
+    log_printf(" stage          : %d\n", core->stage);
+    log_printf(" metadata ready : %s\n", core->metadataReceived ? "yes" : "no");
+    log_printf(" flash prepared : %s\n", core->flashPrepared ? "yes" : "no");
+    log_printf(" expected size  : %lu bytes\n", (unsigned long)core->expectedSize);
+    log_printf(" received bytes : %lu bytes\n", (unsigned long)core->receivedBytes);
+    log_printf(" expected crc   : 0x%04X\n", core->expectedCrc);
+    log_printf(" running crc    : 0x%04X\n", core->runningCrc);
+    log_printf(" crc matched    : %s\n", core->crcMatched ? "yes" : "no");
+    log_printf(" storage        : %s\n", core->storage.ops->name);
     log_printf("----------------------------------\n");
 }
 
@@ -185,20 +217,21 @@ fw_dump_context(const fw_update_context_t* ctx) {
 static void
 fw_demo_session(CO_t* co) {
     (void)co;
-    fw_reset_context(&fwCtx);
+    fw_reset_context(&fwCore);
 
     /* First, demonstrate that invalid metadata is rejected */
-    if (!fw_store_metadata(&fwCtx, 0U, 0x1234U, 0U)) {
+    if (!fw_store_metadata(&fwCore, 0U, 0x1234U, 0U)) {
         log_warn("As expected, metadata validation prevented the update. Retrying with sane values...\n");
     }
 
+    /* CRC16/CCITT of the 0x00..0xFF ramp written twice below. */
     const uint32_t imageSize = 512U;
-    const uint16_t expectedCrc = 0x9C21U;
-    if (!fw_store_metadata(&fwCtx, imageSize, expectedCrc, 1U)) {
+    const uint16_t expectedCrc = 0x56EEU;
+    if (!fw_store_metadata(&fwCore, imageSize, expectedCrc, 1U)) {
         log_error("Unable to register valid metadata; aborting demo.\n");
         return;
     }
-    if (!fw_prepare_storage(&fwCtx)) {
+    if (!fw_prepare_storage(&fwCore)) {
         log_error("Failed to prepare flash; aborting demo.\n");
         return;
     }
@@ -210,19 +243,19 @@ fw_demo_session(CO_t* co) {
         for (uint32_t i = 0; i < len; i++) {
             pattern[i] = (uint8_t)((chunk + i) & 0xFFU);
         }
-        if (!fw_receive_chunk(&fwCtx, pattern, len, chunk)) {
+        if (!fw_receive_chunk(&fwCore, pattern, len, chunk)) {
             log_error("Chunk processing failed at offset %lu\n", (unsigned long)chunk);
             return;
         }
     }
 
-    if (fw_finalize(&fwCtx)) {
+    if (fw_finalize(&fwCore)) {
         log_printf("Firmware image accepted; scheduling CANopen controlled reboot.\n");
     } else {
         log_error("Firmware demo failed during final verification.\n");
     }
 
-    fw_dump_context(&fwCtx);
+    fw_dump_context(&fwCore);
 }
 
 /* Entry point that wires the Controller Area Network Open stack and launches the demo session. */